@@ -159,22 +159,47 @@ public:
     }
 
     //! @brief repeat exchange from last call to assign()
-    template<class SVec, class... Arrays>
-    auto redoExchange(BufferDescription bufDesc,
-                      const LocalIndex* ordering,
-                      SVec& /*sendScratch*/,
-                      SVec& /*receiveScratch*/,
-                      Arrays... particleProperties) const
+    template<class... Arrays>
+    auto redoExchange(BufferDescription bufDesc, const LocalIndex* ordering, Arrays... particleProperties) const
     {
         exchangeParticles(1, recvLog_, exchanges_, myRank_, bufDesc, numAssigned(), ordering, particleProperties...);
     }
 
+    /*! @brief seed the global tree and the assignment with the converged state of a previous run
+     *
+     * @param[in] leaves          cornerstone leaves of a converged global tree
+     * @param[in] counts          global particle counts per leaf of @p leaves
+     * @param[in] rankBoundaries  SFC keys of the rank boundaries, used to limit boundary shifts on the next call to
+     *                            assign() only if the length is numRanks + 1
+     *
+     * The next call to assign() then updates the global tree only once instead of converging it from scratch.
+     */
+    void seed(gsl::span<const KeyType> leaves, gsl::span<const unsigned> counts, gsl::span<const KeyType> rankBoundaries)
+    {
+        tree_.update(leaves.data(), nNodes(leaves));
+        nodeCounts_.assign(counts.begin(), counts.end());
+
+        if (rankBoundaries.ssize() == numRanks_ + 1)
+        {
+            assignment_ = SfcAssignment<KeyType>(numRanks_);
+            for (int rank = 0; rank <= numRanks_; ++rank)
+            {
+                assignment_.set(rank, rankBoundaries[rank], 0);
+            }
+        }
+        firstCall_ = false;
+    }
+
     //! @brief read only visibility of the global octree leaves to the outside
     gsl::span<const KeyType> treeLeaves() const { return tree_.treeLeaves(); }
     //! @brief the octree, including the internal part
     const Octree<KeyType>& octree() const { return tree_; }
+    //! @brief maximum particle count per leaf of the global octree
+    unsigned bucketSize() const { return bucketSize_; }
     //! @brief read only visibility of the global octree leaf counts to the outside
     gsl::span<const unsigned> nodeCounts() const { return nodeCounts_; }
+    //! @brief the global octree leaf counts in host memory
+    gsl::span<const unsigned> nodeCountsHost() const { return nodeCounts_; }
     //! @brief the global coordinate bounding box
     const Box<T>& box() const { return box_; }
     //! @brief return the space filling curve rank assignment of the last call to @a assign()
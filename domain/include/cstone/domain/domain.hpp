@@ -52,6 +52,7 @@
 #include "cstone/sfc/sfc.hpp"
 #include "cstone/sfc/sfc_gpu.h"
 #include "cstone/util/reallocate.hpp"
+#include "cstone/util/scratch_arena.hpp"
 #include "cstone/util/type_list.hpp"
 
 namespace cstone
@@ -215,10 +216,11 @@ public:
                      0, std::tie(h), util::reverse(scratch));
 
         float invThetaEff      = invThetaMinMac(theta_);
-        std::vector<int> peers = findPeersMac(myRank_, global_.assignment(), global_.octree(), box(), invThetaEff);
+        std::vector<int> peers = peerFinder_.find(myRank_, global_.assignment(), global_.octree(), box(), invThetaEff);
 
         if (firstCall_)
         {
+            if (warmStart_) { seedFocusTree(); }
             focusTree_.converge(box(), keyView, peers, global_.assignment(), global_.treeLeaves(), global_.nodeCounts(),
                                 invThetaEff, std::get<0>(scratch));
         }
@@ -239,6 +241,8 @@ public:
         updateLayout(sorter, exchangeStart, keyView, particleKeys, std::tie(h),
                      std::tuple_cat(std::tie(x, y, z), particleProperties), scratch);
         setupHalos(particleKeys, x, y, z, h, scratch);
+        updateTraversalNodes();
+        trimScratchArenas();
         firstCall_ = false;
     }
 
@@ -264,10 +268,11 @@ public:
                      0, std::tie(x, y, z, h, m), util::reverse(scratch));
 
         float invThetaEff      = invThetaVecMac(theta_);
-        std::vector<int> peers = findPeersMac(myRank_, global_.assignment(), global_.octree(), box(), invThetaEff);
+        std::vector<int> peers = peerFinder_.find(myRank_, global_.assignment(), global_.octree(), box(), invThetaEff);
 
         if (firstCall_)
         {
+            if (warmStart_) { seedFocusTree(); }
             // first rough convergence to avoid computing expansion centers of large nodes with a lot of particles
             focusTree_.converge(box(), keyView, peers, global_.assignment(), global_.treeLeaves(), global_.nodeCounts(),
                                 1.0, std::get<0>(scratch));
@@ -321,21 +326,66 @@ public:
         updateLayout(sorter, exchangeStart, keyView, particleKeys, std::tie(x, y, z, h, m), particleProperties,
                      scratch);
         setupHalos(particleKeys, x, y, z, h, scratch);
+        updateTraversalNodes();
+        trimScratchArenas();
         firstCall_ = false;
     }
 
+    /*! @brief seed the domain with the global tree and rank assignment of a previous run, e.g. from a checkpoint
+     *
+     * @param[in] treeLeaves      cornerstone leaves of a converged global tree, see globalTree()
+     * @param[in] nodeCounts      global particle counts per leaf of @p treeLeaves, see globalCounts()
+     * @param[in] rankBoundaries  SFC keys of the rank boundaries, see assignment()
+     *
+     * Must be called before the first sync. The first sync then validates the seeded global tree with a single count
+     * update instead of converging it from the root and the focused octree starts from the global tree leaves inside
+     * the assigned SFC range. If the number of ranks differs from the length of @p rankBoundaries minus one, the SFC
+     * is split among the current ranks based on @p nodeCounts.
+     */
+    void warmStart(gsl::span<const KeyType> treeLeaves,
+                   gsl::span<const unsigned> nodeCounts,
+                   gsl::span<const KeyType> rankBoundaries)
+    {
+        if (!firstCall_) { throw std::runtime_error("Domain can only be warm-started before the first sync\n"); }
+        if (treeLeaves.size() < 2 || nNodes(treeLeaves) != TreeNodeIndex(nodeCounts.size()) ||
+            treeLeaves.front() != 0 || treeLeaves.back() != nodeRange<KeyType>(0))
+        {
+            throw std::runtime_error("Invalid global tree for Domain warm start\n");
+        }
+        global_.seed(treeLeaves, nodeCounts, rankBoundaries);
+        warmStart_ = true;
+    }
+
+    /*! @brief seed the focused octree with the leaves of a previous run on the same rank, e.g. from a workload trace
+     *
+     * @param[in] focusLeaves  cornerstone leaves of the focus tree, see focusTree().treeLeaves()
+     *
+     * Must be called after warmStart() with the rank boundaries of the same run. The first sync then starts the focus
+     * tree from @p focusLeaves instead of the global leaves in the assigned SFC range.
+     */
+    void warmStartFocus(gsl::span<const KeyType> focusLeaves)
+    {
+        if (!warmStart_ || !firstCall_)
+        {
+            throw std::runtime_error("The focus tree can only be warm-started after warmStart and before the first "
+                                     "sync\n");
+        }
+        if (focusLeaves.size() < 2 || focusLeaves.front() != 0 || focusLeaves.back() != nodeRange<KeyType>(0))
+        {
+            throw std::runtime_error("Invalid focus tree for Domain warm start\n");
+        }
+        warmFocusLeaves_.assign(focusLeaves.begin(), focusLeaves.end());
+    }
+
     /*! @brief reapply exchange synchronization pattern from previous call to sync(Grav)() to additional particle fields
      *
      * @param[inout] arrays          the arrays to reapply sync to, length prevBufDesc_.size
-     * @param[-]     sendBuffer
-     * @param[-]     receiveBuffer
      * @param[in]    ordering        the post-particle-exchange SFC ordering
+     *
+     * Temporary storage for the exchange and the reordering is taken from the scratch arena.
      */
-    template<class... Vectors, class SendBuffer, class ReceiveBuffer, class OVec>
-    void reapplySync(std::tuple<Vectors&...> arrays,
-                     SendBuffer& sendBuffer,
-                     ReceiveBuffer& receiveBuffer,
-                     OVec& ordering) const
+    template<class... Vectors, class OVec>
+    void reapplySync(std::tuple<Vectors&...> arrays, OVec& ordering) const
     {
         static_assert((... && !IsDeviceVector<Vectors>{}), "reapplySync only support for arrays on CPUs");
         std::apply([this](auto&... arrays) { this->template checkSizesEqual(this->prevBufDesc_.size, arrays...); },
@@ -350,7 +400,8 @@ public:
         LocalIndex shift = prevBufDesc_.start - envelope[0];
 
         // the intermediate, reconstructed ordering needed for the MPI particle exchange
-        std::vector<LocalIndex> prevOrd(prevBufDesc_.end - prevBufDesc_.start);
+        auto scratchFrame = scratchArena().frame();
+        auto prevOrd      = scratchArena().allocate<LocalIndex>(prevBufDesc_.end - prevBufDesc_.start);
         // the post-exchange ordering that was obtained by sorting after receiving the particles from domain exchange
         std::vector<LocalIndex> orderingCpu;
 
@@ -368,13 +419,18 @@ public:
                        prevOrd.data() + global_.numSendDown() + global_.numPresent(),
                        [shift](auto i) { return i - shift; });
 
-        std::apply([exDesc, o = prevOrd.data(), &sendBuffer, &receiveBuffer, this](auto&... a)
-                   { global_.redoExchange(exDesc, o, sendBuffer, receiveBuffer, rawPtr(a)...); },
+        std::apply([exDesc, o = prevOrd.data(), this](auto&... a) { global_.redoExchange(exDesc, o, rawPtr(a)...); },
                    arrays);
 
-        lowMemReallocate(bufDesc_.size, allocGrowthRate_, arrays, std::tie(sendBuffer, receiveBuffer));
-        gatherArrays(gatherCpu, ord + global_.numSendDown(), global_.numAssigned(), envelope[0], bufDesc_.start, arrays,
-                     std::tie(sendBuffer, receiveBuffer));
+        lowMemReallocate(bufDesc_.size, allocGrowthRate_, arrays, {});
+        auto reorder = [this, o = ord + global_.numSendDown(), inputOffset = envelope[0]](auto& array)
+        {
+            auto gatherFrame = scratchArena().frame();
+            auto swapSpace   = scratchArena().allocate<std::decay_t<decltype(*rawPtr(array))>>(global_.numAssigned());
+            gatherCpu(o, global_.numAssigned(), rawPtr(array) + inputOffset, swapSpace.data());
+            omp_copy(swapSpace.begin(), swapSpace.end(), rawPtr(array) + bufDesc_.start);
+        };
+        std::apply([&reorder](auto&... a) { (reorder(a), ...); }, arrays);
     }
 
     //! @brief repeat the halo exchange pattern from the previous sync operation for a different set of arrays
@@ -385,6 +441,20 @@ public:
         this->halos_.exchangeHalos(arrays, sendBuffer, receiveBuffer);
     }
 
+    /*! @brief start a halo exchange for @p arrays, to be completed with wait() on the returned handle
+     *
+     * Allows overlapping the exchange with work that does not access @p arrays. Whether messages progress in the
+     * meantime depends on the MPI implementation, see MpiProgressThread. The domain must not be synced before
+     * the exchange is completed, see PendingHaloExchange for the remaining requirements.
+     */
+    template<class... Vectors, class SendBuffer, class ReceiveBuffer>
+    PendingHaloExchange
+    startHaloExchange(std::tuple<Vectors&...> arrays, SendBuffer& sendBuffer, ReceiveBuffer& receiveBuffer) const
+    {
+        std::apply([this](auto&... arrays) { this->template checkSizesEqual(this->bufDesc_.size, arrays...); }, arrays);
+        return this->halos_.startHaloExchange(arrays, sendBuffer, receiveBuffer);
+    }
+
     //! @brief return the index of the first particle that's part of the local assignment
     [[nodiscard]] LocalIndex startIndex() const { return bufDesc_.start; }
     //! @brief return one past the index of the last particle that's part of the local assignment
@@ -399,6 +469,15 @@ public:
     const Octree<KeyType>& globalTree() const { return global_.octree(); }
     //! @brief read only visibility of the focused octree
     const FocusedOctree<KeyType, T, Accelerator>& focusTree() const { return focusTree_; }
+    //! @brief global particle counts per leaf of globalTree(), in host memory
+    gsl::span<const unsigned> globalCounts() const { return global_.nodeCountsHost(); }
+    //! @brief number of ranks that the SFC is split into
+    [[nodiscard]] int numRanks() const { return numRanks_; }
+    //! @brief SFC keys of the rank boundaries, length numRanks + 1 after the first sync
+    gsl::span<const KeyType> assignment() const
+    {
+        return {global_.assignment().data(), size_t(global_.assignment().numRanks() + 1)};
+    }
     //! @brief the index of the first locally assigned cell in focusTree()
     TreeNodeIndex startCell() const { return focusTree_.assignment()[myRank_].start(); }
     //! @brief the index of the last locally assigned cell in focusTree()
@@ -412,6 +491,68 @@ public:
     void setHaloFactor(float factor) { haloSearchExt_ = factor; }
     void setGrowthAllocRate(float factor) { allocGrowthRate_ = factor; }
 
+    //! @brief MAC parameter for focus resolution and gravity, changes take effect in the next sync(Grav)
+    void setTheta(float theta) { theta_ = theta; }
+    float theta() const { return theta_; }
+
+    /*! @brief maximum particle count per focus tree leaf, changes take effect in the next sync(Grav)
+     *
+     * Must not exceed the bucket size of the global tree. The focus tree adapts to a new value gradually by one
+     * level of splits or merges per sync.
+     */
+    void setBucketSizeFocus(unsigned bucketSizeFocus)
+    {
+        bucketSizeFocus_ = bucketSizeFocus;
+        focusTree_.setBucketSize(bucketSizeFocus);
+    }
+    unsigned bucketSizeFocus() const { return bucketSizeFocus_; }
+    //! @brief maximum particle count per leaf of the global tree
+    unsigned bucketSize() const { return global_.bucketSize(); }
+
+    /*! @brief allow focus tree leaf particle counts to deviate from the bucket size by up to @p ratio to equalize cost
+     *
+     * Default is 1, which refines purely on particle counts. Costs are provided with setParticleCosts.
+     */
+    void setMaxLeafCostRatio(float ratio) { maxLeafCostRatio_ = ratio; }
+
+    /*! @brief provide per-particle costs of the last step to balance the cost per leaf in the next focus tree update
+     *
+     * @param[in] particleCosts  cost estimate per particle, e.g. the neighbor count, indexed like the particle buffers,
+     *                           only elements in [startIndex():endIndex()] are accessed
+     *
+     * Has no effect unless enabled with setMaxLeafCostRatio and on GPUs. Must be called after sync/syncGrav, on all
+     * ranks, since costs are normalized by the global mean cost per particle.
+     */
+    template<class Tc>
+    void setParticleCosts(const Tc* particleCosts)
+    {
+        if constexpr (!HaveGpu<Accelerator>{})
+        {
+            if (maxLeafCostRatio_ <= 1.0f) { return; }
+
+            std::vector<float> leafCosts(focusTree_.leafCounts().size(), 0);
+            auto myRange = focusTree_.assignment()[myRank_];
+#pragma omp parallel for schedule(static)
+            for (TreeNodeIndex i = myRange.start(); i < myRange.end(); ++i)
+            {
+                double cost = 0;
+                for (LocalIndex j = layout_[i]; j < layout_[i + 1]; ++j)
+                {
+                    cost += particleCosts[j];
+                }
+                leafCosts[i] = cost;
+            }
+            focusTree_.setLeafCosts(leafCosts, maxLeafCostRatio_);
+        }
+    }
+
+    //! @brief toggle the depth-first focus tree copy for CPU neighbor searches, default on, effective from next sync
+    void setDepthFirstTraversal(bool enable)
+    {
+        useDepthFirstNodes_ = enable;
+        if (!enable) { dfNodes_.clear(); }
+    }
+
     //! @brief update expansion (c.o.m) centers of the focus tree
     template<class VectorX, class VectorM, class VectorS1, class VectorS2>
     void updateExpansionCenters(VectorX& x, VectorX& y, VectorX& z, VectorM& m, VectorS1& s1, VectorS2& s2)
@@ -433,10 +574,51 @@ public:
                 focusTree_.treeLeavesAcc().data(),
                 rawPtr(layoutAcc_),
                 focusTree_.geoCentersAcc().data(),
-                focusTree_.geoSizesAcc().data()};
+                focusTree_.geoSizesAcc().data(),
+                1.0f,
+                dfNodes_.empty() ? nullptr : dfNodes_.data()};
     }
 
 private:
+    /*! @brief start the focus tree from the leaves passed to warmStartFocus() if any, otherwise from the global leaves
+     *         in the assigned SFC range and a minimal tree outside
+     */
+    void seedFocusTree()
+    {
+        if (!warmFocusLeaves_.empty())
+        {
+            focusTree_.seedLeaves(warmFocusLeaves_, box());
+            warmFocusLeaves_ = std::vector<KeyType>{};
+            return;
+        }
+
+        auto    globalLeaves = global_.octree().treeLeaves();
+        KeyType focusStart   = global_.assignment()[myRank_];
+        KeyType focusEnd     = global_.assignment()[myRank_ + 1];
+
+        std::vector<KeyType> spanningKeys{0};
+        std::copy(std::lower_bound(globalLeaves.begin(), globalLeaves.end(), focusStart),
+                  std::upper_bound(globalLeaves.begin(), globalLeaves.end(), focusEnd),
+                  std::back_inserter(spanningKeys));
+        spanningKeys.push_back(nodeRange<KeyType>(0));
+        spanningKeys.erase(std::unique(spanningKeys.begin(), spanningKeys.end()), spanningKeys.end());
+
+        focusTree_.seedLeaves(computeSpanningTree<KeyType>(spanningKeys), box());
+    }
+
+    //! @brief refresh the depth-first copy of the focus tree used for neighbor searches on the CPU
+    void updateTraversalNodes()
+    {
+        if constexpr (!HaveGpu<Accelerator>{})
+        {
+            if (!useDepthFirstNodes_) { return; }
+
+            auto ft = focusTree_.octreeViewAcc();
+            buildDepthFirstNodes(ft.childOffsets, ft.internalToLeaf, focusTree_.geoCentersAcc().data(),
+                                 focusTree_.geoSizesAcc().data(), ft.numNodes, dfNodes_);
+        }
+    }
+
     //! @brief bounds initialization on first call, use all particles
     void initBounds(std::size_t bufferSize)
     {
@@ -691,9 +873,22 @@ private:
         typename AccelSwitchType<Accelerator, GlobalAssignment, GlobalAssignmentGpu>::template type<KeyType, T>;
     Distributor_t global_;
 
+    //! @brief peer rank discovery on the global tree, reuses results from previous syncs
+    PeerFinder<KeyType, T> peerFinder_;
+
+    //! @brief compact depth-first copy of focusTree_ for CPU traversal, empty if disabled
+    std::vector<TraversalNode<T>> dfNodes_;
+    bool useDepthFirstNodes_{true};
+    //! @brief bound for cost-driven deviations of focus leaf particle counts from bucketSizeFocus_
+    float maxLeafCostRatio_{1.0f};
+
     Halos<KeyType, Accelerator> halos_{myRank_};
 
     bool firstCall_{true};
+    //! @brief whether the global tree was seeded with warmStart() before the first sync
+    bool warmStart_{false};
+    //! @brief focus tree leaves of a previous run passed to warmStartFocus(), released after the first sync
+    std::vector<KeyType> warmFocusLeaves_;
 
     std::vector<KeyType> swapKeys_;
 };
@@ -36,6 +36,7 @@
 
 #include "buffer_description.hpp"
 #include "cstone/primitives/mpi_wrappers.hpp"
+#include "cstone/util/scratch_arena.hpp"
 
 namespace cstone
 {
@@ -98,7 +99,8 @@ void exchangeParticles(int epoch,
     bool record               = receiveLog.empty();
     int domExTag              = static_cast<int>(P2pTags::domainExchange) + epoch;
 
-    std::vector<std::vector<char>> sendBuffers;
+    // send buffers are released when the frame goes out of scope, i.e. after MPI_Waitall
+    auto scratchFrame = scratchArena().frame();
     std::vector<MPI_Request> sendRequests;
 
     for (int destinationRank = 0; destinationRank < sends.numRanks(); ++destinationRank)
@@ -113,15 +115,14 @@ void exchangeParticles(int epoch,
             size_t numFit        = numElementsFit<alignment>(INT_MAX * sizeof(TransferType) - headerBytes, arrays...);
             size_t nextSendCount = std::min(numFit, numRemaining);
 
-            std::vector<char> sendBuffer(headerBytes +
-                                         util::computeByteOffsets(nextSendCount, alignment, arrays...).back());
+            auto sendBuffer = scratchArena().allocate<char>(
+                headerBytes + util::computeByteOffsets(nextSendCount, alignment, arrays...).back());
             encodeSendCountCpu(nextSendCount, sendBuffer.data());
             packArrays<alignment>(gatherCpu, ordering + sends[destinationRank] + numSent, nextSendCount,
                                   sendBuffer.data() + headerBytes, arrays + bufDesc.start...);
 
             mpiSendAsyncAs<TransferType>(sendBuffer.data(), sendBuffer.size(), destinationRank, domExTag, sendRequests);
             numSent += nextSendCount;
-            sendBuffers.push_back(std::move(sendBuffer));
         }
         assert(numSent == sendCount);
     }
@@ -130,16 +131,16 @@ void exchangeParticles(int epoch,
     LocalIndex receiveStart        = domain_exchange::receiveStart(bufDesc, numParticlesPresent, numParticlesAssigned);
     LocalIndex receiveEnd          = receiveStart + numParticlesAssigned - numParticlesPresent;
 
-    std::vector<char> receiveBuffer;
     while (receiveStart != receiveEnd)
     {
         MPI_Status status;
-        MPI_Probe(MPI_ANY_SOURCE, domExTag, MPI_COMM_WORLD, &status);
+        MPI_Probe(MPI_ANY_SOURCE, domExTag, domainComm(), &status);
         int receiveRank = status.MPI_SOURCE;
         int receiveCountTransfer;
         MPI_Get_count(&status, MpiType<TransferType>{}, &receiveCountTransfer);
 
-        receiveBuffer.resize(receiveCountTransfer * sizeof(TransferType));
+        auto receiveFrame  = scratchArena().frame();
+        auto receiveBuffer = scratchArena().allocate<char>(receiveCountTransfer * sizeof(TransferType));
         mpiRecvSyncAs<TransferType>(receiveBuffer.data(), receiveBuffer.size(), receiveRank, domExTag, &status);
 
         size_t receiveCount = decodeSendCountCpu(receiveBuffer.data());
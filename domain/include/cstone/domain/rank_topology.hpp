@@ -0,0 +1,119 @@
+/*
+ * Cornerstone octree
+ *
+ * Copyright (c) 2024 CSCS, ETH Zurich, University of Zurich, 2021 University of Basel
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: MIT License
+ */
+
+/*! @file
+ * @brief Rank order for mapping consecutive SFC segments to ranks that share a node or network group
+ *
+ * The SFC assignment gives consecutive key ranges to consecutive ranks, and most halo traffic is exchanged between
+ * SFC neighbors. Whether SFC neighbors share a node therefore depends on how the launcher placed the ranks. Reordering
+ * the ranks of the domain communicator by (network group, node, rank) keeps SFC neighbors on the same node, except
+ * for the ranks at node boundaries.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "cstone/primitives/mpi_wrappers.hpp"
+
+namespace cstone
+{
+
+/*! @brief compute the new rank of each rank for a topology-aware ordering
+ *
+ * @param groups   network group id of each rank
+ * @param nodeIds  node id of each rank, e.g. the lowest rank on the same node
+ * @return         new rank of each rank, sorted by (group, node id, old rank)
+ */
+inline std::vector<int> topologyRankOrder(const std::vector<int>& groups, const std::vector<int>& nodeIds)
+{
+    int numRanks = groups.size();
+    std::vector<int> byTopology(numRanks);
+    std::iota(byTopology.begin(), byTopology.end(), 0);
+    std::stable_sort(byTopology.begin(), byTopology.end(), [&groups, &nodeIds](int a, int b)
+                     { return std::tie(groups[a], nodeIds[a]) < std::tie(groups[b], nodeIds[b]); });
+
+    std::vector<int> newRank(numRanks);
+    for (int i = 0; i < numRanks; ++i)
+    {
+        newRank[byTopology[i]] = i;
+    }
+    return newRank;
+}
+
+/*! @brief look up the network group of @p hostname in a topology description
+ *
+ * @param topology  lines of the form "<hostname> <group id>", lines starting with # are ignored
+ * @return          the group of @p hostname or -1 if the host is not listed
+ */
+inline int lookupNetworkGroup(const std::string& topology, const std::string& hostname)
+{
+    std::istringstream lines(topology);
+    std::string line;
+    while (std::getline(lines, line))
+    {
+        if (line.empty() || line[0] == '#') { continue; }
+        std::istringstream fields(line);
+        std::string host;
+        int group;
+        if (fields >> host >> group && host == hostname) { return group; }
+    }
+    return -1;
+}
+
+/*! @brief create a communicator over the ranks of @p comm ordered by network group and node
+ *
+ * @param comm      input communicator, typically MPI_COMM_WORLD
+ * @param topology  optional content of a topology file, see lookupNetworkGroup, needs to be valid on rank 0 only
+ * @return          new communicator with the same processes, to be installed with domainComm() = ...
+ *
+ * Nodes are determined with MPI_Comm_split_type(MPI_COMM_TYPE_SHARED). Hosts missing from the topology are placed
+ * after all listed groups. Without a topology, only the node grouping is applied.
+ */
+inline MPI_Comm topologyOrderedComm(MPI_Comm comm, std::string topology = "")
+{
+    int rank, numRanks;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &numRanks);
+
+    MPI_Comm nodeComm;
+    MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &nodeComm);
+    int nodeId = rank;
+    MPI_Allreduce(MPI_IN_PLACE, &nodeId, 1, MPI_INT, MPI_MIN, nodeComm);
+    MPI_Comm_free(&nodeComm);
+
+    int topologySize = topology.size();
+    MPI_Bcast(&topologySize, 1, MPI_INT, 0, comm);
+    topology.resize(topologySize);
+    MPI_Bcast(topology.data(), topologySize, MPI_CHAR, 0, comm);
+
+    char hostname[MPI_MAX_PROCESSOR_NAME];
+    int nameLength;
+    MPI_Get_processor_name(hostname, &nameLength);
+    int group = lookupNetworkGroup(topology, std::string(hostname, nameLength));
+    if (group < 0) { group = std::numeric_limits<int>::max(); }
+
+    std::vector<int> groups(numRanks), nodeIds(numRanks);
+    MPI_Allgather(&group, 1, MPI_INT, groups.data(), 1, MPI_INT, comm);
+    MPI_Allgather(&nodeId, 1, MPI_INT, nodeIds.data(), 1, MPI_INT, comm);
+
+    int newRank = topologyRankOrder(groups, nodeIds)[rank];
+
+    MPI_Comm orderedComm;
+    MPI_Comm_split(comm, 0, newRank, &orderedComm);
+    return orderedComm;
+}
+
+} // namespace cstone
@@ -0,0 +1,161 @@
+/*
+ * Cornerstone octree
+ *
+ * Copyright (c) 2024 CSCS, ETH Zurich, University of Zurich, 2021 University of Basel
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: MIT License
+ */
+
+/*! @file
+ * @brief Predict the domain decomposition of many ranks within a single process
+ *
+ * All particles are present in the calling process. For each virtual rank, the steps of Domain::sync that determine
+ * the decomposition are replayed with the serial building blocks: the SFC assignment of the global tree, the peer
+ * ranks, a focus tree around the assigned SFC range with the peer boundaries enforced, and the halo cells of the
+ * focus tree. Since the particle counts of all cells are known locally, no messages are exchanged. The focus trees
+ * are built with the same bucket size and MAC as in Domain, but they are converged from scratch instead of being
+ * carried over from previous steps, so the resulting halo counts match a first sync of a distributed run.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "cstone/domain/domaindecomp.hpp"
+#include "cstone/focus/octree_focus.hpp"
+#include "cstone/traversal/collisions.hpp"
+#include "cstone/traversal/peers.hpp"
+#include "cstone/tree/csarray.hpp"
+
+namespace cstone
+{
+
+//! @brief decomposition metrics of a single virtual rank
+struct VirtualRankStats
+{
+    //! @brief particles in the assigned SFC range
+    LocalIndex numParticles{0};
+    //! @brief halo particles received from other ranks
+    LocalIndex numHalosRecv{0};
+    //! @brief particles sent to other ranks as their halos
+    LocalIndex numHalosSent{0};
+    //! @brief ranks that halos are received from or sent to
+    int numHaloPeers{0};
+    //! @brief ranks with cells that fail the MAC with respect to the assigned SFC range
+    int numFocusPeers{0};
+    //! @brief leaf cells of the focus tree
+    TreeNodeIndex numFocusLeaves{0};
+};
+
+/*! @brief compute the decomposition metrics of @p numRanks virtual ranks
+ *
+ * @param[in] numRanks         number of virtual ranks
+ * @param[in] particleKeys     sorted SFC keys of all particles
+ * @param[in] h                smoothing lengths of all particles, in the order of @p particleKeys
+ * @param[in] box              global coordinate bounding box
+ * @param[in] bucketSize       maximum particles per leaf cell of the global tree
+ * @param[in] bucketSizeFocus  maximum particles per leaf cell of the focus trees
+ * @param[in] theta            opening angle of the MAC that determines peers and the focus tree resolution
+ * @return                     metrics of each virtual rank
+ */
+template<class KeyType, class Th, class T>
+std::vector<VirtualRankStats> simulateVirtualRanks(int numRanks,
+                                                   gsl::span<const KeyType> particleKeys,
+                                                   const Th* h,
+                                                   const Box<T>& box,
+                                                   unsigned bucketSize,
+                                                   unsigned bucketSizeFocus,
+                                                   float theta)
+{
+    auto [globalLeaves, globalCounts] =
+        computeOctree(particleKeys.data(), particleKeys.data() + particleKeys.size(), bucketSize);
+    Octree<KeyType> globalTree;
+    globalTree.update(globalLeaves.data(), nNodes(globalLeaves));
+
+    auto assignment   = makeSfcAssignment(numRanks, globalCounts, globalLeaves.data());
+    float invThetaEff = invThetaMinMac(theta);
+
+    std::vector<VirtualRankStats> stats(numRanks);
+    //! @brief number of halo particles that each rank receives from each of its source ranks
+    std::vector<std::vector<std::pair<int, LocalIndex>>> haloSources(numRanks);
+
+#pragma omp parallel for schedule(dynamic)
+    for (int rank = 0; rank < numRanks; ++rank)
+    {
+        KeyType focusStart = assignment[rank];
+        KeyType focusEnd   = assignment[rank + 1];
+
+        std::vector<int> peers = findPeersMac(rank, assignment, globalTree, box, invThetaEff);
+        std::vector<KeyType> peerBoundaries;
+        for (int peer : peers)
+        {
+            peerBoundaries.push_back(assignment[peer]);
+            peerBoundaries.push_back(assignment[peer + 1]);
+        }
+
+        FocusedOctreeSingleNode<KeyType> focusTree(bucketSizeFocus, theta);
+        while (!focusTree.update(box, particleKeys, focusStart, focusEnd, peerBoundaries))
+            ;
+
+        auto leaves = focusTree.treeLeaves();
+        auto counts = focusTree.leafCounts();
+        auto octree = focusTree.octreeView();
+
+        TreeNodeIndex numLeaves = counts.size();
+        TreeNodeIndex firstNode = findNodeAbove(leaves.data(), leaves.size(), focusStart);
+        TreeNodeIndex lastNode  = findNodeAbove(leaves.data(), leaves.size(), focusEnd);
+
+        // the counts include all particles, such that the leaf offsets index into the global particle arrays
+        std::vector<LocalIndex> offsets(numLeaves + 1, 0);
+        std::inclusive_scan(counts.begin(), counts.end(), offsets.begin() + 1, std::plus<>{}, LocalIndex(0));
+
+        // SPH convention: interaction radius = 2 * h
+        std::vector<float> radii(numLeaves, 0.0f);
+        for (TreeNodeIndex i = firstNode; i < lastNode; ++i)
+        {
+            if (offsets[i + 1] > offsets[i]) { radii[i] = 2 * *std::max_element(h + offsets[i], h + offsets[i + 1]); }
+        }
+
+        std::vector<int> haloFlags(numLeaves, 0);
+        findHalos(octree.prefixes, octree.childOffsets, octree.internalToLeaf, leaves.data(), radii.data(), box,
+                  firstNode, lastNode, haloFlags.data());
+
+        auto& sources = haloSources[rank];
+        for (TreeNodeIndex i = 0; i < numLeaves; ++i)
+        {
+            if (!haloFlags[i] || (i >= firstNode && i < lastNode) || counts[i] == 0) { continue; }
+            int source = assignment.findRank(leaves[i]);
+            if (sources.empty() || sources.back().first != source) { sources.emplace_back(source, 0); }
+            sources.back().second += counts[i];
+        }
+
+        stats[rank].numParticles   = offsets[lastNode] - offsets[firstNode];
+        stats[rank].numFocusPeers  = peers.size();
+        stats[rank].numFocusLeaves = numLeaves;
+    }
+
+    std::vector<std::vector<int>> haloPeers(numRanks);
+    for (int rank = 0; rank < numRanks; ++rank)
+    {
+        for (auto [source, count] : haloSources[rank])
+        {
+            stats[rank].numHalosRecv += count;
+            stats[source].numHalosSent += count;
+            haloPeers[rank].push_back(source);
+            haloPeers[source].push_back(rank);
+        }
+    }
+    for (int rank = 0; rank < numRanks; ++rank)
+    {
+        std::sort(haloPeers[rank].begin(), haloPeers[rank].end());
+        stats[rank].numHaloPeers =
+            std::unique(haloPeers[rank].begin(), haloPeers[rank].end()) - haloPeers[rank].begin();
+    }
+
+    return stats;
+}
+
+} // namespace cstone
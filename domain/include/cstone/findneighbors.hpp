@@ -117,16 +117,9 @@ HOST_DEVICE_FUN unsigned findNeighbors(LocalIndex i,
     bool anyPbc = box.boundaryX() == pbc || box.boundaryY() == pbc || box.boundaryZ() == pbc;
     bool usePbc = anyPbc && !insideBox(particle, {Tc(2) * hi, Tc(2) * hi, Tc(2) * hi}, box);
 
-    auto overlapsPbc = [particle, cellRadiusSq, centers = tree.centers, sizes = tree.sizes, &box](TreeNodeIndex idx)
-    { return norm2(minDistance(particle, centers[idx], sizes[idx], box)) < cellRadiusSq; };
-
-    auto overlaps = [particle, cellRadiusSq, centers = tree.centers, sizes = tree.sizes](TreeNodeIndex idx)
-    { return norm2(minDistance(particle, centers[idx], sizes[idx])) < cellRadiusSq; };
-
-    auto searchBoxPbc =
-        [i, particle, radiusSq, &tree, x, y, z, ngmax, neighbors, &numNeighbors, &box](TreeNodeIndex idx)
+    auto searchLeafPbc = [i, particle, radiusSq, &tree, x, y, z, ngmax, neighbors, &numNeighbors, &box](
+                             TreeNodeIndex leafIdx)
     {
-        TreeNodeIndex leafIdx    = tree.internalToLeaf[idx];
         LocalIndex firstParticle = tree.layout[leafIdx];
         LocalIndex lastParticle  = tree.layout[leafIdx + 1];
 
@@ -141,9 +134,9 @@ HOST_DEVICE_FUN unsigned findNeighbors(LocalIndex i,
         }
     };
 
-    auto searchBox = [i, particle, radiusSq, &tree, x, y, z, ngmax, neighbors, &numNeighbors, &box](TreeNodeIndex idx)
+    auto searchLeaf = [i, particle, radiusSq, &tree, x, y, z, ngmax, neighbors, &numNeighbors, &box](
+                          TreeNodeIndex leafIdx)
     {
-        TreeNodeIndex leafIdx    = tree.internalToLeaf[idx];
         LocalIndex firstParticle = tree.layout[leafIdx];
         LocalIndex lastParticle  = tree.layout[leafIdx + 1];
 
@@ -158,6 +151,34 @@ HOST_DEVICE_FUN unsigned findNeighbors(LocalIndex i,
         }
     };
 
+    if (tree.dfNodes)
+    {
+        using Node = TraversalNode<Tc>;
+
+        auto overlapsPbc = [particle, cellRadiusSq, &box](const Node& node)
+        { return norm2(minDistance(particle, node.center, node.size, box)) < cellRadiusSq; };
+
+        auto overlaps = [particle, cellRadiusSq](const Node& node)
+        { return norm2(minDistance(particle, node.center, node.size)) < cellRadiusSq; };
+
+        if (usePbc)
+        {
+            singleTraversal(tree.dfNodes, overlapsPbc, [&searchLeafPbc](const Node& n) { searchLeafPbc(n.leafIdx); });
+        }
+        else { singleTraversal(tree.dfNodes, overlaps, [&searchLeaf](const Node& n) { searchLeaf(n.leafIdx); }); }
+
+        return numNeighbors;
+    }
+
+    auto overlapsPbc = [particle, cellRadiusSq, centers = tree.centers, sizes = tree.sizes, &box](TreeNodeIndex idx)
+    { return norm2(minDistance(particle, centers[idx], sizes[idx], box)) < cellRadiusSq; };
+
+    auto overlaps = [particle, cellRadiusSq, centers = tree.centers, sizes = tree.sizes](TreeNodeIndex idx)
+    { return norm2(minDistance(particle, centers[idx], sizes[idx])) < cellRadiusSq; };
+
+    auto searchBoxPbc = [&searchLeafPbc, &tree](TreeNodeIndex idx) { searchLeafPbc(tree.internalToLeaf[idx]); };
+    auto searchBox    = [&searchLeaf, &tree](TreeNodeIndex idx) { searchLeaf(tree.internalToLeaf[idx]); };
+
     if (usePbc) { singleTraversal(tree.childOffsets, overlapsPbc, searchBoxPbc); }
     else { singleTraversal(tree.childOffsets, overlaps, searchBox); }
 
@@ -28,6 +28,7 @@
 #pragma once
 
 #include <algorithm>
+#include <cstring>
 #include <vector>
 
 #include "cstone/domain/index_ranges.hpp"
@@ -35,11 +36,13 @@
 #include "cstone/primitives/mpi_wrappers.hpp"
 #include "cstone/primitives/mpi_cuda.cuh"
 #include "cstone/primitives/gather_acc.hpp"
+#include "cstone/primitives/peer_exchange.hpp"
 #include "cstone/tree/csarray.hpp"
 #include "cstone/tree/csarray_gpu.h"
 #include "cstone/tree/octree.hpp"
 #include "cstone/util/gsl-lite.hpp"
 #include "cstone/util/pack_buffers.hpp"
+#include "cstone/util/scratch_arena.hpp"
 
 namespace cstone
 {
@@ -67,32 +70,40 @@ void exchangeTreelets(gsl::span<const int> peerRanks,
     constexpr int keyTag = static_cast<int>(P2pTags::focusTreelets);
     size_t numPeers      = peerRanks.size();
 
-    std::vector<MPI_Request> sendRequests;
-    sendRequests.reserve(numPeers);
-    for (auto peer : peerRanks)
+    // +1 to include the upper key boundary for the last node
+    std::vector<int> sendCounts(numPeers);
+    for (size_t i = 0; i < numPeers; ++i)
     {
-        // +1 to include the upper key boundary for the last node
-        TreeNodeIndex sendCount = focusAssignment[peer].count() + 1;
-        mpiSendAsync(leaves.data() + focusAssignment[peer].start(), sendCount, peer, keyTag, sendRequests);
+        sendCounts[i] = focusAssignment[peerRanks[i]].count() + 1;
     }
+    auto recvCounts = exchangeMessageSizes(peerRanks, sendCounts, keyTag);
+
+    auto scratchFrame = scratchArena().frame();
+    auto recvOffsets  = messageOffsets(recvCounts);
+    auto recvKeys     = scratchArena().allocate<KeyType>(recvOffsets.back());
 
-    std::vector<MPI_Request> receiveRequests;
-    receiveRequests.reserve(numPeers);
-    int numMessages = numPeers;
-    while (numMessages--)
+    std::vector<MPI_Request> receiveRequests(numPeers);
+    for (size_t i = 0; i < numPeers; ++i)
     {
-        MPI_Status status;
-        MPI_Probe(MPI_ANY_SOURCE, keyTag, MPI_COMM_WORLD, &status);
-        int receiveRank = status.MPI_SOURCE;
-        TreeNodeIndex receiveSize;
-        MPI_Get_count(&status, MpiType<KeyType>{}, &receiveSize);
-        treelets[receiveRank].resize(receiveSize);
+        mpiRecvAsync(recvKeys.data() + recvOffsets[i], recvCounts[i], peerRanks[i], keyTag, &receiveRequests[i]);
+    }
 
-        mpiRecvAsync(treelets[receiveRank].data(), receiveSize, receiveRank, keyTag, receiveRequests);
+    std::vector<MPI_Request> sendRequests;
+    sendRequests.reserve(numPeers);
+    for (size_t i = 0; i < numPeers; ++i)
+    {
+        int peer = peerRanks[i];
+        mpiSendAsync(leaves.data() + focusAssignment[peer].start(), sendCounts[i], peer, keyTag, sendRequests);
     }
 
+    waitsomeUnpack(receiveRequests,
+                   [&](int i)
+                   {
+                       treelets[peerRanks[i]].assign(recvKeys.begin() + recvOffsets[i],
+                                                     recvKeys.begin() + recvOffsets[i + 1]);
+                   });
+
     MPI_Waitall(int(numPeers), sendRequests.data(), MPI_STATUS_IGNORE);
-    MPI_Waitall(int(numPeers), receiveRequests.data(), MPI_STATUS_IGNORE);
 }
 
 //! @brief flag treelet keys that don't exist in @p leaves as invalid
@@ -153,44 +164,53 @@ void exchangeRejectedKeys(gsl::span<const int> peerRanks,
     constexpr int keyTag = static_cast<int>(P2pTags::focusTreelets) + 1;
     size_t numPeers      = peerRanks.size();
 
-    std::vector<MPI_Request> sendRequests;
-    sendRequests.reserve(numPeers);
-
-    std::vector<std::vector<KeyType, util::DefaultInitAdaptor<KeyType>>> rejectedKeyBuffers;
-    for (auto peer : peerRanks)
+    std::vector<int> sendCounts(numPeers);
+    for (size_t i = 0; i < numPeers; ++i)
     {
-        auto& treelet          = treelets[peer];
-        TreeNodeIndex numNodes = nNodes(treelet);
+        const auto& treelet = treelets[peerRanks[i]];
+        sendCounts[i]       = std::count_if(treelet.begin(), treelet.begin() + nNodes(treelet), isMasked<KeyType>);
+    }
+    auto recvCounts = exchangeMessageSizes(peerRanks, sendCounts, keyTag);
 
-        std::vector<KeyType, util::DefaultInitAdaptor<KeyType>> rejectedKeys;
-        for (int i = 0; i < numNodes; ++i)
-        {
-            if (isMasked(treelet[i])) { rejectedKeys.push_back(unmaskKey(treelet[i])); }
-        }
-        mpiSendAsync(rejectedKeys.data(), rejectedKeys.size(), peer, keyTag, sendRequests);
-        rejectedKeyBuffers.push_back(std::move(rejectedKeys));
+    auto scratchFrame = scratchArena().frame();
+    auto recvOffsets  = messageOffsets(recvCounts);
+    auto recvKeys     = scratchArena().allocate<KeyType>(recvOffsets.back());
+
+    // in the common case of no rejected keys, no messages are sent
+    std::vector<MPI_Request> receiveRequests(numPeers, MPI_REQUEST_NULL);
+    for (size_t i = 0; i < numPeers; ++i)
+    {
+        if (recvCounts[i] == 0) { continue; }
+        mpiRecvAsync(recvKeys.data() + recvOffsets[i], recvCounts[i], peerRanks[i], keyTag, &receiveRequests[i]);
     }
 
-    int numMessages = numPeers;
-    while (numMessages--)
+    auto sendOffsets = messageOffsets(sendCounts);
+    auto sendKeys    = scratchArena().allocate<KeyType>(sendOffsets.back());
+    std::vector<MPI_Request> sendRequests;
+    for (size_t i = 0; i < numPeers; ++i)
     {
-        MPI_Status status;
-        MPI_Probe(MPI_ANY_SOURCE, keyTag, MPI_COMM_WORLD, &status);
-        int receiveRank = status.MPI_SOURCE;
-        TreeNodeIndex receiveSize;
-        MPI_Get_count(&status, MpiType<KeyType>{}, &receiveSize);
+        if (sendCounts[i] == 0) { continue; }
 
-        std::vector<KeyType, util::DefaultInitAdaptor<KeyType>> recvKeys(receiveSize);
-        recvKeys.resize(receiveSize);
-        mpiRecvSync(recvKeys.data(), receiveSize, receiveRank, keyTag, &status);
-        for (TreeNodeIndex i = 0; i < receiveSize; ++i)
+        const auto& treelet   = treelets[peerRanks[i]];
+        KeyType* rejectedKeys = sendKeys.data() + sendOffsets[i];
+        for (TreeNodeIndex j = 0, k = 0; j < TreeNodeIndex(nNodes(treelet)); ++j)
         {
-            TreeNodeIndex ki = findNodeAbove(leaves.data(), leaves.size(), recvKeys[i]);
-            nodeOps[ki]      = 0;
+            if (isMasked(treelet[j])) { rejectedKeys[k++] = unmaskKey(treelet[j]); }
         }
+        mpiSendAsync(rejectedKeys, sendCounts[i], peerRanks[i], keyTag, sendRequests);
     }
 
-    MPI_Waitall(int(numPeers), sendRequests.data(), MPI_STATUS_IGNORE);
+    waitsomeUnpack(receiveRequests,
+                   [&](int i)
+                   {
+                       for (size_t j = recvOffsets[i]; j < recvOffsets[i + 1]; ++j)
+                       {
+                           TreeNodeIndex ki = findNodeAbove(leaves.data(), leaves.size(), recvKeys[j]);
+                           nodeOps[ki]      = 0;
+                       }
+                   });
+
+    MPI_Waitall(int(sendRequests.size()), sendRequests.data(), MPI_STATUS_IGNORE);
 }
 
 template<class KeyType>
@@ -310,6 +330,25 @@ void exchangeTreeletGeneral(gsl::span<const int> peerRanks,
     gsl::span<gsl::span<T>> sendBuffers{packedBuffers.data(), peerRanks.size()};
     gsl::span<gsl::span<T>> recvBuffers{packedBuffers.data() + peerRanks.size(), peerRanks.size()};
 
+    // receive sizes are known, prepost all receives, staged through host memory if GPU-direct is not active
+    constexpr bool stageRecv = useGpu && !useGpuDirect;
+    std::vector<int> recvCounts(peerRanks.size());
+    for (int i = 0; i < peerRanks.size(); ++i)
+    {
+        recvCounts[i] = recvBuffers[i].size();
+    }
+    auto hostOffsets  = messageOffsets(recvCounts);
+    auto scratchFrame = scratchArena().frame();
+    auto hostRecv     = scratchArena().allocate<T>(stageRecv ? hostOffsets.back() : 0);
+
+    std::vector<MPI_Request> recvRequests;
+    recvRequests.reserve(peerRanks.size());
+    for (int i = 0; i < peerRanks.size(); ++i)
+    {
+        T* recvBuf = stageRecv ? hostRecv.data() + hostOffsets[i] : recvBuffers[i].data();
+        mpiRecvAsync(recvBuf, recvCounts[i], peerRanks[i], commTag, recvRequests);
+    }
+
     std::vector<std::vector<T, util::DefaultInitAdaptor<T>>> staging; // only used if GPU-direct is not active
     std::vector<MPI_Request> sendRequests;
     sendRequests.reserve(peerRanks.size());
@@ -321,26 +360,109 @@ void exchangeTreeletGeneral(gsl::span<const int> peerRanks,
                                 sendRequests, staging);
     }
 
-    int numMessages = peerRanks.size();
-    while (numMessages--)
+    waitsomeUnpack(recvRequests,
+                   [&](int i)
+                   {
+                       T* recvBuf = recvBuffers[i].data();
+                       if constexpr (stageRecv) { memcpyH2D(hostRecv.data() + hostOffsets[i], recvCounts[i], recvBuf); }
+                       auto mapToInternal =
+                           csToInternalMap.subspan(focusAssignment[peerRanks[i]].start(), recvCounts[i]);
+                       scatterAcc<useGpu>(mapToInternal, recvBuf, quantities.data());
+                   });
+    if constexpr (useGpu) { syncGpu(); }
+
+    MPI_Waitall(int(sendRequests.size()), sendRequests.data(), MPI_STATUS_IGNORE);
+    reallocate(scratch, origSize, 1.0);
+}
+
+/*! @brief like exchangeTreeletGeneral, but with a compact wire format, CPU only
+ *
+ * @tparam Codec  provides WireType, bool skip(const T&), WireType encode(const T&) and T decode(const WireType&)
+ *
+ * Each message consists of one bit per treelet node, followed by the encoded values of the nodes whose bit is set.
+ * Nodes for which codec.skip() returns true are not sent and set to T{} on the receiver side. Since the number of
+ * skipped nodes is not known to the receiver, receives are preposted with the size of a message without skipped nodes.
+ */
+template<class T, class Codec>
+void exchangeTreeletCompact(gsl::span<const int> peerRanks,
+                            gsl::span<const gsl::span<const TreeNodeIndex>> treeletIdx,
+                            gsl::span<const IndexPair<TreeNodeIndex>> focusAssignment,
+                            gsl::span<const TreeNodeIndex> csToInternalMap,
+                            gsl::span<T> quantities,
+                            int commTag,
+                            const Codec& codec)
+{
+    using WireType = typename Codec::WireType;
+    using MaskType = uint32_t;
+    constexpr int maskBits = 8 * sizeof(MaskType);
+
+    auto maskBytes = [](size_t numNodes) { return sizeof(MaskType) * iceil(numNodes, maskBits); };
+    auto maxBytes  = [maskBytes](size_t numNodes) { return maskBytes(numNodes) + numNodes * sizeof(WireType); };
+
+    std::vector<size_t> recvOffsets(peerRanks.size() + 1, 0);
+    for (int i = 0; i < peerRanks.size(); ++i)
+    {
+        recvOffsets[i + 1] = recvOffsets[i] + round_up(maxBytes(focusAssignment[peerRanks[i]].count()), 64);
+    }
+    std::vector<char> recvBuffer(recvOffsets.back());
+
+    std::vector<MPI_Request> recvRequests;
+    recvRequests.reserve(peerRanks.size());
+    for (int i = 0; i < peerRanks.size(); ++i)
     {
-        MPI_Status status;
-        MPI_Probe(MPI_ANY_SOURCE, commTag, MPI_COMM_WORLD, &status);
-        int recvRank = status.MPI_SOURCE;
-        TreeNodeIndex recvCount;
-        mpiGetCount<T>(&status, &recvCount);
+        mpiRecvAsync(recvBuffer.data() + recvOffsets[i], recvOffsets[i + 1] - recvOffsets[i], peerRanks[i], commTag,
+                     recvRequests);
+    }
 
-        int peerIdx = std::find(peerRanks.begin(), peerRanks.end(), recvRank) - peerRanks.begin();
-        T* recvBuf  = recvBuffers[peerIdx].data();
-        mpiRecvSyncAcc<useGpu>(recvBuf, recvCount, recvRank, commTag, MPI_STATUS_IGNORE);
+    std::vector<std::vector<char>> sendBuffers(peerRanks.size());
+    std::vector<MPI_Request> sendRequests;
+    sendRequests.reserve(peerRanks.size());
+    for (int i = 0; i < peerRanks.size(); ++i)
+    {
+        auto treelet = treeletIdx[peerRanks[i]];
+        auto& buffer = sendBuffers[i];
+        buffer.assign(maxBytes(treelet.size()), 0);
+
+        auto* mask       = reinterpret_cast<MaskType*>(buffer.data());
+        char* values     = buffer.data() + maskBytes(treelet.size());
+        size_t numValues = 0;
+        for (size_t j = 0; j < treelet.size(); ++j)
+        {
+            const T& q = quantities[treelet[j]];
+            if (codec.skip(q)) { continue; }
 
-        auto mapToInternal = csToInternalMap.subspan(focusAssignment[recvRank].start(), recvCount);
-        scatterAcc<useGpu>(mapToInternal, recvBuf, quantities.data());
+            mask[j / maskBits] |= MaskType(1) << (j % maskBits);
+            WireType w = codec.encode(q);
+            std::memcpy(values + numValues++ * sizeof(WireType), &w, sizeof(WireType));
+        }
+        mpiSendAsync(buffer.data(), maskBytes(treelet.size()) + numValues * sizeof(WireType), peerRanks[i], commTag,
+                     sendRequests);
     }
-    if constexpr (useGpu) { syncGpu(); }
+
+    waitsomeUnpack(recvRequests,
+                   [&](int i)
+                   {
+                       size_t numNodes    = focusAssignment[peerRanks[i]].count();
+                       const char* msg    = recvBuffer.data() + recvOffsets[i];
+                       const char* values = msg + maskBytes(numNodes);
+                       auto mapToInternal = csToInternalMap.subspan(focusAssignment[peerRanks[i]].start(), numNodes);
+
+                       size_t numValues = 0;
+                       for (size_t j = 0; j < numNodes; ++j)
+                       {
+                           MaskType maskWord;
+                           std::memcpy(&maskWord, msg + sizeof(MaskType) * (j / maskBits), sizeof(MaskType));
+                           if (maskWord & (MaskType(1) << (j % maskBits)))
+                           {
+                               WireType w;
+                               std::memcpy(&w, values + numValues++ * sizeof(WireType), sizeof(WireType));
+                               quantities[mapToInternal[j]] = codec.decode(w);
+                           }
+                           else { quantities[mapToInternal[j]] = T{}; }
+                       }
+                   });
 
     MPI_Waitall(int(sendRequests.size()), sendRequests.data(), MPI_STATUS_IGNORE);
-    reallocate(scratch, origSize, 1.0);
 }
 
 /*! @brief Pass on focus tree parts from old owners to new owners
@@ -409,7 +531,7 @@ void focusTransfer(gsl::span<const KeyType> cstree,
     {
         // current rank gained range [newFocusStart : oldFocusStart] from rank below
         MPI_Status status;
-        MPI_Probe(myRank - 1, ownerTag, MPI_COMM_WORLD, &status);
+        MPI_Probe(myRank - 1, ownerTag, domainComm(), &status);
         TreeNodeIndex receiveSize;
         MPI_Get_count(&status, MpiType<KeyType>{}, &receiveSize);
 
@@ -421,7 +543,7 @@ void focusTransfer(gsl::span<const KeyType> cstree,
     {
         // current rank gained range [oldFocusEnd : newFocusEnd] from rank above
         MPI_Status status;
-        MPI_Probe(myRank + 1, ownerTag, MPI_COMM_WORLD, &status);
+        MPI_Probe(myRank + 1, ownerTag, domainComm(), &status);
         TreeNodeIndex receiveSize;
         MPI_Get_count(&status, MpiType<KeyType>{}, &receiveSize);
 
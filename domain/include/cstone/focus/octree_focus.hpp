@@ -403,6 +403,7 @@ public:
 
     gsl::span<const KeyType> treeLeaves() const { return leaves_; }
     gsl::span<const unsigned> leafCounts() const { return leafCounts_; }
+    OctreeView<const KeyType> octreeView() const { return tree_.data(); }
 
 private:
     //! @brief opening angle refinement criterion
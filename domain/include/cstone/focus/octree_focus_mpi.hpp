@@ -153,8 +153,11 @@ public:
         }
         else
         {
+            bool useCosts = costCounts_.size() == counts_.size();
             converged = CombinedUpdate<KeyType>::updateFocus(treeData_, leaves_, bucketSize_, focusStart, focusEnd,
-                                                             enforcedKeys, counts_, macs_);
+                                                             enforcedKeys, useCosts ? costCounts_ : counts_, macs_);
+            // costs refer to the leaves before the update
+            costCounts_.clear();
             while (not macRefine(treeData_, leaves_, centers_, macs_, prevFocusStart, prevFocusEnd, focusStart,
                                  focusEnd, invThetaRefine, box))
                 ;
@@ -272,12 +275,51 @@ public:
         rebalanceStatus_ |= countsCriterion;
     }
 
+    //! @brief change the maximum number of particles per leaf inside the focus area for subsequent tree updates
+    void setBucketSize(unsigned bucketSize) { bucketSize_ = bucketSize; }
+
+    /*! @brief provide cost estimates of the current leaves to equalize the cost per leaf in the next updateTree
+     *
+     * @param[in] leafCosts     cost per leaf node, e.g. neighbor pairs from the last step, 0 where not available,
+     *                          length = numLeafNodes
+     * @param[in] maxCostRatio  maximum factor by which leaf particle counts may deviate from the bucket size
+     *
+     * Needs to be called after updateCounts. In the next call to updateTree, the bucket size criterion is applied
+     * to cost-weighted particle counts, see costWeightedCounts. Only supported on the CPU, ignored otherwise.
+     */
+    void setLeafCosts(gsl::span<const float> leafCosts, float maxCostRatio)
+    {
+        if constexpr (!HaveGpu<Accelerator>{})
+        {
+            assert(leafCosts.size() == leafCounts_.size());
+            // costs are only available for the local leaves, the reference is the mean cost across all ranks
+            auto totals = leafCostTotals(leafCounts_, leafCosts);
+            MPI_Allreduce(MPI_IN_PLACE, totals.data(), 2, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+            double meanCost = totals[1] > 0 ? totals[0] / totals[1] : 0;
+
+            std::vector<unsigned> weightedLeafCounts(leafCounts_.size());
+            costWeightedCounts(leafCounts_, leafCosts, meanCost, maxCostRatio, weightedLeafCounts);
+
+            costCounts_.resize(treeData_.numNodes);
+            scatter<TreeNodeIndex>(leafToInternal(treeData_), weightedLeafCounts.data(), costCounts_.data());
+            upsweep(treeData_.levelRange, treeData_.childOffsets, costCounts_.data(), NodeCount<unsigned>{});
+        }
+    }
+
     template<class T, class DevVec>
     void peerExchange(gsl::span<T> q, int commTag, DevVec& s) const
     {
         exchangeTreeletGeneral<T>(peers_, treeletIdx_.view(), assignment_, leafToInternal(treeData_), q, commTag, s);
     }
 
+    //! @brief peer exchange in the compact wire format of @p codec, see exchangeTreeletCompact
+    template<class T, class Codec>
+    void peerExchangeCompact(gsl::span<T> q, int commTag, const Codec& codec) const
+    {
+        exchangeTreeletCompact<T>(peers_, treeletIdx_.view(), assignment_, leafToInternal(treeData_), q, commTag,
+                                  codec);
+    }
+
     template<class T, class DevVec>
     void peerExchangeGpu(gsl::span<T> q, int commTag, DevVec& s) const
     {
@@ -362,7 +404,7 @@ public:
         }
 
         mpiAllgatherv(MPI_IN_PLACE, 0, globalLeafQuantities.data(), numGlobNodesPerRank.data(), globNodesDispl.data(),
-                      MPI_COMM_WORLD);
+                      domainComm());
     }
 
     template<class Tm, class DevVec1 = std::vector<LocalIndex>, class DevVec2 = std::vector<LocalIndex>>
@@ -530,6 +572,39 @@ public:
         rebalanceStatus_ |= macCriterion;
     }
 
+    /*! @brief replace the tree structure with @p leaves as a starting point for converge()
+     *
+     * @param[in] leaves  cornerstone leaf keys, e.g. the global tree leaves inside the focus and coarse cells outside
+     * @param[in] box     global coordinate bounding box
+     *
+     * As in the initial single-cell tree, counts are set above the bucket size, such that the first updateTree() in
+     * converge() subdivides the seeded leaves once and does not report convergence before the actual counts are known.
+     */
+    void seedLeaves(gsl::span<const KeyType> leaves, const Box<RealType>& box)
+    {
+        leaves_.assign(leaves.begin(), leaves.end());
+        treeData_.resize(nNodes(leaves_));
+        updateInternalTree<KeyType>(leaves_, treeData_.data());
+
+        leafCounts_.assign(nNodes(leaves_), bucketSize_ + 1);
+        counts_.assign(treeData_.numNodes, bucketSize_ + 1);
+        macs_.assign(treeData_.numNodes, 1);
+        centers_.resize(treeData_.numNodes);
+
+        if constexpr (HaveGpu<Accelerator>{})
+        {
+            uploadOctree();
+            reallocate(countsAcc_, counts_.size(), allocGrowthRate_);
+            memcpyH2D(counts_.data(), counts_.size(), rawPtr(countsAcc_));
+            reallocate(macsAcc_, macs_.size(), allocGrowthRate_);
+            memcpyH2D(macs_.data(), macs_.size(), rawPtr(macsAcc_));
+        }
+
+        box_             = box;
+        rebalanceStatus_ = valid;
+        updateGeoCenters();
+    }
+
     //! @brief update until converged with a simple min-distance MAC
     template<class DeviceVector = std::vector<KeyType>>
     void converge(const Box<RealType>& box,
@@ -718,6 +793,8 @@ private:
     std::vector<unsigned> leafCounts_;
     //! @brief particle counts of the full tree, tree_.octree()
     std::vector<unsigned> counts_;
+    //! @brief cost-weighted counts per node for the next tree update, empty if no costs were provided
+    std::vector<unsigned> costCounts_;
     //! @brief mac evaluation result relative to focus area (pass or fail)
     std::vector<char> macs_;
     //! @brief the expansion (com) centers of each cell of tree_.octree()
@@ -733,6 +810,32 @@ private:
     int rebalanceStatus_{valid};
 };
 
+//! @brief implementation of globalFocusExchange with a custom function to allgather the global leaf quantities
+template<class Q, class KeyType, class T, class G, class F, class Accelerator, class... UArgs>
+void globalFocusExchangeImpl(const Octree<KeyType>& globalOctree,
+                             const FocusedOctree<KeyType, T, Accelerator>& focusTree,
+                             gsl::span<Q> quantities,
+                             G&& gatherLeaves,
+                             F&& upsweepFunction,
+                             UArgs&&... upsweepArgs)
+{
+    TreeNodeIndex numGlobalLeaves = globalOctree.numLeafNodes();
+    std::vector<Q> globalLeafQuantities(numGlobalLeaves);
+    focusTree.template populateGlobal<Q>(globalOctree.treeLeaves(), quantities, globalLeafQuantities);
+
+    //! exchange global leaves
+    gatherLeaves(gsl::span<Q>(globalLeafQuantities));
+
+    std::vector<Q> globalQuantities(globalOctree.numTreeNodes());
+    scatter(globalOctree.internalOrder(), globalLeafQuantities.data(), globalQuantities.data());
+    //! upsweep with the global tree
+    upsweepFunction(globalOctree.levelRange(), globalOctree.childOffsets(), globalQuantities.data(), upsweepArgs...);
+
+    //! from the global tree, extract the part that the executing rank was missing
+    focusTree.template extractGlobal<Q>(globalOctree.nodeKeys().data(), globalOctree.levelRange().data(),
+                                        globalQuantities, quantities);
+}
+
 /*! @brief exchange data of non-peer (beyond focus) tree cells
  *
  * @tparam        Q                an arithmetic type, or compile-time fix-sized arrays thereof
@@ -766,21 +869,36 @@ void globalFocusExchange(const Octree<KeyType>& globalOctree,
                          F&& upsweepFunction,
                          UArgs&&... upsweepArgs)
 {
-    TreeNodeIndex numGlobalLeaves = globalOctree.numLeafNodes();
-    std::vector<Q> globalLeafQuantities(numGlobalLeaves);
-    focusTree.template populateGlobal<Q>(globalOctree.treeLeaves(), quantities, globalLeafQuantities);
+    auto gatherLeaves = [&](gsl::span<Q> globalLeafQuantities)
+    { focusTree.template gatherGlobalLeaves<Q>(globalOctree.treeLeaves(), globalLeafQuantities); };
 
-    //! exchange global leaves
-    focusTree.template gatherGlobalLeaves<Q>(globalOctree.treeLeaves(), globalLeafQuantities);
+    globalFocusExchangeImpl(globalOctree, focusTree, quantities, gatherLeaves, upsweepFunction, upsweepArgs...);
+}
 
-    std::vector<Q> globalQuantities(globalOctree.numTreeNodes());
-    scatter(globalOctree.internalOrder(), globalLeafQuantities.data(), globalQuantities.data());
-    //! upsweep with the global tree
-    upsweepFunction(globalOctree.levelRange(), globalOctree.childOffsets(), globalQuantities.data(), upsweepArgs...);
+/*! @brief like globalFocusExchange, but global leaf quantities are communicated in Codec::WireType
+ *
+ * @p codec provides encode and decode functions between Q and Codec::WireType, see exchangeTreeletCompact
+ */
+template<class Q, class KeyType, class T, class Codec, class F, class Accelerator, class... UArgs>
+void globalFocusExchangeCompact(const Octree<KeyType>& globalOctree,
+                                const FocusedOctree<KeyType, T, Accelerator>& focusTree,
+                                gsl::span<Q> quantities,
+                                const Codec& codec,
+                                F&& upsweepFunction,
+                                UArgs&&... upsweepArgs)
+{
+    using WireType    = typename Codec::WireType;
+    auto gatherLeaves = [&](gsl::span<Q> globalLeafQuantities)
+    {
+        std::vector<WireType> wire(globalLeafQuantities.size());
+        std::transform(globalLeafQuantities.begin(), globalLeafQuantities.end(), wire.begin(),
+                       [&codec](const Q& q) { return codec.encode(q); });
+        focusTree.template gatherGlobalLeaves<WireType>(globalOctree.treeLeaves(), wire);
+        std::transform(wire.begin(), wire.end(), globalLeafQuantities.begin(),
+                       [&codec](const WireType& w) { return codec.decode(w); });
+    };
 
-    //! from the global tree, extract the part that the executing rank was missing
-    focusTree.template extractGlobal<Q>(globalOctree.nodeKeys().data(), globalOctree.levelRange().data(),
-                                        globalQuantities, quantities);
+    globalFocusExchangeImpl(globalOctree, focusTree, quantities, gatherLeaves, upsweepFunction, upsweepArgs...);
 }
 
 } // namespace cstone
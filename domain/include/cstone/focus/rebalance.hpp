@@ -30,11 +30,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 #include "cstone/traversal/boxoverlap.hpp"
 #include "cstone/tree/csarray.hpp"
 #include "cstone/tree/octree.hpp"
+#include "cstone/util/array.hpp"
 #include "cstone/util/gsl-lite.hpp"
 
 namespace cstone
@@ -87,6 +90,68 @@ inline HOST_DEVICE_FUN int mergeCountAndMacOp(TreeNodeIndex nodeIdx,
     return 1; // default: do nothing
 }
 
+//! @brief sum of costs and sum of particle counts over all leaves with costs, see costWeightedCounts
+inline util::array<double, 2> leafCostTotals(gsl::span<const unsigned> leafCounts, gsl::span<const float> leafCosts)
+{
+    assert(leafCounts.size() == leafCosts.size());
+
+    double totalCost = 0, totalCount = 0;
+#pragma omp parallel for reduction(+ : totalCost, totalCount)
+    for (size_t i = 0; i < leafCounts.size(); ++i)
+    {
+        if (leafCosts[i] > 0)
+        {
+            totalCost += leafCosts[i];
+            totalCount += leafCounts[i];
+        }
+    }
+    return {totalCost, totalCount};
+}
+
+/*! @brief scale leaf particle counts with the relative cost per particle of each leaf
+ *
+ * @param[in]  leafCounts      particle count per leaf node
+ * @param[in]  leafCosts       measured cost per leaf node, e.g. number of neighbor pairs, 0 if not available
+ * @param[in]  meanCost        reference cost per particle, e.g. the global mean obtained from leafCostTotals
+ * @param[in]  maxCostRatio    bound for the scaling factors, which are clamped to [1/maxCostRatio, maxCostRatio]
+ * @param[out] weightedCounts  leafCounts multiplied by the cost per particle of the leaf relative to @p meanCost
+ *
+ * Using the weighted counts for the bucket size criterion splits leaves with expensive particles at lower particle
+ * counts and merges leaves with cheap particles up to higher counts, such that the work per leaf is more uniform.
+ * Leaves without cost information keep their particle count.
+ */
+inline void costWeightedCounts(gsl::span<const unsigned> leafCounts,
+                               gsl::span<const float> leafCosts,
+                               double meanCost,
+                               float maxCostRatio,
+                               gsl::span<unsigned> weightedCounts)
+{
+    assert(leafCounts.size() == leafCosts.size() && leafCounts.size() == weightedCounts.size());
+
+#pragma omp parallel for
+    for (size_t i = 0; i < leafCounts.size(); ++i)
+    {
+        if (leafCosts[i] > 0 && leafCounts[i] > 0 && meanCost > 0)
+        {
+            double factor     = std::clamp(leafCosts[i] / (leafCounts[i] * meanCost), 1.0 / maxCostRatio,
+                                           double(maxCostRatio));
+            weightedCounts[i] = unsigned(std::lround(leafCounts[i] * factor));
+        }
+        else { weightedCounts[i] = leafCounts[i]; }
+    }
+}
+
+//! @brief costWeightedCounts relative to the mean cost per particle of all leaves with costs in @p leafCosts
+inline void costWeightedCounts(gsl::span<const unsigned> leafCounts,
+                               gsl::span<const float> leafCosts,
+                               float maxCostRatio,
+                               gsl::span<unsigned> weightedCounts)
+{
+    auto [totalCost, totalCount] = leafCostTotals(leafCounts, leafCosts);
+    double meanCost              = totalCount > 0 ? totalCost / totalCount : 0;
+    costWeightedCounts(leafCounts, leafCosts, meanCost, maxCostRatio, weightedCounts);
+}
+
 //! @brief refine nodes based on Mac only
 template<class KeyType>
 inline HOST_DEVICE_FUN int macRefineOp(KeyType nodeKey, char mac)
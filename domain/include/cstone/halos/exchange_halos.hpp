@@ -15,11 +15,16 @@
 
 #pragma once
 
+#include <memory>
 #include <numeric>
+#include <optional>
 #include <vector>
 
+#include "cstone/primitives/mpi_progress.hpp"
 #include "cstone/primitives/mpi_wrappers.hpp"
+#include "cstone/primitives/peer_exchange.hpp"
 #include "cstone/domain/buffer_description.hpp"
+#include "cstone/util/scratch_arena.hpp"
 
 namespace cstone
 {
@@ -30,7 +35,8 @@ void haloexchange(int epoch, const RecvList& incomingHalos, const SendList& outg
     using IndexType     = SendManifest::IndexType;
     int haloExchangeTag = static_cast<int>(P2pTags::haloExchange) + epoch;
 
-    std::vector<std::vector<char>> sendBuffers;
+    // send and receive buffers are released when the frame goes out of scope, i.e. after MPI_Waitall
+    auto scratchFrame = scratchArena().frame();
     std::vector<MPI_Request> sendRequests;
 
     for (std::size_t destinationRank = 0; destinationRank < outgoingHalos.size(); ++destinationRank)
@@ -38,7 +44,7 @@ void haloexchange(int epoch, const RecvList& incomingHalos, const SendList& outg
         size_t sendCount = outgoingHalos[destinationRank].totalCount();
         if (sendCount == 0) continue;
 
-        std::vector<char> buffer(util::computeByteOffsets(sendCount, 1, arrays...).back());
+        auto buffer = scratchArena().allocate<char>(util::computeByteOffsets(sendCount, 1, arrays...).back());
 
         auto packSendBuffer = [&outHalos = outgoingHalos[destinationRank]](auto arrayPair)
         {
@@ -53,7 +59,6 @@ void haloexchange(int epoch, const RecvList& incomingHalos, const SendList& outg
         for_each_tuple(packSendBuffer, packTuple);
 
         mpiSendAsync(buffer.data(), buffer.size(), destinationRank, haloExchangeTag, sendRequests);
-        sendBuffers.push_back(std::move(buffer));
     }
 
     int numMessages           = 0;
@@ -65,7 +70,7 @@ void haloexchange(int epoch, const RecvList& incomingHalos, const SendList& outg
     }
     size_t maxReceiveBytes = util::computeByteOffsets(maxReceiveSize, 1, arrays...).back();
 
-    std::vector<char> receiveBuffer(maxReceiveBytes);
+    auto receiveBuffer = scratchArena().allocate<char>(maxReceiveBytes);
 
     while (numMessages--)
     {
@@ -92,4 +97,133 @@ void haloexchange(int epoch, const RecvList& incomingHalos, const SendList& outg
     // MPI_Barrier(MPI_COMM_WORLD);
 }
 
+/*! @brief handle to a started halo exchange, completes receives and unpacks them into the halo ranges on wait()
+ *
+ * Receives are preposted when the exchange is started, such that messages can arrive while the caller performs
+ * independent work. If an MpiProgressThread is running, it unpacks messages as they arrive. The arrays that receive
+ * halos must therefore not be accessed before wait() returns.
+ *
+ * The send and receive buffers are allocated from the scratch arena of the starting thread. wait() has to be called
+ * on the same thread and scratch frames opened in between must be closed before.
+ */
+class PendingHaloExchange
+{
+public:
+    PendingHaloExchange() = default;
+
+    PendingHaloExchange(PendingHaloExchange&&)            = default;
+    PendingHaloExchange& operator=(PendingHaloExchange&&) = delete;
+
+    ~PendingHaloExchange() { wait(); }
+
+    //! @brief complete the exchange, no-op if already completed
+    void wait()
+    {
+        if (receives_)
+        {
+            progressRegistry().remove(receives_.get());
+            waitsomeUnpack(receives_->requests, receives_->unpack);
+            receives_.reset();
+        }
+        if (not sendRequests_.empty())
+        {
+            MPI_Waitall(int(sendRequests_.size()), sendRequests_.data(), MPI_STATUSES_IGNORE);
+        }
+        sendRequests_.clear();
+        scratchFrame_.reset();
+    }
+
+    template<class... Arrays>
+    friend PendingHaloExchange
+    haloExchangeStart(int epoch, const RecvList& incomingHalos, const SendList& outgoingHalos, Arrays... arrays);
+
+private:
+    std::vector<MPI_Request> sendRequests_;
+    //! @brief heap allocated to keep its address stable for the progress registry when the handle is moved
+    std::unique_ptr<PendingReceives> receives_;
+    //! @brief holds the send and receive buffers until the exchange is complete
+    std::optional<ScratchArena::Frame> scratchFrame_;
+};
+
+/*! @brief start a halo exchange, to be completed by calling wait() on the returned handle
+ *
+ * Same arguments as haloexchange. In contrast to haloexchange, the send and receive buffers for all peers are allocated
+ * at once, since they are in use until the exchange completes.
+ */
+template<class... Arrays>
+PendingHaloExchange
+haloExchangeStart(int epoch, const RecvList& incomingHalos, const SendList& outgoingHalos, Arrays... arrays)
+{
+    int haloExchangeTag = static_cast<int>(P2pTags::haloExchange) + epoch;
+    // keep the messages of all peers aligned in the common buffers
+    auto messageBytes = [arrays...](size_t count)
+    { return round_up(util::computeByteOffsets(count, 1, arrays...).back(), 64); };
+
+    PendingHaloExchange ex;
+    ex.scratchFrame_.emplace(scratchArena());
+    ex.receives_ = std::make_unique<PendingReceives>();
+
+    std::vector<int> sources;
+    RecvList recvRanges;
+    std::vector<size_t> recvOffsets{0};
+    for (int rank = 0; rank < int(incomingHalos.size()); ++rank)
+    {
+        if (incomingHalos[rank].count() == 0) { continue; }
+        sources.push_back(rank);
+        recvRanges.push_back(incomingHalos[rank]);
+        recvOffsets.push_back(recvOffsets.back() + messageBytes(incomingHalos[rank].count()));
+    }
+    char* recvBuffer = scratchArena().allocate<char>(recvOffsets.back()).data();
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+        mpiRecvAsync(recvBuffer + recvOffsets[i], recvOffsets[i + 1] - recvOffsets[i], sources[i], haloExchangeTag,
+                     ex.receives_->requests);
+    }
+
+    std::vector<size_t> sendOffsets(outgoingHalos.size() + 1, 0);
+    for (size_t rank = 0; rank < outgoingHalos.size(); ++rank)
+    {
+        size_t sendCount      = outgoingHalos[rank].totalCount();
+        sendOffsets[rank + 1] = sendOffsets[rank] + (sendCount ? messageBytes(sendCount) : 0);
+    }
+    char* sendBuffer = scratchArena().allocate<char>(sendOffsets.back()).data();
+
+    for (size_t destinationRank = 0; destinationRank < outgoingHalos.size(); ++destinationRank)
+    {
+        size_t sendCount = outgoingHalos[destinationRank].totalCount();
+        if (sendCount == 0) continue;
+
+        char* buffer = sendBuffer + sendOffsets[destinationRank];
+
+        auto packSendBuffer = [&outHalos = outgoingHalos[destinationRank]](auto arrayPair)
+        {
+            for (std::size_t rangeIdx = 0; rangeIdx < outHalos.nRanges(); ++rangeIdx)
+            {
+                std::copy_n(arrayPair[0] + outHalos.rangeStart(rangeIdx), outHalos.count(rangeIdx),
+                            arrayPair[1] + outHalos.scan()[rangeIdx]);
+            }
+        };
+
+        auto packTuple = util::packBufferPtrs<1>(buffer, sendCount, arrays...);
+        for_each_tuple(packSendBuffer, packTuple);
+
+        mpiSendAsync(buffer, sendOffsets[destinationRank + 1] - sendOffsets[destinationRank], destinationRank,
+                     haloExchangeTag, ex.sendRequests_);
+    }
+
+    ex.receives_->unpack = [recvRanges = std::move(recvRanges), recvOffsets = std::move(recvOffsets), recvBuffer,
+                            arrays...](int i)
+    {
+        const auto& inHalos = recvRanges[i];
+        auto unpack         = [&inHalos](auto arrayPair)
+        { std::copy_n(arrayPair[1], inHalos.count(), arrayPair[0] + inHalos.start()); };
+
+        auto packTuple = util::packBufferPtrs<1>(recvBuffer + recvOffsets[i], inHalos.count(), arrays...);
+        for_each_tuple(unpack, packTuple);
+    };
+    progressRegistry().add(ex.receives_.get());
+
+    return ex;
+}
+
 } // namespace cstone
@@ -31,6 +31,7 @@
 #include "cstone/primitives/accel_switch.hpp"
 #include "cstone/util/gsl-lite.hpp"
 #include "cstone/util/reallocate.hpp"
+#include "cstone/util/scratch_arena.hpp"
 
 namespace cstone
 {
@@ -172,7 +173,9 @@ public:
             layout[0] = 0;
             std::inclusive_scan(counts.begin() + firstNode, counts.begin() + lastNode, layout.begin() + 1,
                                 std::plus<>{}, LocalIndex(0));
-            std::vector<float> haloRadii(counts.size(), 0.0f);
+            auto scratchFrame = scratchArena().frame();
+            auto haloRadii    = scratchArena().allocate<float>(counts.size());
+            std::fill(haloRadii.begin(), haloRadii.end(), 0.0f);
 #pragma omp parallel for schedule(static)
             for (TreeNodeIndex i = 0; i < numNodesSearch; ++i)
             {
@@ -250,6 +253,31 @@ public:
         }
     }
 
+    /*! @brief start a halo exchange that is completed by calling wait() on the returned handle
+     *
+     * Arguments as in exchangeHalos. On GPUs, the exchange is completed before returning.
+     */
+    template<class Scratch1, class Scratch2, class... Vectors>
+    PendingHaloExchange
+    startHaloExchange(std::tuple<Vectors&...> arrays, Scratch1& sendBuffer, Scratch2& receiveBuffer) const
+    {
+        if constexpr (HaveGpu<Accelerator>{})
+        {
+            exchangeHalos(arrays, sendBuffer, receiveBuffer);
+            return {};
+        }
+        else
+        {
+            return std::apply(
+                [this](auto&... arrays)
+                {
+                    return haloExchangeStart(haloEpoch_++, incomingHaloIndices_, outgoingHaloIndices_,
+                                             rawPtr(arrays)...);
+                },
+                arrays);
+        }
+    }
+
     gsl::span<int> haloFlags() { return haloFlags_; }
 
 private:
@@ -41,10 +41,51 @@
 #include "cstone/util/gsl-lite.hpp"
 #include "cstone/util/noinit_alloc.hpp"
 #include "cstone/util/reallocate.hpp"
+#include "cstone/util/scratch_arena.hpp"
 
 namespace cstone
 {
 
+/*! @brief stable sort of @p n elements of @p data, using @p buffer of the same length as temporary storage
+ *
+ * @return pointer to the sorted sequence, either @p data or @p buffer
+ *
+ * Unlike std::stable_sort, no temporary storage is allocated. Short runs are sorted by insertion, followed by
+ * bottom-up merge passes that alternate between @p data and @p buffer.
+ */
+template<class T, class Compare>
+T* stableMergeSort(T* data, T* buffer, std::size_t n, Compare compare)
+{
+    constexpr std::size_t runLength = 32;
+
+#pragma omp parallel for schedule(static)
+    for (std::size_t start = 0; start < n; start += runLength)
+    {
+        T* first = data + start;
+        T* last  = data + std::min(start + runLength, n);
+        for (T* it = first + 1; it < last; ++it)
+        {
+            T  element = *it;
+            T* pos     = std::upper_bound(first, it, element, compare);
+            std::move_backward(pos, it, it + 1);
+            *pos = element;
+        }
+    }
+
+    for (std::size_t width = runLength; width < n; width *= 2)
+    {
+#pragma omp parallel for schedule(static)
+        for (std::size_t start = 0; start < n; start += 2 * width)
+        {
+            std::size_t mid = std::min(start + width, n);
+            std::size_t end = std::min(start + 2 * width, n);
+            std::merge(data + start, data + mid, data + mid, data + end, buffer + start, compare);
+        }
+        std::swap(data, buffer);
+    }
+    return data;
+}
+
 /*! @brief sort values according to a key
  *
  * @param[inout] keyBegin    key sequence start
@@ -62,23 +103,30 @@ void sort_by_key(InoutIterator keyBegin, InoutIterator keyEnd, OutputIterator va
     using ValueType = std::decay_t<decltype(*valueBegin)>;
     std::size_t n   = std::distance(keyBegin, keyEnd);
 
+    struct KeyValue
+    {
+        KeyType key;
+        ValueType value;
+    };
+
     // zip the input integer array together with the index sequence
-    std::vector<std::tuple<KeyType, ValueType>, util::DefaultInitAdaptor<std::tuple<KeyType, ValueType>>> keyIndexPairs(
-        n);
+    auto scratchFrame  = scratchArena().frame();
+    auto keyIndexPairs = scratchArena().allocate<KeyValue>(n);
+    auto mergeBuffer   = scratchArena().allocate<KeyValue>(n);
 #pragma omp parallel for schedule(static)
     for (std::size_t i = 0; i < n; ++i)
-        keyIndexPairs[i] = std::make_tuple(keyBegin[i], valueBegin[i]);
+        keyIndexPairs[i] = KeyValue{keyBegin[i], valueBegin[i]};
 
-    // sort, comparing only the first tuple element
-    std::stable_sort(begin(keyIndexPairs), end(keyIndexPairs),
-                     [compare](const auto& t1, const auto& t2) { return compare(std::get<0>(t1), std::get<0>(t2)); });
+    // sort, comparing only the keys
+    auto compareKeys       = [compare](const auto& t1, const auto& t2) { return compare(t1.key, t2.key); };
+    const KeyValue* sorted = stableMergeSort(keyIndexPairs.data(), mergeBuffer.data(), n, compareKeys);
 
 // extract the resulting ordering and store back the sorted keys
 #pragma omp parallel for schedule(static)
     for (std::size_t i = 0; i < n; ++i)
     {
-        keyBegin[i]   = std::get<0>(keyIndexPairs[i]);
-        valueBegin[i] = std::get<1>(keyIndexPairs[i]);
+        keyBegin[i]   = sorted[i].key;
+        valueBegin[i] = sorted[i].value;
     }
 }
 
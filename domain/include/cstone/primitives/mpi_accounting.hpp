@@ -0,0 +1,101 @@
+/*
+ * Cornerstone octree
+ *
+ * Copyright (c) 2024 CSCS, ETH Zurich, University of Zurich, 2021 University of Basel
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: MIT License
+ */
+
+/*! @file
+ * @brief Accounting of point-to-point message volumes issued through the cstone MPI wrappers
+ *
+ * The send and receive wrappers in mpi_wrappers.hpp report every message to the process-wide accounting object.
+ * Counters accumulate until they are collected, which attributes them to the code section since the previous
+ * collection, e.g. a timer phase. Accounting is disabled by default, in which case each message costs one branch.
+ * Messages are expected to be issued from a single thread.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace cstone
+{
+
+//! @brief point-to-point traffic of one rank within a code section
+struct CommVolume
+{
+    uint64_t bytesSent{0};
+    uint64_t messagesSent{0};
+    uint64_t bytesReceived{0};
+    uint64_t messagesReceived{0};
+    //! @brief number of distinct ranks that were sent to or received from
+    uint64_t numPeers{0};
+};
+
+class CommAccounting
+{
+public:
+    void setEnabled(bool enable)
+    {
+        enabled_ = enable;
+        reset();
+    }
+
+    [[nodiscard]] bool enabled() const { return enabled_; }
+
+    void recordSend(int peer, uint64_t numBytes)
+    {
+        if (!enabled_) { return; }
+        volume_.bytesSent += numBytes;
+        volume_.messagesSent++;
+        addPeer(peer);
+    }
+
+    void recordReceive(int peer, uint64_t numBytes)
+    {
+        if (!enabled_) { return; }
+        volume_.bytesReceived += numBytes;
+        volume_.messagesReceived++;
+        addPeer(peer);
+    }
+
+    //! @brief return the traffic since the last call and reset the counters
+    CommVolume collect()
+    {
+        CommVolume ret = volume_;
+        ret.numPeers   = peers_.size();
+        reset();
+        return ret;
+    }
+
+private:
+    void reset()
+    {
+        volume_ = CommVolume{};
+        peers_.clear();
+    }
+
+    //! @brief insert into the sorted list of peers, which is short compared to the number of ranks
+    void addPeer(int peer)
+    {
+        auto it = std::lower_bound(peers_.begin(), peers_.end(), peer);
+        if (it == peers_.end() || *it != peer) { peers_.insert(it, peer); }
+    }
+
+    bool             enabled_{false};
+    CommVolume       volume_;
+    std::vector<int> peers_;
+};
+
+//! @brief process-wide accounting of the messages issued through the cstone MPI wrappers
+inline CommAccounting& commAccounting()
+{
+    static CommAccounting accounting;
+    return accounting;
+}
+
+} // namespace cstone
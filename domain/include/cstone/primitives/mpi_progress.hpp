@@ -0,0 +1,179 @@
+/*
+ * Cornerstone octree
+ *
+ * Copyright (c) 2024 CSCS, ETH Zurich, University of Zurich, 2021 University of Basel
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: MIT License
+ */
+
+/*! @file
+ * @brief Background thread to drive MPI progress of outstanding nonblocking operations
+ *
+ * Many MPI implementations only advance nonblocking messages, e.g. the rendezvous protocol of large messages, while
+ * the application is inside an MPI call. Started exchanges therefore do not progress while the ranks compute.
+ * Exchanges that are left outstanding register their receive requests in the progress registry. While a progress
+ * thread is running, it tests the registered requests with MPI_Testsome and unpacks the messages that have arrived,
+ * such that posted sends and receives can complete in the background. This requires MPI_THREAD_MULTIPLE.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "cstone/primitives/mpi_wrappers.hpp"
+
+namespace cstone
+{
+
+//! @brief receive requests of an outstanding exchange and the callback to unpack the message of request i
+struct PendingReceives
+{
+    std::vector<MPI_Request> requests;
+    std::function<void(int)> unpack;
+};
+
+/*! @brief receives of outstanding exchanges that the progress thread tests and unpacks
+ *
+ * Registered receives are only accessed under the lock, the owner has to remove them before waiting on the requests
+ * itself or releasing the receive buffers.
+ */
+class ProgressRegistry
+{
+public:
+    //! @brief register @p receives for completion by the progress thread, no-op if there is no progress thread
+    void add(PendingReceives* receives)
+    {
+        std::lock_guard lock(mutex_);
+        if (!active_) { return; }
+        pending_.push_back(receives);
+        wakeup_.notify_one();
+    }
+
+    //! @brief remove @p receives, after return they are no longer accessed by the progress thread
+    void remove(PendingReceives* receives)
+    {
+        std::lock_guard lock(mutex_);
+        pending_.erase(std::remove(pending_.begin(), pending_.end(), receives), pending_.end());
+    }
+
+    void setActive(bool active)
+    {
+        std::lock_guard lock(mutex_);
+        active_ = active;
+        wakeup_.notify_all();
+    }
+
+    /*! @brief test and unpack all registered receives, waits while there are none
+     *
+     * @param[out] wasIdle  true if no receives were registered on entry
+     * @return              number of receives that completed, 0 if the registry was deactivated while waiting
+     */
+    int progress(bool& wasIdle)
+    {
+        std::unique_lock lock(mutex_);
+        wasIdle = pending_.empty();
+        wakeup_.wait(lock, [this] { return !pending_.empty() || !active_; });
+
+        int numCompleted = 0;
+        for (PendingReceives* receives : pending_)
+        {
+            completed_.resize(receives->requests.size());
+            int count;
+            MPI_Testsome(int(receives->requests.size()), receives->requests.data(), &count, completed_.data(),
+                         MPI_STATUSES_IGNORE);
+            if (count == MPI_UNDEFINED) { continue; }
+
+            for (int i = 0; i < count; ++i)
+            {
+                receives->unpack(completed_[i]);
+            }
+            numCompleted += count;
+        }
+        return numCompleted;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::vector<PendingReceives*> pending_;
+    std::vector<int> completed_;
+    bool active_{false};
+};
+
+inline ProgressRegistry& progressRegistry()
+{
+    static ProgressRegistry registry;
+    return registry;
+}
+
+class MpiProgressThread
+{
+public:
+    /*! @brief start the progress thread
+     *
+     * @param interval    pause between two tests while receives complete, a shorter interval reduces latency but
+     *                    competes with compute threads
+     * @param maxBackoff  the pause doubles up to @p maxBackoff * @p interval while no receives complete
+     */
+    explicit MpiProgressThread(std::chrono::microseconds interval = std::chrono::microseconds(50), int maxBackoff = 16)
+        : interval_(interval)
+        , maxInterval_(interval * maxBackoff)
+    {
+        int provided;
+        MPI_Query_thread(&provided);
+        if (provided < MPI_THREAD_MULTIPLE)
+        {
+            throw std::runtime_error("MPI progress thread requires MPI_THREAD_MULTIPLE\n");
+        }
+        progressRegistry().setActive(true);
+        thread_ = std::thread([this] { this->run(); });
+    }
+
+    MpiProgressThread(const MpiProgressThread&)            = delete;
+    MpiProgressThread& operator=(const MpiProgressThread&) = delete;
+
+    ~MpiProgressThread() { stop(); }
+
+    //! @brief stop and join the thread, must be called before MPI_Finalize
+    void stop()
+    {
+        running_ = false;
+        progressRegistry().setActive(false);
+        if (thread_.joinable()) { thread_.join(); }
+    }
+
+    //! @brief number of receives completed by the progress thread so far
+    uint64_t numCompleted() const { return numCompleted_; }
+
+private:
+    void run()
+    {
+        auto pause = interval_;
+        while (running_)
+        {
+            bool wasIdle;
+            int completed = progressRegistry().progress(wasIdle);
+            numCompleted_ += completed;
+
+            pause = (completed > 0 || wasIdle) ? interval_ : std::min(2 * pause, maxInterval_);
+            std::this_thread::sleep_for(pause);
+        }
+    }
+
+    std::chrono::microseconds interval_;
+    std::chrono::microseconds maxInterval_;
+    std::atomic<bool> running_{true};
+    std::atomic<uint64_t> numCompleted_{0};
+    std::thread thread_;
+};
+
+} // namespace cstone
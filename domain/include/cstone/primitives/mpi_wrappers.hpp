@@ -38,6 +38,20 @@
 #include <type_traits>
 #include <vector>
 
+#include "cstone/primitives/mpi_accounting.hpp"
+
+/*! @brief communicator for communication that depends on the rank order, i.e. point-to-point and gathers
+ *
+ * Domain ranks are identified with consecutive segments of the SFC. The default is MPI_COMM_WORLD, but it can be
+ * replaced with a communicator over the same processes in a different rank order before any Domain is constructed,
+ * see cstone/domain/rank_topology.hpp. Reductions are independent of the rank order and may keep using MPI_COMM_WORLD.
+ */
+inline MPI_Comm& domainComm()
+{
+    static MPI_Comm comm = MPI_COMM_WORLD;
+    return comm;
+}
+
 template<class T>
 struct MpiType
 {
@@ -113,8 +127,9 @@ template<class T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
 auto mpiSendAsync(T* data, size_t count, int rank, int tag, std::vector<MPI_Request>& requests)
 {
     assert(count <= std::numeric_limits<int>::max());
+    cstone::commAccounting().recordSend(rank, count * sizeof(T));
     requests.push_back(MPI_Request{});
-    return MPI_Isend(data, int(count), MpiType<std::decay_t<T>>{}, rank, tag, MPI_COMM_WORLD, &requests.back());
+    return MPI_Isend(data, int(count), MpiType<std::decay_t<T>>{}, rank, tag, domainComm(), &requests.back());
 }
 
 //! @brief adaptor to wrap compile-time size arrays into flattened arrays of the underlying type
@@ -138,7 +153,15 @@ auto mpiSendAsyncAs(char* data, size_t numBytes, int rank, int tag, std::vector<
 template<class T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
 auto mpiRecvSync(T* data, int count, int rank, int tag, MPI_Status* status)
 {
-    return MPI_Recv(data, count, MpiType<std::decay_t<T>>{}, rank, tag, MPI_COMM_WORLD, status);
+    auto ret = MPI_Recv(data, count, MpiType<std::decay_t<T>>{}, rank, tag, domainComm(), status);
+    if (cstone::commAccounting().enabled() && status != MPI_STATUS_IGNORE)
+    {
+        // the actual message may be shorter than the receive buffer and come from any source
+        MPI_Get_count(status, MpiType<std::decay_t<T>>{}, &count);
+        rank = status->MPI_SOURCE;
+    }
+    cstone::commAccounting().recordReceive(rank, count * sizeof(T));
+    return ret;
 }
 
 //! @brief adaptor to wrap compile-time size arrays into flattened arrays of the underlying type
@@ -158,11 +181,19 @@ auto mpiRecvSyncAs(char* data, size_t numBytes, int rank, int tag, MPI_Status* s
     return mpiRecvSync(reinterpret_cast<T*>(data), numBytes / sizeof(T), rank, tag, status);
 }
 
+//! @brief post a receive into @p request, accounted with the size of the receive buffer
+template<class T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+auto mpiRecvAsync(T* data, int count, int rank, int tag, MPI_Request* request)
+{
+    cstone::commAccounting().recordReceive(rank, count * sizeof(T));
+    return MPI_Irecv(data, count, MpiType<std::decay_t<T>>{}, rank, tag, domainComm(), request);
+}
+
 template<class T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
 auto mpiRecvAsync(T* data, int count, int rank, int tag, std::vector<MPI_Request>& requests)
 {
     requests.push_back(MPI_Request{});
-    return MPI_Irecv(data, count, MpiType<std::decay_t<T>>{}, rank, tag, MPI_COMM_WORLD, &requests.back());
+    return mpiRecvAsync(data, count, rank, tag, &requests.back());
 }
 
 //! @brief adaptor to wrap compile-time size arrays into flattened arrays of the underlying type
@@ -0,0 +1,95 @@
+/*
+ * Cornerstone octree
+ *
+ * Copyright (c) 2024 CSCS, ETH Zurich, University of Zurich, 2021 University of Basel
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: MIT License
+ */
+
+/*! @file
+ * @brief Building blocks for point-to-point exchanges with a mutual set of peer ranks without MPI_Probe
+ *
+ * Instead of receiving with MPI_Probe(MPI_ANY_SOURCE) / MPI_Get_count / blocking receive loops, peer exchanges
+ * proceed as follows:
+ *      1. if the receive sizes are not known in advance, exchange them with exchangeMessageSizes
+ *      2. prepost all receives into (a single) buffer with known offsets
+ *      3. post the sends
+ *      4. unpack each message as soon as it arrives with waitsomeUnpack
+ *
+ * This avoids serializing arrival handling and buffering of unexpected messages inside MPI.
+ */
+
+#pragma once
+
+#include <numeric>
+#include <vector>
+
+#include "cstone/primitives/mpi_wrappers.hpp"
+#include "cstone/util/gsl-lite.hpp"
+
+namespace cstone
+{
+
+/*! @brief exchange the element counts of the next message with each peer
+ *
+ * @param peers       list of peer ranks, the peer relation has to be mutual
+ * @param sendCounts  number of elements the executing rank will send to each peer, length = peers.size()
+ * @param tag         message tag, may be identical to the tag of the subsequent message
+ * @return            number of elements each peer will send to the executing rank, length = peers.size()
+ *
+ * The returned counts are complete after return and can be used to prepost receives of the right size.
+ * Since MPI messages between a pair of ranks with the same tag are non-overtaking, the subsequent data
+ * exchange can use the same tag.
+ */
+inline std::vector<int> exchangeMessageSizes(gsl::span<const int> peers, gsl::span<const int> sendCounts, int tag)
+{
+    std::vector<int> recvCounts(peers.size());
+    std::vector<MPI_Request> requests;
+    requests.reserve(2 * peers.size());
+
+    for (size_t i = 0; i < peers.size(); ++i)
+    {
+        mpiRecvAsync(recvCounts.data() + i, 1, peers[i], tag, requests);
+    }
+    for (size_t i = 0; i < peers.size(); ++i)
+    {
+        mpiSendAsync(sendCounts.data() + i, 1, peers[i], tag, requests);
+    }
+    MPI_Waitall(int(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+
+    return recvCounts;
+}
+
+//! @brief offsets into a single receive buffer for messages with @p counts elements, length = counts.size() + 1
+inline std::vector<size_t> messageOffsets(gsl::span<const int> counts)
+{
+    std::vector<size_t> offsets(counts.size() + 1);
+    offsets[0] = 0;
+    std::inclusive_scan(counts.begin(), counts.end(), offsets.begin() + 1, std::plus<>{}, size_t(0));
+    return offsets;
+}
+
+/*! @brief complete preposted receives and call @p unpack(i) for each completed request i in order of arrival
+ *
+ * @param requests  receive requests, may contain MPI_REQUEST_NULL for messages that were skipped
+ * @param unpack    callable with signature void(int), argument is the index of the completed request
+ */
+template<class F>
+void waitsomeUnpack(std::vector<MPI_Request>& requests, F&& unpack)
+{
+    std::vector<int> completed(requests.size());
+    while (true)
+    {
+        int numCompleted;
+        MPI_Waitsome(int(requests.size()), requests.data(), &numCompleted, completed.data(), MPI_STATUSES_IGNORE);
+        if (numCompleted == MPI_UNDEFINED) { break; }
+
+        for (int i = 0; i < numCompleted; ++i)
+        {
+            unpack(completed[i]);
+        }
+    }
+}
+
+} // namespace cstone
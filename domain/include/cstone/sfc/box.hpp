@@ -33,6 +33,7 @@
 
 #include <cassert>
 #include <cmath>
+#include <stdexcept>
 
 #include "cstone/cuda/annotation.hpp"
 #include "cstone/primitives/stl.hpp"
@@ -106,6 +107,13 @@ enum class BoundaryType : char
  * Needs a slightly different behavior in the PBC case than the existing BBox
  * to manage morton code based octrees.
  *
+ * By default, each dimension is mapped onto the full integer range of the SFC, such that octree cells have the same
+ * aspect ratio as the box. A tiled box instead maps dimension d onto the integer range [0:2^(maxTreeLevel - s_d)],
+ * where the SFC shift s_d is chosen such that the SFC edge lengths l_d * 2^s_d are equal to within a factor of sqrt(2).
+ * The box is then tiled by a grid of 2^(s_max - s_d) nearly cubic octree nodes per dimension. The key prefix of these
+ * nodes enumerates the tiles and a regular Hilbert curve runs inside each tile. Octree nodes outside the box are
+ * empty.
+ *
  * @tparam T floating point type
  */
 template<class T>
@@ -113,11 +121,16 @@ class Box
 {
 
 public:
+    //! @brief maximum SFC shift, corresponds to an aspect ratio of 32 and leaves 5 levels to 32-bit keys
+    static constexpr int maxSfcShift = 5;
+
     HOST_DEVICE_FUN constexpr Box(T xyzMin, T xyzMax, BoundaryType b = BoundaryType::open)
         : limits{xyzMin, xyzMax, xyzMin, xyzMax, xyzMin, xyzMax}
         , lengths_{xyzMax - xyzMin, xyzMax - xyzMin, xyzMax - xyzMin}
         , inverseLengths_{T(1.) / (xyzMax - xyzMin), T(1.) / (xyzMax - xyzMin), T(1.) / (xyzMax - xyzMin)}
         , boundaries{b, b, b}
+        , tiled_(false)
+        , sfcShifts_{0, 0, 0}
     {
     }
 
@@ -129,12 +142,22 @@ public:
                                   T zmax,
                                   BoundaryType bx = BoundaryType::open,
                                   BoundaryType by = BoundaryType::open,
-                                  BoundaryType bz = BoundaryType::open)
+                                  BoundaryType bz = BoundaryType::open,
+                                  bool tiled      = false)
         : limits{xmin, xmax, ymin, ymax, zmin, zmax}
         , lengths_{xmax - xmin, ymax - ymin, zmax - zmin}
         , inverseLengths_{T(1.) / (xmax - xmin), T(1.) / (ymax - ymin), T(1.) / (zmax - zmin)}
         , boundaries{bx, by, bz}
+        , tiled_(tiled)
+        , sfcShifts_{sfcShift(0), sfcShift(1), sfcShift(2)}
+    {
+    }
+
+    //! @brief return a copy of this box with tiled SFC mapping enabled or disabled
+    HOST_DEVICE_FUN constexpr Box<T> withTiling(bool tiled) const
     {
+        return Box<T>(limits[0], limits[1], limits[2], limits[3], limits[4], limits[5], boundaries[0], boundaries[1],
+                      boundaries[2], tiled);
     }
 
     HOST_DEVICE_FUN constexpr T xmin() const { return limits[0]; }
@@ -158,6 +181,23 @@ public:
     HOST_DEVICE_FUN constexpr BoundaryType boundaryY() const { return boundaries[1]; } // NOLINT
     HOST_DEVICE_FUN constexpr BoundaryType boundaryZ() const { return boundaries[2]; } // NOLINT
 
+    HOST_DEVICE_FUN constexpr bool tiled() const { return tiled_; }
+
+    //! @brief return the SFC shifts, dimension d is mapped to integer coordinates [0:2^(maxTreeLevel - s_d)]
+    HOST_DEVICE_FUN constexpr int sfcShiftX() const { return sfcShifts_[0]; }
+    HOST_DEVICE_FUN constexpr int sfcShiftY() const { return sfcShifts_[1]; }
+    HOST_DEVICE_FUN constexpr int sfcShiftZ() const { return sfcShifts_[2]; }
+
+    //! @brief return the edge lengths that correspond to the full integer range of the SFC
+    HOST_DEVICE_FUN constexpr T sfcLx() const { return lengths_[0] * T(1 << sfcShifts_[0]); }
+    HOST_DEVICE_FUN constexpr T sfcLy() const { return lengths_[1] * T(1 << sfcShifts_[1]); }
+    HOST_DEVICE_FUN constexpr T sfcLz() const { return lengths_[2] * T(1 << sfcShifts_[2]); }
+
+    //! @brief return inverse SFC edge lengths
+    HOST_DEVICE_FUN constexpr T sfcIlx() const { return inverseLengths_[0] / T(1 << sfcShifts_[0]); }
+    HOST_DEVICE_FUN constexpr T sfcIly() const { return inverseLengths_[1] / T(1 << sfcShifts_[1]); }
+    HOST_DEVICE_FUN constexpr T sfcIlz() const { return inverseLengths_[2] / T(1 << sfcShifts_[2]); }
+
     //! @brief return the shortest coordinate range in any dimension
     HOST_DEVICE_FUN constexpr T minExtent() const { return stl::min(stl::min(lengths_[0], lengths_[1]), lengths_[2]); }
 
@@ -170,24 +210,48 @@ public:
         ar->stepAttribute("box", limits, 6);
         ar->stepAttribute("boundaryType", (char*)boundaries, 3);
 
+        char tiled = tiled_;
+        try
+        {
+            ar->stepAttribute("tiled", &tiled, 1);
+        }
+        catch (std::out_of_range&) // files written before tiled SFC mapping keep the current setting
+        {
+        }
+
         *this = Box<T>(limits[0], limits[1], limits[2], limits[3], limits[4], limits[5], boundaries[0], boundaries[1],
-                       boundaries[2]);
+                       boundaries[2], bool(tiled));
     }
 
 private:
+    //! @brief number of doublings of the edge length of dimension @p d to reach the longest edge within sqrt(2)
+    HOST_DEVICE_FUN constexpr unsigned char sfcShift(int d) const
+    {
+        if (!tiled_) { return 0; }
+        T maxLength = stl::max(stl::max(lengths_[0], lengths_[1]), lengths_[2]);
+        int shift   = 0;
+        while (shift < maxSfcShift && lengths_[d] * T(2 << shift) <= maxLength * T(1.4142135623730951))
+        {
+            ++shift;
+        }
+        return shift;
+    }
+
     HOST_DEVICE_FUN
     friend constexpr bool operator==(const Box<T>& a, const Box<T>& b)
     {
         return a.limits[0] == b.limits[0] && a.limits[1] == b.limits[1] && a.limits[2] == b.limits[2] &&
                a.limits[3] == b.limits[3] && a.limits[4] == b.limits[4] && a.limits[5] == b.limits[5] &&
                a.boundaries[0] == b.boundaries[0] && a.boundaries[1] == b.boundaries[1] &&
-               a.boundaries[2] == b.boundaries[2];
+               a.boundaries[2] == b.boundaries[2] && a.tiled_ == b.tiled_;
     }
 
     T limits[6];
     T lengths_[3];
     T inverseLengths_[3];
     BoundaryType boundaries[3];
+    bool tiled_;
+    unsigned char sfcShifts_[3];
 };
 
 //! @brief Compute the shortest periodic distance dX = A - B between two points,
@@ -254,6 +318,23 @@ HOST_DEVICE_FUN inline void applyPBC(const cstone::Box<Tc>& box, T r, T& xx, T&
         zz += box.lz();
 }
 
+/*! @brief whether pairs within distance @p r of (x, y, z) may need periodic images
+ *
+ * Returns false if the sphere with radius @p r around (x, y, z) does not reach any periodic boundary of @p box.
+ * applyPBC(box, r, ...) then leaves all pair distances shorter than @p r unchanged and can be skipped.
+ */
+template<class Tc, class T>
+HOST_DEVICE_FUN inline bool needsPBC(const cstone::Box<Tc>& box, T r, Tc x, Tc y, Tc z)
+{
+    bool pbcX = (box.boundaryX() == BoundaryType::periodic);
+    bool pbcY = (box.boundaryY() == BoundaryType::periodic);
+    bool pbcZ = (box.boundaryZ() == BoundaryType::periodic);
+
+    return (pbcX && (x - box.xmin() < r || box.xmax() - x < r)) ||
+           (pbcY && (y - box.ymin() < r || box.ymax() - y < r)) ||
+           (pbcZ && (z - box.zmin() < r || box.zmax() - z < r));
+}
+
 template<class Tc, class T>
 HOST_DEVICE_FUN inline T distancePBC(const cstone::Box<Tc>& box, T hi, Tc x1, Tc y1, Tc z1, Tc x2, Tc y2, Tc z2)
 {
@@ -320,6 +401,18 @@ private:
 
 using IBox = SimpleBox<int>;
 
+/*! @brief integer coordinate range of each dimension
+ *
+ * Dimension d spans integer coordinates [0:2^(maxTreeLevel - s_d)], which is the periodic range of that dimension.
+ * For boxes without tiling, this is the full range [0:2^maxTreeLevel] in all dimensions.
+ */
+template<class KeyType, class T>
+HOST_DEVICE_FUN constexpr IBox sfcRange(const Box<T>& box)
+{
+    constexpr int maxCoord = 1u << maxTreeLevel<KeyType>{};
+    return {0, maxCoord >> box.sfcShiftX(), 0, maxCoord >> box.sfcShiftY(), 0, maxCoord >> box.sfcShiftZ()};
+}
+
 template<class T>
 using FBox = SimpleBox<T>;
 
@@ -338,9 +431,9 @@ constexpr HOST_DEVICE_FUN util::tuple<Vec3<T>, Vec3<T>> centerAndSize(const IBox
     // smallest octree cell edge length in unit cube
     constexpr T uL = T(1.) / maxCoord;
 
-    T halfUnitLengthX = T(0.5) * uL * box.lx();
-    T halfUnitLengthY = T(0.5) * uL * box.ly();
-    T halfUnitLengthZ = T(0.5) * uL * box.lz();
+    T halfUnitLengthX = T(0.5) * uL * box.sfcLx();
+    T halfUnitLengthY = T(0.5) * uL * box.sfcLy();
+    T halfUnitLengthZ = T(0.5) * uL * box.sfcLz();
     Vec3<T> boxCenter = {box.xmin() + (ibox.xmax() + ibox.xmin()) * halfUnitLengthX,
                          box.ymin() + (ibox.ymax() + ibox.ymin()) * halfUnitLengthY,
                          box.zmin() + (ibox.zmax() + ibox.zmin()) * halfUnitLengthZ};
@@ -386,14 +479,14 @@ HOST_DEVICE_FUN IBox createIBox(const Vec3<T> center, const Vec3<T>& size, const
     Vec3<T> Xmin = center - size;
     Vec3<T> Xmax = center + size;
 
-    // normalize to units of box lengths
-    T xnMin = (Xmin[0] - box.xmin()) * box.ilx();
-    T ynMin = (Xmin[1] - box.ymin()) * box.ily();
-    T znMin = (Xmin[2] - box.zmin()) * box.ilz();
+    // normalize to units of SFC box lengths
+    T xnMin = (Xmin[0] - box.xmin()) * box.sfcIlx();
+    T ynMin = (Xmin[1] - box.ymin()) * box.sfcIly();
+    T znMin = (Xmin[2] - box.zmin()) * box.sfcIlz();
 
-    T xnMax = (Xmax[0] - box.xmin()) * box.ilx();
-    T ynMax = (Xmax[1] - box.ymin()) * box.ily();
-    T znMax = (Xmax[2] - box.zmin()) * box.ilz();
+    T xnMax = (Xmax[0] - box.xmin()) * box.sfcIlx();
+    T ynMax = (Xmax[1] - box.ymin()) * box.sfcIly();
+    T znMax = (Xmax[2] - box.zmin()) * box.sfcIlz();
 
     int ixMin = std::floor(xnMin * maxCoord);
     int iyMin = std::floor(ynMin * maxCoord);
@@ -427,7 +520,8 @@ Box<T> limitBoxShrinking(const Box<T>& fittingBox, const Box<T>& previousBox, co
                   std::max(fittingBox.zmax(), limits[5]),
                   previousBox.boundaryX(),
                   previousBox.boundaryY(),
-                  previousBox.boundaryZ()};
+                  previousBox.boundaryZ(),
+                  previousBox.tiled()};
 }
 
 } // namespace cstone
@@ -154,18 +154,21 @@ HOST_DEVICE_FUN inline std::enable_if_t<IsHilbert<KeyType>{}, KeyType> iSfcKey(u
     return KeyType{iHilbert<typename KeyType::ValueType>(ix, iy, iz)};
 }
 
+/*! @brief compute the SFC key of a 3D point from its integer coordinates (x - min) * m, clamped to [0:maxI]
+ *
+ * Coordinates on the upper box boundary are thus mapped into the last cell of the integer range of each dimension.
+ */
 template<class KeyType, class T>
-HOST_DEVICE_FUN inline KeyType sfc3D(T x, T y, T z, T xmin, T ymin, T zmin, T mx, T my, T mz)
+HOST_DEVICE_FUN inline KeyType
+sfc3D(T x, T y, T z, T xmin, T ymin, T zmin, T mx, T my, T mz, int maxIx, int maxIy, int maxIz)
 {
-    constexpr int mcoord = (1u << maxTreeLevel<typename KeyType::ValueType>{}) - 1;
-
     int ix = std::floor(x * mx) - xmin * mx;
     int iy = std::floor(y * my) - ymin * my;
     int iz = std::floor(z * mz) - zmin * mz;
 
-    ix = stl::min(ix, mcoord);
-    iy = stl::min(iy, mcoord);
-    iz = stl::min(iz, mcoord);
+    ix = stl::min(ix, maxIx);
+    iy = stl::min(iy, maxIy);
+    iz = stl::min(iz, maxIz);
 
     assert(ix >= 0);
     assert(iy >= 0);
@@ -174,6 +177,13 @@ HOST_DEVICE_FUN inline KeyType sfc3D(T x, T y, T z, T xmin, T ymin, T zmin, T mx
     return iSfcKey<KeyType>(ix, iy, iz);
 }
 
+template<class KeyType, class T>
+HOST_DEVICE_FUN inline KeyType sfc3D(T x, T y, T z, T xmin, T ymin, T zmin, T mx, T my, T mz)
+{
+    constexpr int mcoord = (1u << maxTreeLevel<typename KeyType::ValueType>{}) - 1;
+    return sfc3D<KeyType>(x, y, z, xmin, ymin, zmin, mx, my, mz, mcoord, mcoord, mcoord);
+}
+
 /*! @brief Calculates a Hilbert key for a 3D point within the specified box
  *
  * @tparam    KeyType  32- or 64-bit Morton or Hilbert key type.
@@ -187,10 +197,11 @@ HOST_DEVICE_FUN inline KeyType sfc3D(T x, T y, T z, T xmin, T ymin, T zmin, T mx
 template<class KeyType, class T>
 HOST_DEVICE_FUN inline KeyType sfc3D(T x, T y, T z, const Box<T>& box)
 {
-    constexpr unsigned cubeLength = (1u << maxTreeLevel<typename KeyType::ValueType>{});
+    constexpr int cubeLength = (1u << maxTreeLevel<typename KeyType::ValueType>{});
 
-    return sfc3D<KeyType>(x, y, z, box.xmin(), box.ymin(), box.zmin(), cubeLength * box.ilx(), cubeLength * box.ily(),
-                          cubeLength * box.ilz());
+    return sfc3D<KeyType>(x, y, z, box.xmin(), box.ymin(), box.zmin(), cubeLength * box.sfcIlx(),
+                          cubeLength * box.sfcIly(), cubeLength * box.sfcIlz(), (cubeLength >> box.sfcShiftX()) - 1,
+                          (cubeLength >> box.sfcShiftY()) - 1, (cubeLength >> box.sfcShiftZ()) - 1);
 }
 
 //! @brief decode a Morton key
@@ -53,8 +53,7 @@ HOST_DEVICE_FUN constexpr bool overlapTwoRanges(T a, T b, T c, T d)
  * Some restrictions apply, no input value can be further than R
  * from the periodic range.
  */
-template<int R>
-HOST_DEVICE_FUN constexpr bool overlapRange(int a, int b, int c, int d)
+HOST_DEVICE_FUN constexpr bool overlapRange(int R, int a, int b, int c, int d)
 {
     assert(a >= -R);
     assert(a < R);
@@ -69,17 +68,49 @@ HOST_DEVICE_FUN constexpr bool overlapRange(int a, int b, int c, int d)
     return overlapTwoRanges(a, b, c, d) || overlapTwoRanges(a + R, b + R, c, d) || overlapTwoRanges(a, b, c + R, d + R);
 }
 
+//! @brief overlapRange with a compile-time periodic range
+template<int R>
+HOST_DEVICE_FUN constexpr bool overlapRange(int a, int b, int c, int d)
+{
+    return overlapRange(R, a, b, c, d);
+}
+
+/*! @brief check whether two boxes overlap. takes PBC into account, boxes can wrap around
+ *
+ * @param range  periodic range of each dimension, see sfcRange
+ */
+HOST_DEVICE_FUN inline bool overlap(const IBox& a, const IBox& b, const IBox& range)
+{
+    bool xOverlap = overlapRange(range.xmax(), a.xmin(), a.xmax(), b.xmin(), b.xmax());
+    bool yOverlap = overlapRange(range.ymax(), a.ymin(), a.ymax(), b.ymin(), b.ymax());
+    bool zOverlap = overlapRange(range.zmax(), a.zmin(), a.zmax(), b.zmin(), b.zmax());
+
+    return xOverlap && yOverlap && zOverlap;
+}
+
 //! @brief check whether two boxes overlap. takes PBC into account, boxes can wrap around
 template<class KeyType>
 HOST_DEVICE_FUN inline bool overlap(const IBox& a, const IBox& b)
 {
     constexpr int maxCoord = 1u << maxTreeLevel<KeyType>{};
+    return overlap(a, b, IBox(0, maxCoord));
+}
 
-    bool xOverlap = overlapRange<maxCoord>(a.xmin(), a.xmax(), b.xmin(), b.xmax());
-    bool yOverlap = overlapRange<maxCoord>(a.ymin(), a.ymax(), b.ymin(), b.ymax());
-    bool zOverlap = overlapRange<maxCoord>(a.zmin(), a.zmax(), b.zmin(), b.zmax());
-
-    return xOverlap && yOverlap && zOverlap;
+/*! @brief restrict an octree node box to the integer range of a tiled box
+ *
+ * @param      nodeBox  integer box of an octree node
+ * @param      range    integer range of each dimension, see sfcRange
+ * @param[out] inside   false if @p nodeBox lies outside of @p range and can therefore not contain any particles
+ * @return              the part of @p nodeBox inside @p range
+ *
+ * Octree nodes are aligned to powers of 2, as is the range, so nodes are either fully inside the range or span it
+ * starting from 0.
+ */
+HOST_DEVICE_FUN inline IBox clampToRange(const IBox& nodeBox, const IBox& range, bool& inside)
+{
+    inside = nodeBox.xmin() < range.xmax() && nodeBox.ymin() < range.ymax() && nodeBox.zmin() < range.zmax();
+    return {nodeBox.xmin(), stl::min(nodeBox.xmax(), range.xmax()), nodeBox.ymin(),
+            stl::min(nodeBox.ymax(), range.ymax()), nodeBox.zmin(), stl::min(nodeBox.zmax(), range.zmax())};
 }
 
 /*! @brief Check whether a coordinate box is fully contained in a Morton code range
@@ -88,20 +119,20 @@ HOST_DEVICE_FUN inline bool overlap(const IBox& a, const IBox& b)
  * @param codeStart  Morton code range start
  * @param codeEnd    Morton code range end
  * @param box        3D box with x,y,z integer coordinates in [0,2^maxTreeLevel<KeyType>{}-1]
+ * @param range      periodic integer range of each dimension, see sfcRange
  * @return           true if the box is fully contained within the specified Morton code range
  */
 template<class KeyType>
 HOST_DEVICE_FUN std::enable_if_t<std::is_unsigned_v<KeyType>, bool>
-containedIn(KeyType codeStart, KeyType codeEnd, const IBox& box)
+containedIn(KeyType codeStart, KeyType codeEnd, const IBox& box, const IBox& range)
 {
     // volume 0 boxes are not possible if makeHaloBox was used to generate it
     assert(box.xmin() < box.xmax());
     assert(box.ymin() < box.ymax());
     assert(box.zmin() < box.zmax());
 
-    constexpr int pbcRange = 1 << maxTreeLevel<KeyType>{};
-    if (stl::min(stl::min(box.xmin(), box.ymin()), box.zmin()) < 0 ||
-        stl::max(stl::max(box.xmax(), box.ymax()), box.zmax()) > pbcRange)
+    if (stl::min(stl::min(box.xmin(), box.ymin()), box.zmin()) < 0 || box.xmax() > range.xmax() ||
+        box.ymax() > range.ymax() || box.zmax() > range.zmax())
     {
         // any box that wraps around a PBC boundary cannot be contained within
         // any octree node, except the full root node
@@ -115,6 +146,15 @@ containedIn(KeyType codeStart, KeyType codeEnd, const IBox& box)
     return (util::get<0>(envelope) >= codeStart) && (util::get<1>(envelope) <= codeEnd);
 }
 
+//! @brief containedIn for boxes without tiling
+template<class KeyType>
+HOST_DEVICE_FUN std::enable_if_t<std::is_unsigned_v<KeyType>, bool>
+containedIn(KeyType codeStart, KeyType codeEnd, const IBox& box)
+{
+    constexpr int pbcRange = 1 << maxTreeLevel<KeyType>{};
+    return containedIn(codeStart, codeEnd, box, IBox(0, pbcRange));
+}
+
 /*! @brief determine whether a binary/octree node (prefix, prefixLength) is fully contained in an SFC range
  *
  * @tparam KeyType       32- or 64-bit unsigned integer
@@ -142,33 +182,40 @@ containedIn(KeyType prefixBitKey, KeyType codeStart, KeyType codeEnd)
     return !(firstPrefix < codeStart || secondPrefix > codeEnd);
 }
 
-template<class KeyType>
-HOST_DEVICE_FUN inline int addDelta(int value, int delta, bool pbc)
+//! @brief add @p delta to @p value, clamped to [0:range] unless @p pbc is true
+HOST_DEVICE_FUN inline int addDelta(int value, int delta, bool pbc, int range)
 {
-    constexpr int maxCoordinate = (1u << maxTreeLevel<KeyType>{});
-
     int temp = value + delta;
     if (pbc)
         return temp;
     else
-        return stl::min(stl::max(0, temp), maxCoordinate);
+        return stl::min(stl::max(0, temp), range);
+}
+
+template<class KeyType>
+HOST_DEVICE_FUN inline int addDelta(int value, int delta, bool pbc)
+{
+    constexpr int maxCoordinate = (1u << maxTreeLevel<KeyType>{});
+    return addDelta(value, delta, pbc, maxCoordinate);
 }
 
 //! @brief create a box with specified radius around node delineated by codeStart/End
 template<class KeyType, class CoordinateType, class RadiusType>
 HOST_DEVICE_FUN IBox makeHaloBox(const IBox& nodeBox, RadiusType radius, const Box<CoordinateType>& box)
 {
-    int dx = toNBitIntCeil<KeyType>(radius * box.ilx());
-    int dy = toNBitIntCeil<KeyType>(radius * box.ily());
-    int dz = toNBitIntCeil<KeyType>(radius * box.ilz());
+    int dx = toNBitIntCeil<KeyType>(radius * box.sfcIlx());
+    int dy = toNBitIntCeil<KeyType>(radius * box.sfcIly());
+    int dz = toNBitIntCeil<KeyType>(radius * box.sfcIlz());
 
     bool pbcX = (box.boundaryX() == cstone::BoundaryType::periodic);
     bool pbcY = (box.boundaryY() == cstone::BoundaryType::periodic);
     bool pbcZ = (box.boundaryZ() == cstone::BoundaryType::periodic);
 
-    return IBox(addDelta<KeyType>(nodeBox.xmin(), -dx, pbcX), addDelta<KeyType>(nodeBox.xmax(), dx, pbcX),
-                addDelta<KeyType>(nodeBox.ymin(), -dy, pbcY), addDelta<KeyType>(nodeBox.ymax(), dy, pbcY),
-                addDelta<KeyType>(nodeBox.zmin(), -dz, pbcZ), addDelta<KeyType>(nodeBox.zmax(), dz, pbcZ));
+    IBox range = sfcRange<KeyType>(box);
+
+    return IBox(addDelta(nodeBox.xmin(), -dx, pbcX, range.xmax()), addDelta(nodeBox.xmax(), dx, pbcX, range.xmax()),
+                addDelta(nodeBox.ymin(), -dy, pbcY, range.ymax()), addDelta(nodeBox.ymax(), dy, pbcY, range.ymax()),
+                addDelta(nodeBox.zmin(), -dz, pbcZ, range.zmax()), addDelta(nodeBox.zmax(), dz, pbcZ, range.zmax()));
 }
 
 //! @brief create a box with specified radius around node delineated by codeStart/End
@@ -36,21 +36,27 @@
 namespace cstone
 {
 
+/*! @brief find all octree nodes that overlap with @p target, excluding nodes in [excludeStart:excludeEnd]
+ *
+ * @param range  periodic integer range of each dimension, see sfcRange. Parts of nodes outside the range are ignored.
+ */
 template<class KeyType, class F>
 HOST_DEVICE_FUN void findCollisions(const KeyType* nodePrefixes,
                                     const TreeNodeIndex* childOffsets,
                                     F&& endpointAction,
                                     const IBox& target,
                                     KeyType excludeStart,
-                                    KeyType excludeEnd)
+                                    KeyType excludeEnd,
+                                    const IBox& range = IBox(0, 1 << maxTreeLevel<KeyType>{}))
 {
-    auto overlaps = [excludeStart, excludeEnd, nodePrefixes, &target](TreeNodeIndex idx)
+    auto overlaps = [excludeStart, excludeEnd, nodePrefixes, &target, &range](TreeNodeIndex idx)
     {
         KeyType nodeKey = decodePlaceholderBit(nodePrefixes[idx]);
         int level       = decodePrefixLength(nodePrefixes[idx]) / 3;
-        IBox sourceBox  = sfcIBox(sfcKey(nodeKey), level);
-        return !containedIn(nodeKey, nodeKey + nodeRange<KeyType>(level), excludeStart, excludeEnd) &&
-               overlap<KeyType>(sourceBox, target);
+        bool inside;
+        IBox sourceBox = clampToRange(sfcIBox(sfcKey(nodeKey), level), range, inside);
+        return inside && !containedIn(nodeKey, nodeKey + nodeRange<KeyType>(level), excludeStart, excludeEnd) &&
+               overlap(sourceBox, target, range);
     };
 
     singleTraversal(childOffsets, overlaps, endpointAction);
@@ -88,19 +94,25 @@ void findHalos(const KeyType* prefixes,
 {
     KeyType lowestCode  = leaves[firstNode];
     KeyType highestCode = leaves[lastNode];
+    IBox range          = sfcRange<KeyType>(box);
 
     auto markCollisions = [collisionFlags, internalToLeaf](TreeNodeIndex i) { collisionFlags[internalToLeaf[i]] = 1; };
 
 #pragma omp parallel for
     for (TreeNodeIndex nodeIdx = firstNode; nodeIdx < lastNode; ++nodeIdx)
     {
+        bool inside;
+        IBox nodeBox = clampToRange(sfcIBox(sfcKey(leaves[nodeIdx]), sfcKey(leaves[nodeIdx + 1])), range, inside);
+        // leaves outside the integer range of a tiled box are empty
+        if (!inside) { continue; }
+
         RadiusType radius = interactionRadii[nodeIdx];
-        IBox haloBox      = makeHaloBox<KeyType>(leaves[nodeIdx], leaves[nodeIdx + 1], radius, box);
+        IBox haloBox      = makeHaloBox<KeyType>(nodeBox, radius, box);
 
         // if the halo box is fully inside the assigned SFC range, we skip collision detection
-        if (containedIn(lowestCode, highestCode, haloBox)) { continue; }
+        if (containedIn(lowestCode, highestCode, haloBox, range)) { continue; }
 
-        findCollisions(prefixes, childOffsets, markCollisions, haloBox, lowestCode, highestCode);
+        findCollisions(prefixes, childOffsets, markCollisions, haloBox, lowestCode, highestCode, range);
     }
 }
 
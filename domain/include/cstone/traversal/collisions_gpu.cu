@@ -53,16 +53,22 @@ __global__ void findHalosKernel(const KeyType* nodePrefixes,
 
     if (leafIdx < lastNode)
     {
+        IBox range = sfcRange<KeyType>(box);
+        bool inside;
+        IBox nodeBox = clampToRange(sfcIBox(sfcKey(leaves[leafIdx]), sfcKey(leaves[leafIdx + 1])), range, inside);
+        // leaves outside the integer range of a tiled box are empty
+        if (!inside) { return; }
+
         RadiusType radius  = interactionRadii[leafIdx];
-        IBox haloBox       = makeHaloBox(leaves[leafIdx], leaves[leafIdx + 1], radius, box);
+        IBox haloBox       = makeHaloBox<KeyType>(nodeBox, radius, box);
         KeyType lowestKey  = leaves[firstNode];
         KeyType highestKey = leaves[lastNode];
 
         // if the halo box is fully inside the assigned SFC range, we skip collision detection
-        if (containedIn(lowestKey, highestKey, haloBox)) { return; }
+        if (containedIn(lowestKey, highestKey, haloBox, range)) { return; }
 
         // mark all colliding node indices outside [lowestKey:highestKey]
-        findCollisions(nodePrefixes, childOffsets, markCollisions, haloBox, lowestKey, highestKey);
+        findCollisions(nodePrefixes, childOffsets, markCollisions, haloBox, lowestKey, highestKey, range);
     }
 }
 
@@ -134,7 +140,7 @@ __global__ void markMacsGpuKernel(const KeyType* prefixes,
     IBox target    = sfcIBox(sfcKey(focusNodes[tid]), sfcKey(focusNodes[tid + 1]));
     IBox targetExt = IBox(target.xmin() - 1, target.xmax() + 1, target.ymin() - 1, target.ymax() + 1, target.zmin() - 1,
                           target.zmax() + 1);
-    if (containedIn(focusStart, focusEnd, targetExt)) { return; }
+    if (containedIn(focusStart, focusEnd, targetExt, sfcRange<KeyType>(box))) { return; }
 
     auto [targetCenter, targetSize] = centerAndSize<KeyType>(target, box);
     unsigned maxLevel               = maxTreeLevel<KeyType>{};
@@ -213,7 +213,7 @@ __global__ void groupSplitsKernel(LocalIndex first,
     util::array<Vec4<Tc>, nwt> pos_i;
     for (int k = 0; k < nwt; k++)
     {
-        pos_i[k] = {x[bodyIdx[k]] * box.ilx(), y[bodyIdx[k]] * box.ily(), z[bodyIdx[k]] * box.ilz(),
+        pos_i[k] = {x[bodyIdx[k]] * box.sfcIlx(), y[bodyIdx[k]] * box.sfcIly(), z[bodyIdx[k]] * box.sfcIlz(),
                     h ? Tc(2) * h[bodyIdx[k]] : Tc(0)};
     }
 
@@ -258,7 +258,7 @@ void markMacs(const KeyType* prefixes,
         IBox target    = sfcIBox(sfcKey(focusNodes[i]), sfcKey(focusNodes[i + 1]));
         IBox targetExt = IBox(target.xmin() - 1, target.xmax() + 1, target.ymin() - 1, target.ymax() + 1,
                               target.zmin() - 1, target.zmax() + 1);
-        if (containedIn(focusStart, focusEnd, targetExt)) { continue; }
+        if (containedIn(focusStart, focusEnd, targetExt, sfcRange<KeyType>(box))) { continue; }
 
         auto [targetCenter, targetSize] = centerAndSize<KeyType>(target, box);
         unsigned maxLevel               = maxTreeLevel<KeyType>{};
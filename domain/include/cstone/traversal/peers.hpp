@@ -31,8 +31,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include "cstone/traversal/macs.hpp"
 #include "cstone/domain/domaindecomp.hpp"
+#include "cstone/util/array.hpp"
 
 namespace cstone
 {
@@ -59,32 +64,94 @@ namespace cstone
  * Except for @p myRank, this function acts on data that is identical on all MPI ranks and
  * doesn't need to do any communication.
  */
-template<class T, template<class> class TreeType, class KeyType>
-std::vector<int> findPeersMac(int myRank,
-                              const SfcAssignment<KeyType>& assignment,
-                              const TreeType<KeyType>& domainTree,
-                              const Box<T>& box,
-                              float invThetaEff)
+//! @brief true if the octree nodes with start keys @p a, @p b and levels @p levelA, @p levelB fail the mutual MAC
+template<class KeyType, class T>
+bool nodePairFailsMac(KeyType a, unsigned levelA, KeyType b, unsigned levelB, const Box<T>& box, float invThetaEff)
 {
-    KeyType domainStart = assignment[myRank];
-    KeyType domainEnd   = assignment[myRank + 1];
+    IBox aBox             = sfcIBox(sfcKey(a), levelA);
+    IBox bBox             = sfcIBox(sfcKey(b), levelB);
+    auto [aCenter, aSize] = centerAndSize<KeyType>(aBox, box);
+    auto [bCenter, bSize] = centerAndSize<KeyType>(bBox, box);
+    return !minVecMacMutual(aCenter, aSize, bCenter, bSize, box, invThetaEff);
+}
 
-    auto crossFocusPairs =
-        [domainStart, domainEnd, invThetaEff, &tree = domainTree, &box](TreeNodeIndex a, TreeNodeIndex b)
+/*! @brief returns a MAC for dual traversal that accepts pairs (a, b) with a overlapping the focus and b outside
+ *
+ * @param domainStart   start of the focus SFC range
+ * @param domainEnd     end of the focus SFC range
+ * @param tree          octree built on top of the global cornerstone leaves
+ * @param box           global coordinate bounding box
+ * @param invThetaEff   1/theta + s, effective inverse opening parameter
+ * @return              callable that returns true for node pairs that fail the MAC and cross the focus boundary
+ */
+template<class KeyType, template<class> class TreeType, class T>
+auto crossFocusMac(KeyType domainStart, KeyType domainEnd, const TreeType<KeyType>& tree, const Box<T>& box,
+                   float invThetaEff)
+{
+    return [domainStart, domainEnd, invThetaEff, &tree, &box](TreeNodeIndex a, TreeNodeIndex b)
     {
         bool aFocusOverlap = overlapTwoRanges(domainStart, domainEnd, tree.codeStart(a), tree.codeEnd(a));
         bool bInFocus      = containedIn(tree.codeStart(b), tree.codeEnd(b), domainStart, domainEnd);
         // node a has to overlap/be contained in the focus, while b must not be inside it
         if (!aFocusOverlap || bInFocus) { return false; }
 
-        IBox aBox             = sfcIBox(sfcKey(tree.codeStart(a)), tree.level(a));
-        IBox bBox             = sfcIBox(sfcKey(tree.codeStart(b)), tree.level(b));
-        auto [aCenter, aSize] = centerAndSize<KeyType>(aBox, box);
-        auto [bCenter, bSize] = centerAndSize<KeyType>(bBox, box);
-        return !minVecMacMutual(aCenter, aSize, bCenter, bSize, box, invThetaEff);
+        return nodePairFailsMac(tree.codeStart(a), tree.level(a), tree.codeStart(b), tree.level(b), box, invThetaEff);
     };
+}
 
-    auto m2l = [](TreeNodeIndex, TreeNodeIndex) {};
+//! @brief indices of the nodes in @p tree that exactly span the SFC range [domainStart:domainEnd]
+template<class KeyType, template<class> class TreeType>
+std::vector<TreeNodeIndex> spanningNodes(KeyType domainStart, KeyType domainEnd, const TreeType<KeyType>& tree)
+{
+    std::vector<KeyType> spanningNodeKeys(spanSfcRange(domainStart, domainEnd) + 1);
+    spanSfcRange(domainStart, domainEnd, spanningNodeKeys.data());
+    spanningNodeKeys.back() = domainEnd;
+
+    const KeyType* nodeKeys         = tree.nodeKeys().data();
+    const TreeNodeIndex* levelRange = tree.levelRange().data();
+
+    std::vector<TreeNodeIndex> ret(spanningNodeKeys.size() - 1);
+    for (std::size_t i = 0; i < ret.size(); ++i)
+    {
+        ret[i] = locateNode(spanningNodeKeys[i], spanningNodeKeys[i + 1], nodeKeys, levelRange);
+    }
+    return ret;
+}
+
+/*! @brief find peer ranks based on a multipole acceptance criterion and dual tree traversal
+ *
+ * @tparam T            float or double
+ * @tparam KeyType      32- or 64-bit unsigned integer
+ * @param myRank        find peers for the globally assigned SFC segment with index myRank
+ * @param assignment    Decomposition of the global SFC into segments
+ * @param domainTree    octree built on top of the global cornerstone leaves
+ * @param box           global coordinate bounding box
+ * @param invThetaEff   1/theta + s, effective inverse opening parameter
+ * @return              list of segment indices (i.e. "ranks") that contain tree leaf nodes
+ *                      that fail the MAC paired with at least one tree leaf node inside
+ *                      the @p myRank segment. This list contains at least the segments
+ *                      at the surface of the @p myRank segment and possibly additional
+ *                      segments for low opening angles and/or low global resolution in
+ *                      @p domainTree.
+ *
+ * Note: This function guarantees mutuality, if rank A identifies B as peer, then also
+ *       rank B will have A as peer
+ *
+ * Except for @p myRank, this function acts on data that is identical on all MPI ranks and
+ * doesn't need to do any communication.
+ */
+template<class T, template<class> class TreeType, class KeyType>
+std::vector<int> findPeersMac(int myRank,
+                              const SfcAssignment<KeyType>& assignment,
+                              const TreeType<KeyType>& domainTree,
+                              const Box<T>& box,
+                              float invThetaEff)
+{
+    KeyType domainStart = assignment[myRank];
+    KeyType domainEnd   = assignment[myRank + 1];
+
+    auto crossFocusPairs = crossFocusMac(domainStart, domainEnd, domainTree, box, invThetaEff);
+    auto m2l             = [](TreeNodeIndex, TreeNodeIndex) {};
 
     std::vector<int> peerRanks(assignment.numRanks(), 0);
     auto p2p = [&domainTree, &assignment, &peerRanks](TreeNodeIndex /*a*/, TreeNodeIndex b)
@@ -93,18 +160,12 @@ std::vector<int> findPeersMac(int myRank,
         if (peerRanks[peerRank] == 0) { peerRanks[peerRank] = 1; }
     };
 
-    std::vector<KeyType> spanningNodeKeys(spanSfcRange(domainStart, domainEnd) + 1);
-    spanSfcRange(domainStart, domainEnd, spanningNodeKeys.data());
-    spanningNodeKeys.back() = domainEnd;
-
-    const KeyType* nodeKeys         = domainTree.nodeKeys().data();
-    const TreeNodeIndex* levelRange = domainTree.levelRange().data();
+    auto focusNodes = spanningNodes(domainStart, domainEnd, domainTree);
 
 #pragma omp parallel for schedule(dynamic)
-    for (std::size_t i = 0; i < spanningNodeKeys.size() - 1; ++i)
+    for (std::size_t i = 0; i < focusNodes.size(); ++i)
     {
-        TreeNodeIndex nodeIdx = locateNode(spanningNodeKeys[i], spanningNodeKeys[i + 1], nodeKeys, levelRange);
-        dualTraversal(domainTree, nodeIdx, 0, crossFocusPairs, m2l, p2p);
+        dualTraversal(domainTree, focusNodes[i], 0, crossFocusPairs, m2l, p2p);
     }
 
     std::vector<int> ret;
@@ -116,6 +177,272 @@ std::vector<int> findPeersMac(int myRank,
     return ret;
 }
 
+/*! @brief determine the SFC ranges in which the leaves of two cornerstone octrees differ
+ *
+ * @param[in]  oldLeaves         cornerstone leaf keys
+ * @param[in]  newLeaves         cornerstone leaf keys
+ * @return                       sorted list of disjoint SFC ranges, outside of which both trees have identical leaves
+ */
+template<class KeyType>
+std::vector<util::array<KeyType, 2>> changedLeafRanges(gsl::span<const KeyType> oldLeaves,
+                                                       gsl::span<const KeyType> newLeaves)
+{
+    assert(oldLeaves.front() == newLeaves.front() && oldLeaves.back() == newLeaves.back());
+
+    std::vector<util::array<KeyType, 2>> ret;
+    std::size_t i = 0, j = 0;
+    while (i + 1 < oldLeaves.size() && j + 1 < newLeaves.size())
+    {
+        // invariant: oldLeaves[i] == newLeaves[j]
+        if (oldLeaves[i + 1] == newLeaves[j + 1])
+        {
+            ++i, ++j;
+            continue;
+        }
+
+        KeyType rangeStart = oldLeaves[i];
+        while (oldLeaves[i + 1] != newLeaves[j + 1])
+        {
+            if (oldLeaves[i + 1] < newLeaves[j + 1]) { ++i; }
+            else { ++j; }
+        }
+        ret.push_back({rangeStart, oldLeaves[++i]});
+        ++j;
+    }
+
+    return ret;
+}
+
+/*! @brief Peer rank discovery that reuses the cross-focus leaf pairs found in the previous call
+ *
+ * findPeersMac is determined by the set of leaf pairs (a, b) that fail the MAC, with a inside and b outside the
+ * focus. Since the MAC is monotonic with respect to node containment, every ancestor pair of a failing leaf pair
+ * fails as well. A pair of leaves that exist in both the previous and the current global tree and did not move
+ * in or out of the focus therefore yields the same result in both calls. Only pairs that involve a changed SFC range
+ * have to be re-examined, which is done with a dual traversal restricted to node pairs that overlap a changed range.
+ *
+ * The cached pairs are candidates that fail the MAC with an opening parameter relaxed by a factor of 1 + boxSlack in
+ * a reference box. All distances and node sizes scale with the edge lengths of the box, so as long as the current box
+ * only differs from the reference box by a translation and a rescaling of the edge lengths that stays within the
+ * slack, the pairs that fail the exact MAC in the current box are a subset of the candidates. The peers are then
+ * obtained by evaluating the exact MAC on the candidates only. This keeps incremental discovery effective for open
+ * boundaries, where the box adapts to the particles on every step.
+ *
+ * Changes to the boundaries of other ranks only affect the mapping of leaves to ranks and don't require
+ * any traversal. A different opening parameter or boundary type, a box rescaling beyond the slack, as well as changes
+ * to more than a fraction of the global tree leaves, trigger a full traversal that resets the reference box.
+ */
+template<class KeyType, class T>
+class PeerFinder
+{
+public:
+    /*! @param rebuildFraction  fall back to a full traversal if more than this fraction of the leaves changed
+     *  @param boxSlack         relaxation of the opening parameter for cached candidate pairs
+     */
+    explicit PeerFinder(float rebuildFraction = 0.1f, float boxSlack = 0.05f)
+        : rebuildFraction_(rebuildFraction)
+        , boxSlack_(boxSlack)
+    {
+    }
+
+    //! @brief Args and return value identical to findPeersMac
+    template<template<class> class TreeType>
+    std::vector<int> find(int myRank,
+                          const SfcAssignment<KeyType>& assignment,
+                          const TreeType<KeyType>& domainTree,
+                          const Box<T>& box,
+                          float invThetaEff)
+    {
+        KeyType domainStart = assignment[myRank];
+        KeyType domainEnd   = assignment[myRank + 1];
+        auto leaves         = domainTree.treeLeaves();
+
+        bool incremental = !leaves_.empty() && invThetaEff == invThetaEff_ && isRescaledWithinSlack(box);
+        if (incremental)
+        {
+            changes_ = changedLeafRanges<KeyType>(leaves_, leaves);
+            addChange(std::min(domainStart, focusStart_), std::max(domainStart, focusStart_));
+            addChange(std::min(domainEnd, focusEnd_), std::max(domainEnd, focusEnd_));
+            mergeChanges();
+            incremental = numLeavesIn(leaves, changes_) <= rebuildFraction_ * nNodes(leaves);
+        }
+        if (!incremental) { refBox_ = box; }
+
+        float relaxedInvTheta = invThetaEff * (1.0f + boxSlack_);
+        auto candidatePairs   = crossFocusMac(domainStart, domainEnd, domainTree, refBox_, relaxedInvTheta);
+        if (incremental)
+        {
+            auto touchesChanges = [this](KeyType key) { return overlapsChanges(key, key + 1); };
+            pairs_.erase(std::remove_if(pairs_.begin(), pairs_.end(),
+                                        [touchesChanges](const LeafPair& p)
+                                        { return touchesChanges(p.a) || touchesChanges(p.b); }),
+                         pairs_.end());
+
+            auto changedPairs = [this, &candidatePairs, &tree = domainTree](TreeNodeIndex a, TreeNodeIndex b)
+            {
+                bool overlap = overlapsChanges(tree.codeStart(a), tree.codeEnd(a)) ||
+                               overlapsChanges(tree.codeStart(b), tree.codeEnd(b));
+                return overlap && candidatePairs(a, b);
+            };
+            collectPairs(domainStart, domainEnd, domainTree, changedPairs);
+        }
+        else
+        {
+            pairs_.clear();
+            collectPairs(domainStart, domainEnd, domainTree, candidatePairs);
+        }
+
+        leaves_.assign(leaves.begin(), leaves.end());
+        invThetaEff_         = invThetaEff;
+        focusStart_          = domainStart;
+        focusEnd_            = domainEnd;
+        lastCallIncremental_ = incremental;
+
+        std::vector<int> peerRanks(assignment.numRanks(), 0);
+#pragma omp parallel for schedule(static)
+        for (std::size_t i = 0; i < pairs_.size(); ++i)
+        {
+            const LeafPair& p = pairs_[i];
+            if (!nodePairFailsMac(p.a, p.levelA, p.b, p.levelB, box, invThetaEff)) { continue; }
+
+            int peerRank = assignment.findRank(p.b);
+            if (peerRanks[peerRank] == 0) { peerRanks[peerRank] = 1; }
+        }
+
+        std::vector<int> ret;
+        for (int i = 0; i < int(peerRanks.size()); ++i)
+        {
+            if (peerRanks[i]) { ret.push_back(i); }
+        }
+        return ret;
+    }
+
+    //! @brief number of cached candidate leaf pairs that cross the focus boundary
+    std::size_t numPairs() const { return pairs_.size(); }
+
+    //! @brief true if the last call to find reused pairs from the previous call
+    bool lastCallIncremental() const { return lastCallIncremental_; }
+
+private:
+    //! @brief a leaf a inside and a leaf b outside the focus, identified by start keys and levels
+    struct LeafPair
+    {
+        KeyType a, b;
+        unsigned levelA, levelB;
+    };
+
+    //! @brief append all leaf pairs that pass @p mac to pairs_
+    template<template<class> class TreeType, class MAC>
+    void collectPairs(KeyType domainStart, KeyType domainEnd, const TreeType<KeyType>& domainTree, MAC&& mac)
+    {
+        auto focusNodes = spanningNodes(domainStart, domainEnd, domainTree);
+        auto m2l        = [](TreeNodeIndex, TreeNodeIndex) {};
+
+#pragma omp parallel
+        {
+            std::vector<LeafPair> threadPairs;
+            auto p2p = [&threadPairs, &domainTree](TreeNodeIndex a, TreeNodeIndex b)
+            {
+                threadPairs.push_back({domainTree.codeStart(a), domainTree.codeStart(b), unsigned(domainTree.level(a)),
+                                       unsigned(domainTree.level(b))});
+            };
+
+#pragma omp for schedule(dynamic)
+            for (std::size_t i = 0; i < focusNodes.size(); ++i)
+            {
+                dualTraversal(domainTree, focusNodes[i], 0, mac, m2l, p2p);
+            }
+
+#pragma omp critical
+            pairs_.insert(pairs_.end(), threadPairs.begin(), threadPairs.end());
+        }
+    }
+
+    /*! @brief true if @p box equals the reference box up to a translation and a rescaling of the edge lengths
+     *
+     * Edge lengths that change by factors within [1 - eps, 1 + eps] change the ratio of node sizes to distances by at
+     * most (1 + eps) / (1 - eps), which has to be covered by the relaxed opening parameter of the candidate pairs.
+     */
+    bool isRescaledWithinSlack(const Box<T>& box) const
+    {
+        if (box.boundaryX() != refBox_.boundaryX() || box.boundaryY() != refBox_.boundaryY() ||
+            box.boundaryZ() != refBox_.boundaryZ())
+        {
+            return false;
+        }
+        // tiling changes the mapping from coordinates to keys
+        if (box.tiled() != refBox_.tiled() || box.sfcShiftX() != refBox_.sfcShiftX() ||
+            box.sfcShiftY() != refBox_.sfcShiftY() || box.sfcShiftZ() != refBox_.sfcShiftZ())
+        {
+            return false;
+        }
+
+        double eps = std::max({std::abs(double(box.lx()) / refBox_.lx() - 1.0),
+                               std::abs(double(box.ly()) / refBox_.ly() - 1.0),
+                               std::abs(double(box.lz()) / refBox_.lz() - 1.0)});
+        // small safety margin for round-off in the MAC evaluation
+        return eps < 0.5 && (1.0 + eps) / (1.0 - eps) < 1.0 + 0.99 * boxSlack_;
+    }
+
+    void addChange(KeyType start, KeyType end)
+    {
+        if (start < end) { changes_.push_back({start, end}); }
+    }
+
+    //! @brief sort changed ranges and merge overlapping ones
+    void mergeChanges()
+    {
+        std::sort(changes_.begin(), changes_.end(), [](const auto& a, const auto& b) { return a[0] < b[0]; });
+
+        std::size_t numMerged = 0;
+        for (std::size_t i = 0; i < changes_.size(); ++i)
+        {
+            if (numMerged > 0 && changes_[i][0] <= changes_[numMerged - 1][1])
+            {
+                changes_[numMerged - 1][1] = std::max(changes_[numMerged - 1][1], changes_[i][1]);
+            }
+            else { changes_[numMerged++] = changes_[i]; }
+        }
+        changes_.resize(numMerged);
+    }
+
+    //! @brief true if [start:end] overlaps with any of the changed ranges
+    bool overlapsChanges(KeyType start, KeyType end) const
+    {
+        auto it = std::upper_bound(changes_.begin(), changes_.end(), start,
+                                   [](KeyType key, const auto& range) { return key < range[1]; });
+        return it != changes_.end() && (*it)[0] < end;
+    }
+
+    static std::size_t numLeavesIn(gsl::span<const KeyType> leaves, const std::vector<util::array<KeyType, 2>>& ranges)
+    {
+        std::size_t ret = 0;
+        for (const auto& r : ranges)
+        {
+            ret += std::lower_bound(leaves.begin(), leaves.end(), r[1]) -
+                   std::lower_bound(leaves.begin(), leaves.end(), r[0]);
+        }
+        return ret;
+    }
+
+    float rebuildFraction_;
+    float boxSlack_;
+
+    //! @brief state of the previous call
+    std::vector<KeyType> leaves_;
+    //! @brief the box of the last full traversal, in which the candidate pairs are evaluated
+    Box<T> refBox_{0, 1};
+    float invThetaEff_{0};
+    KeyType focusStart_{0};
+    KeyType focusEnd_{0};
+    bool lastCallIncremental_{false};
+
+    //! @brief leaf pairs (a, b) with a inside and b outside the focus that fail the relaxed MAC in refBox_
+    std::vector<LeafPair> pairs_;
+    //! @brief SFC ranges that changed since the previous call
+    std::vector<util::array<KeyType, 2>> changes_;
+};
+
 //! @brief Args identical to findPeersMac, but implemented with single tree traversal for comparison
 template<class KeyType, class T>
 std::vector<int> findPeersMacStt(int myRank,
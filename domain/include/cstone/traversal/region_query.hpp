@@ -0,0 +1,156 @@
+/*
+ * Cornerstone octree
+ *
+ * Copyright (c) 2024 CSCS, ETH Zurich, University of Zurich, 2021 University of Basel
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: MIT License
+ */
+
+/*! @file
+ * @brief Find the octree leaves and particles inside a spatial region
+ *
+ * Regions are described by their center and a test on the per-dimension distance to the center, which is the
+ * absolute value of the minimum image distance for particles and the minimum distance to the cell box for octree
+ * cells. Cells whose minimum distance fails the test cannot contain any particle of the region and are skipped in
+ * the traversal, such that the cost of a query scales with the size of the region and not with the number of
+ * particles. Periodic boundaries are taken into account in all dimensions in which the box is periodic.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "cstone/domain/index_ranges.hpp"
+#include "cstone/sfc/box.hpp"
+#include "cstone/traversal/traversal.hpp"
+#include "cstone/tree/octree.hpp"
+
+namespace cstone
+{
+
+//! @brief ball with given center and radius
+template<class T>
+struct SphereRegion
+{
+    Vec3<T> center;
+    T       radius;
+
+    //! @brief whether a point at per-dimension distance @p dX from the center is inside
+    HOST_DEVICE_FUN bool accept(const Vec3<T>& dX) const { return norm2(dX) <= radius * radius; }
+};
+
+//! @brief axis-aligned cuboid with given center and half of the edge lengths
+template<class T>
+struct BoxRegion
+{
+    Vec3<T> center;
+    Vec3<T> halfSize;
+
+    HOST_DEVICE_FUN bool accept(const Vec3<T>& dX) const
+    {
+        return dX[0] <= halfSize[0] && dX[1] <= halfSize[1] && dX[2] <= halfSize[2];
+    }
+};
+
+//! @brief cylinder with given center, radius and half length along the coordinate axis @p axis
+template<class T>
+struct CylinderRegion
+{
+    Vec3<T> center;
+    T       radius;
+    T       halfLength;
+    //! @brief 0, 1 or 2 for a cylinder along x, y or z
+    int axis;
+
+    HOST_DEVICE_FUN bool accept(const Vec3<T>& dX) const
+    {
+        T axial  = dX[axis];
+        T radial = norm2(dX) - axial * axial;
+        return axial <= halfLength && radial <= radius * radius;
+    }
+};
+
+//! @brief whether the particle at @p X is inside @p region
+template<class Region, class T>
+HOST_DEVICE_FUN bool insideRegion(const Region& region, const Vec3<T>& X, const Box<T>& box)
+{
+    return region.accept(abs(applyPbc(X - region.center, box)));
+}
+
+//! @brief whether the cell with @p nodeCenter and @p nodeSize may contain particles inside @p region
+template<class Region, class T>
+HOST_DEVICE_FUN bool overlapsRegion(const Region& region, const Vec3<T>& nodeCenter, const Vec3<T>& nodeSize,
+                                    const Box<T>& box)
+{
+    return region.accept(minDistance(region.center, nodeCenter, nodeSize, box));
+}
+
+/*! @brief call @p leafAction with the index of each leaf of @p tree that overlaps @p region
+ *
+ * @param[in] tree        octree with geometrical centers and sizes of all nodes, e.g. Domain::octreeProperties()
+ * @param[in] region      SphereRegion, BoxRegion or CylinderRegion
+ * @param[in] box         global coordinate bounding box
+ * @param[in] leafAction  called once for each overlapping leaf with its index in [0:tree.numLeafNodes], in no
+ *                        particular order
+ */
+template<class T, class KeyType, class Region, class F>
+void findRegionLeaves(const OctreeNsView<T, KeyType>& tree, const Region& region, const Box<T>& box, F&& leafAction)
+{
+    auto overlaps = [&tree, &region, &box](TreeNodeIndex i)
+    { return overlapsRegion(region, tree.centers[i], tree.sizes[i], box); };
+    auto endpoint = [&tree, &leafAction](TreeNodeIndex i) { leafAction(tree.internalToLeaf[i]); };
+
+    singleTraversal(tree.childOffsets, overlaps, endpoint);
+}
+
+/*! @brief ranges of particle indices in [first:last] of the leaves that overlap @p region
+ *
+ * @return  disjoint, sorted index ranges, adjacent ranges are merged. The ranges contain all particles in
+ *          [first:last] inside the region, but may contain particles outside of it.
+ *
+ * Restricting [first:last] to the locally assigned particles, e.g. Domain::startIndex(), Domain::endIndex(),
+ * excludes halos, such that each particle is found on exactly one rank.
+ */
+template<class T, class KeyType, class Region>
+std::vector<IndexPair<LocalIndex>> regionParticleRanges(const OctreeNsView<T, KeyType>& tree, const Region& region,
+                                                        const Box<T>& box, LocalIndex first, LocalIndex last)
+{
+    std::vector<IndexPair<LocalIndex>> ranges;
+    findRegionLeaves(tree, region, box,
+                     [&ranges, &tree, first, last](TreeNodeIndex leafIdx)
+                     {
+                         LocalIndex rangeStart = std::max(tree.layout[leafIdx], first);
+                         LocalIndex rangeEnd   = std::min(tree.layout[leafIdx + 1], last);
+                         if (rangeStart < rangeEnd) { ranges.emplace_back(rangeStart, rangeEnd); }
+                     });
+
+    std::sort(ranges.begin(), ranges.end());
+    std::vector<IndexPair<LocalIndex>> merged;
+    for (const auto& r : ranges)
+    {
+        if (!merged.empty() && merged.back().end() == r.start()) { merged.back() = {merged.back().start(), r.end()}; }
+        else { merged.push_back(r); }
+    }
+    return merged;
+}
+
+/*! @brief call @p particleAction with the index of each particle in [first:last] inside @p region
+ *
+ * Particles are visited in increasing index order.
+ */
+template<class T, class KeyType, class Tc, class Region, class F>
+void forEachInRegion(const OctreeNsView<T, KeyType>& tree, const Region& region, const Box<T>& box, LocalIndex first,
+                     LocalIndex last, const Tc* x, const Tc* y, const Tc* z, F&& particleAction)
+{
+    for (const auto& range : regionParticleRanges(tree, region, box, first, last))
+    {
+        for (LocalIndex i = range.start(); i < range.end(); ++i)
+        {
+            if (insideRegion(region, Vec3<T>{T(x[i]), T(y[i]), T(z[i])}, box)) { particleAction(i); }
+        }
+    }
+}
+
+} // namespace cstone
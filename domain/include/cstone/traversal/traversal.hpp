@@ -65,6 +65,14 @@ namespace cstone
 //     return;
 // }
 
+//! @brief hint the CPU to load the cache line containing @p ptr, no-op in device code
+HOST_DEVICE_FUN inline void prefetchRead(const void* ptr)
+{
+#if !defined(__CUDA_ARCH__) && !defined(__HIP_DEVICE_COMPILE__) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_prefetch(ptr, 0, 3);
+#endif
+}
+
 template<class C, class A>
 HOST_DEVICE_FUN void singleTraversal(const TreeNodeIndex* childOffsets, C&& continuationCriterion, A&& endpointAction)
 {
@@ -101,6 +109,8 @@ HOST_DEVICE_FUN void singleTraversal(const TreeNodeIndex* childOffsets, C&& cont
                 {
                     assert(stackPos < 128);
                     stack[stackPos++] = child; // push
+                    // the child offsets of the grand children are needed when child is popped
+                    prefetchRead(childOffsets + childOffsets[child]);
                 }
             }
         }
@@ -109,6 +119,59 @@ HOST_DEVICE_FUN void singleTraversal(const TreeNodeIndex* childOffsets, C&& cont
     } while (node != 0); // the root can only be obtained when the tree has been fully traversed
 }
 
+/*! @brief single traversal of a tree in TraversalNode layout, see buildDepthFirstNodes
+ *
+ * @param nodes                  compact node records with the root at index 0
+ * @param continuationCriterion  callable with signature bool(const TraversalNode<T>&)
+ * @param endpointAction         callable with signature void(const TraversalNode<T>&), called for leaf nodes
+ *
+ * Visits nodes in the same order as singleTraversal on the breadth-first source tree. The block of children
+ * of each node that is pushed on the stack is prefetched, since it will be needed once the node is popped.
+ */
+template<class T, class C, class A>
+HOST_DEVICE_FUN void singleTraversal(const TraversalNode<T>* nodes, C&& continuationCriterion, A&& endpointAction)
+{
+    if (!continuationCriterion(nodes[0])) return;
+
+    if (nodes[0].child == 0)
+    {
+        endpointAction(nodes[0]);
+        return;
+    }
+
+    TreeNodeIndex stack[128];
+    stack[0] = 0;
+
+    TreeNodeIndex stackPos = 1;
+    TreeNodeIndex node     = 0;
+
+    do
+    {
+        const TraversalNode<T>* children = nodes + nodes[node].child;
+        for (int octant = 0; octant < 8; ++octant)
+        {
+            const auto& child = children[octant];
+            if (continuationCriterion(child))
+            {
+                if (child.child == 0) { endpointAction(child); }
+                else
+                {
+                    assert(stackPos < 128);
+                    stack[stackPos++] = TreeNodeIndex(&child - nodes);
+
+                    const char* block = reinterpret_cast<const char*>(nodes + child.child);
+                    for (size_t offset = 0; offset < 8 * sizeof(TraversalNode<T>); offset += 64)
+                    {
+                        prefetchRead(block + offset);
+                    }
+                }
+            }
+        }
+        node = stack[--stackPos];
+
+    } while (node != 0);
+}
+
 /*! @brief Generic dual-traversal of a tree with pairs of indices. Also called simultaneous traversal.
  *
  * Since the continuation criterion and the two endpoint actions for failed/passed criteria are
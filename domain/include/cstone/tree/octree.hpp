@@ -292,6 +292,71 @@ struct OctreeView
     NodeType* leafToInternal;
 };
 
+/*! @brief compact node record for read-only CPU traversal
+ *
+ * All data needed to test and descend into a node are packed together, such that evaluating the 8 children of a node
+ * touches a single contiguous block of memory instead of one cache line per separate node property array.
+ */
+template<class T>
+struct TraversalNode
+{
+    Vec3<T> center;
+    Vec3<T> size;
+    //! @brief index of the first of the 8 contiguous children, 0 for leaf nodes
+    TreeNodeIndex child;
+    //! @brief the corresponding leaf index into the particle layout, only valid for leaf nodes
+    TreeNodeIndex leafIdx;
+};
+
+/*! @brief copy an octree into TraversalNode records stored in depth-first order of sibling blocks
+ *
+ * @param[in]  childOffsets    child offsets of the breadth-first octree
+ * @param[in]  internalToLeaf  leaf index of each octree node
+ * @param[in]  centers         geometrical node centers
+ * @param[in]  sizes           geometrical node sizes
+ * @param[in]  numNodes        number of octree nodes
+ * @param[out] nodes           output records, the root is located at index 0
+ *
+ * Siblings stay contiguous, but the block of children of a node is placed right after the blocks of the subtrees that
+ * are traversed before it. The blocks are laid out in the order in which singleTraversal visits them (last octant
+ * first), such that the nodes touched in a descent are close in memory instead of being spread over the tree levels.
+ * Node indices are different from the source tree, but the traversal order and results are identical.
+ */
+template<class T>
+void buildDepthFirstNodes(const TreeNodeIndex* childOffsets,
+                          const TreeNodeIndex* internalToLeaf,
+                          const Vec3<T>* centers,
+                          const Vec3<T>* sizes,
+                          TreeNodeIndex numNodes,
+                          std::vector<TraversalNode<T>>& nodes)
+{
+    nodes.resize(numNodes);
+    nodes[0] = {centers[0], sizes[0], 0, internalToLeaf[0]};
+
+    // pairs of (source node index, destination record index)
+    std::vector<util::array<TreeNodeIndex, 2>> stack{{0, 0}};
+    TreeNodeIndex nextBlock = 1;
+
+    while (!stack.empty())
+    {
+        auto [src, dst] = stack.back();
+        stack.pop_back();
+
+        TreeNodeIndex firstChild = childOffsets[src];
+        if (firstChild == 0) { continue; }
+
+        nodes[dst].child = nextBlock;
+        for (int octant = 0; octant < 8; ++octant)
+        {
+            TreeNodeIndex c           = firstChild + octant;
+            nodes[nextBlock + octant] = {centers[c], sizes[c], 0, internalToLeaf[c]};
+            stack.push_back({c, nextBlock + octant});
+        }
+        nextBlock += 8;
+    }
+    assert(nextBlock == numNodes);
+}
+
 //! @brief Octree data and properties needed for neighbor search traversal
 template<class T, class KeyType>
 struct OctreeNsView
@@ -314,6 +379,9 @@ struct OctreeNsView
      *          Default for fully converged trees: 1.0, >1.0 otherwise
      */
     float searchExtFactor{1.0};
+
+    //! @brief optional depth-first copy of the tree for CPU traversal, see buildDepthFirstNodes
+    const TraversalNode<T>* dfNodes{nullptr};
 };
 
 template<class KeyType, class Accelerator>
@@ -0,0 +1,289 @@
+/*
+ * Cornerstone octree
+ *
+ * Copyright (c) 2024 CSCS, ETH Zurich, University of Zurich, 2021 University of Basel
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: MIT License
+ */
+
+/*! @file
+ * @brief Stack allocator for temporary host buffers of domain sync, halo exchange and propagator phases
+ *
+ * Scratch space is drawn from a few large blocks that are kept alive across time-steps. Allocations are released
+ * in LIFO order through scoped frames. Whenever the arena becomes empty, the blocks are merged into a single block
+ * sized to the high-water mark, such that in steady state, all temporary storage of a time-step is served from one
+ * allocation without any calls to malloc/free or first-touch page faults. Peaks that are not reached again, e.g. in
+ * the initial particle exchange, are returned to the system by trimScratchArenas() after each domain sync.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "cstone/primitives/math.hpp"
+#include "cstone/util/gsl-lite.hpp"
+
+namespace cstone
+{
+
+class ScratchArena
+{
+    //! @brief all allocations are aligned to cache lines
+    static constexpr size_t alignment = 64;
+    //! @brief minimum size of newly allocated blocks
+    static constexpr size_t minBlockBytes = size_t(1) << 20;
+
+    struct Marker
+    {
+        size_t block;
+        size_t offset;
+        size_t bytesInUse;
+    };
+
+public:
+    /*! @brief releases all allocations made from the arena during its lifetime upon destruction
+     *
+     * Frames may be moved to extend their lifetime beyond the opening scope, but must still be released in the reverse
+     * order of opening.
+     */
+    class [[nodiscard]] Frame
+    {
+    public:
+        explicit Frame(ScratchArena& arena)
+            : arena_(&arena)
+            , marker_(arena.marker())
+        {
+        }
+
+        Frame(Frame&& other) noexcept
+            : arena_(other.arena_)
+            , marker_(other.marker_)
+        {
+            other.arena_ = nullptr;
+        }
+
+        Frame(const Frame&)            = delete;
+        Frame& operator=(const Frame&) = delete;
+        Frame& operator=(Frame&&)      = delete;
+
+        ~Frame()
+        {
+            if (arena_) { arena_->release(marker_); }
+        }
+
+    private:
+        ScratchArena* arena_;
+        Marker marker_;
+    };
+
+    ScratchArena() = default;
+
+    ScratchArena(const ScratchArena&)            = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    //! @brief open a new frame, allocations are valid until the returned frame goes out of scope
+    Frame frame() { return Frame(*this); }
+
+    //! @brief uninitialized storage for @p n elements of type T, valid until the enclosing frame is released
+    template<class T>
+    gsl::span<T> allocate(size_t n)
+    {
+        static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>);
+        static_assert(alignof(T) <= alignment);
+        return {reinterpret_cast<T*>(allocateBytes(n * sizeof(T))), n};
+    }
+
+    char* allocateBytes(size_t numBytes)
+    {
+        numBytes = round_up(std::max(numBytes, size_t(1)), alignment);
+
+        // blocks following the current one may be left over from previous frames
+        while (current_ < blocks_.size() && offset_ + numBytes > blocks_[current_].capacity)
+        {
+            ++current_;
+            offset_ = 0;
+        }
+        if (current_ == blocks_.size())
+        {
+            size_t prevCapacity = blocks_.empty() ? 0 : blocks_.back().capacity;
+            blocks_.push_back(Block(std::max({numBytes, 2 * prevCapacity, minBlockBytes})));
+            offset_ = 0;
+        }
+
+        char* ret = blocks_[current_].data.get() + offset_;
+        offset_ += numBytes;
+        bytesInUse_ += numBytes;
+        highWaterMark_ = std::max(highWaterMark_, bytesInUse_);
+        recentPeak_    = std::max(recentPeak_, bytesInUse_);
+
+        return ret;
+    }
+
+    //! @brief number of bytes currently handed out
+    size_t bytesInUse() const { return bytesInUse_; }
+
+    //! @brief maximum number of bytes that were in use at the same time
+    size_t highWaterMark() const { return highWaterMark_; }
+
+    /*! @brief release the storage of an empty arena that exceeds @p slack times the peak use since the last call
+     *
+     * If the arena is shrunk, it keeps a single block that can hold the peak use since the last call, but no less
+     * than the minimum block size.
+     */
+    void trim(double slack = 2.0)
+    {
+        if (bytesInUse_ > 0) { return; }
+
+        if (double(capacity()) > slack * double(std::max(recentPeak_, minBlockBytes)))
+        {
+            blocks_.clear();
+            if (recentPeak_ > 0) { blocks_.push_back(Block(std::max(recentPeak_, minBlockBytes))); }
+            current_ = 0;
+            offset_  = 0;
+        }
+        recentPeak_ = 0;
+    }
+
+    //! @brief total number of bytes held by the arena
+    size_t capacity() const
+    {
+        size_t ret = 0;
+        for (const auto& b : blocks_)
+        {
+            ret += b.capacity;
+        }
+        return ret;
+    }
+
+    //! @brief number of separate blocks, 1 in steady state
+    size_t numBlocks() const { return blocks_.size(); }
+
+private:
+    struct AlignedDelete
+    {
+        void operator()(char* p) const { ::operator delete[](p, std::align_val_t(alignment)); }
+    };
+
+    struct Block
+    {
+        explicit Block(size_t numBytes)
+            : data(static_cast<char*>(::operator new[](numBytes, std::align_val_t(alignment))))
+            , capacity(numBytes)
+        {
+        }
+
+        std::unique_ptr<char[], AlignedDelete> data;
+        size_t capacity;
+    };
+
+    Marker marker() const { return {current_, offset_, bytesInUse_}; }
+
+    void release(const Marker& m)
+    {
+        assert(m.bytesInUse <= bytesInUse_);
+        current_    = m.block;
+        offset_     = m.offset;
+        bytesInUse_ = m.bytesInUse;
+
+        if (bytesInUse_ == 0 && blocks_.size() > 1)
+        {
+            // all requests up to the recent peak will fit into a single contiguous block
+            blocks_.clear();
+            blocks_.push_back(Block(std::max(recentPeak_, minBlockBytes)));
+            current_ = 0;
+            offset_  = 0;
+        }
+    }
+
+    std::vector<Block> blocks_;
+    size_t current_{0};
+    size_t offset_{0};
+    size_t bytesInUse_{0};
+    size_t highWaterMark_{0};
+    //! @brief maximum number of bytes in use since the last call to trim()
+    size_t recentPeak_{0};
+};
+
+namespace detail
+{
+
+//! @brief the arenas of all live threads
+class ScratchArenaRegistry
+{
+public:
+    void add(ScratchArena* arena)
+    {
+        std::lock_guard lock(mutex_);
+        arenas_.push_back(arena);
+    }
+
+    void remove(ScratchArena* arena)
+    {
+        std::lock_guard lock(mutex_);
+        arenas_.erase(std::find(arenas_.begin(), arenas_.end(), arena));
+    }
+
+    template<class F>
+    void forEach(F&& f)
+    {
+        std::lock_guard lock(mutex_);
+        for (auto* arena : arenas_)
+        {
+            f(*arena);
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<ScratchArena*> arenas_;
+};
+
+inline ScratchArenaRegistry& scratchArenaRegistry()
+{
+    static ScratchArenaRegistry registry;
+    return registry;
+}
+
+//! @brief a thread-local arena that is listed in the registry for the lifetime of its thread
+struct RegisteredArena
+{
+    RegisteredArena() { scratchArenaRegistry().add(&arena); }
+    ~RegisteredArena() { scratchArenaRegistry().remove(&arena); }
+
+    ScratchArena arena;
+};
+
+} // namespace detail
+
+//! @brief the scratch arena of the calling thread
+inline ScratchArena& scratchArena()
+{
+    thread_local detail::RegisteredArena registered;
+    return registered.arena;
+}
+
+//! @brief the maximum high-water mark of the arenas of all live threads
+inline size_t scratchHighWaterMark()
+{
+    size_t ret = 0;
+    detail::scratchArenaRegistry().forEach([&ret](const ScratchArena& a) { ret = std::max(ret, a.highWaterMark()); });
+    return ret;
+}
+
+/*! @brief trim the arenas of all live threads, see ScratchArena::trim
+ *
+ * Must not be called while other threads allocate from their arenas, e.g. inside OpenMP parallel regions.
+ */
+inline void trimScratchArenas(double slack = 2.0)
+{
+    detail::scratchArenaRegistry().forEach([slack](ScratchArena& a) { a.trim(slack); });
+}
+
+} // namespace cstone
@@ -262,8 +262,7 @@ TEST(DomainGpu, reapplySync)
     // exchange property together with sync
     domain.sync(d_keys, d_x, d_y, d_z, d_h, std::tie(property), std::tie(s1, s2, gpuOrdering));
 
-    std::vector<Real> hs1, hs2;
-    domain.reapplySync(std::tie(host_property), hs1, hs2, gpuOrdering);
+    domain.reapplySync(std::tie(host_property), gpuOrdering);
 
     EXPECT_EQ(property.size(), host_property.size());
 
@@ -44,6 +44,7 @@
 
 #include "coord_samples/random.hpp"
 #include "cstone/domain/domain.hpp"
+#include "cstone/domain/virtual_ranks.hpp"
 #include "cstone/findneighbors.hpp"
 #include "unit/neighbors/all_to_all.hpp"
 
@@ -208,6 +209,30 @@ TEST(FocusDomain, randomGaussianNeighborSumPbc)
     }
 }
 
+//! @brief thin periodic slab with a tiled SFC mapping, octree nodes are cubic and the z-range is reduced
+TEST(FocusDomain, randomGaussianNeighborSumTiledSlab)
+{
+    int rank = 0, nRanks = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &nRanks);
+
+    int bucketSize      = 50;
+    int bucketSizeFocus = 10;
+    float theta         = 0.75;
+
+    auto periodic = BoundaryType::periodic;
+    {
+        Box<double> box(-1, 1, -1, 1, -0.25, 0.25, periodic, periodic, periodic, true);
+        Domain<unsigned, double> domain(rank, nRanks, bucketSize, bucketSizeFocus, theta, box);
+        randomGaussianDomain<unsigned, double>(domain, rank, nRanks, true);
+    }
+    {
+        Box<double> box(-1, 1, -1, 1, -0.25, 0.25, periodic, periodic, periodic, true);
+        Domain<uint64_t, double> domain(rank, nRanks, bucketSize, bucketSizeFocus, theta, box);
+        randomGaussianDomain<uint64_t, double>(domain, rank, nRanks, true);
+    }
+}
+
 TEST(FocusDomain, assignmentShift)
 {
     int rank = 0, numRanks = 0;
@@ -361,7 +386,7 @@ TEST(FocusDomain, reapplySync)
     // exchange property together with sync
     domain.sync(particleKeys, x, y, z, h, std::tie(property), std::tie(s1, s2, s3));
 
-    domain.reapplySync(std::tie(propertyCpy), s1, s2, s3);
+    domain.reapplySync(std::tie(propertyCpy), s3);
 
     EXPECT_EQ(property.size(), propertyCpy.size());
 
@@ -383,3 +408,141 @@ TEST(FocusDomain, reapplySync)
         EXPECT_EQ(numCommon, domain.nParticles());
     }
 }
+
+/*! @brief a domain warm-started from the global tree of a converged domain reproduces its decomposition
+ *
+ * The warm-started domains skip the global tree convergence and start the focus tree from the global leaves, but
+ * have to arrive at the same trees, assignment and particle layout as the cold-started one.
+ */
+TEST(FocusDomain, warmStart)
+{
+    using KeyType = uint64_t;
+    using Real    = double;
+
+    int rank = 0, numRanks = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+
+    Box<Real> box{-1, 1};
+    LocalIndex numParticles    = (20000 / numRanks) * numRanks;
+    unsigned bucketSize        = 64;
+    unsigned bucketSizeFocus   = 8;
+    float theta                = 0.5;
+    LocalIndex firstExtract    = rank * numParticles / numRanks;
+    LocalIndex lastExtract     = (rank + 1) * numParticles / numRanks;
+
+    std::vector<Real> xGlobal(numParticles), yGlobal(numParticles), zGlobal(numParticles);
+    initCoordinates(xGlobal, yGlobal, zGlobal, box);
+
+    auto syncDomain = [&](Domain<KeyType, Real>& domain)
+    {
+        std::vector<Real> x{xGlobal.begin() + firstExtract, xGlobal.begin() + lastExtract};
+        std::vector<Real> y{yGlobal.begin() + firstExtract, yGlobal.begin() + lastExtract};
+        std::vector<Real> z{zGlobal.begin() + firstExtract, zGlobal.begin() + lastExtract};
+        std::vector<Real> h(x.size(), 0.05);
+        std::vector<KeyType> keys(x.size());
+        std::vector<Real> s1, s2, s3;
+        domain.sync(keys, x, y, z, h, std::tuple{}, std::tie(s1, s2, s3));
+        return keys;
+    };
+
+    Domain<KeyType, Real> cold(rank, numRanks, bucketSize, bucketSizeFocus, theta, box);
+    auto coldKeys = syncDomain(cold);
+
+    std::vector<KeyType> globalLeaves(cold.globalTree().treeLeaves().begin(), cold.globalTree().treeLeaves().end());
+    std::vector<unsigned> globalCounts(cold.globalCounts().begin(), cold.globalCounts().end());
+    std::vector<KeyType> assignment(cold.assignment().begin(), cold.assignment().end());
+    std::vector<KeyType> focusLeaves(cold.focusTree().treeLeaves().begin(), cold.focusTree().treeLeaves().end());
+    EXPECT_EQ(assignment.size(), numRanks + 1);
+
+    // same number of ranks as in the stored assignment, and a re-split of the SFC from the global counts
+    for (bool withAssignment : {true, false})
+    {
+        Domain<KeyType, Real> warm(rank, numRanks, bucketSize, bucketSizeFocus, theta, box);
+        warm.warmStart(globalLeaves, globalCounts, withAssignment ? assignment : std::vector<KeyType>{});
+        auto warmKeys = syncDomain(warm);
+
+        std::vector<KeyType> warmGlobal(warm.globalTree().treeLeaves().begin(), warm.globalTree().treeLeaves().end());
+        std::vector<KeyType> warmAssignment(warm.assignment().begin(), warm.assignment().end());
+        std::vector<KeyType> warmFocus(warm.focusTree().treeLeaves().begin(), warm.focusTree().treeLeaves().end());
+
+        EXPECT_EQ(warmGlobal, globalLeaves);
+        EXPECT_EQ(warmAssignment, assignment);
+        EXPECT_EQ(warmFocus, focusLeaves);
+        EXPECT_EQ(warm.startIndex(), cold.startIndex());
+        EXPECT_EQ(warm.endIndex(), cold.endIndex());
+        EXPECT_EQ(warmKeys, coldKeys);
+    }
+
+    // the focus tree seeded with its converged leaves is already converged in the first sync
+    {
+        Domain<KeyType, Real> warm(rank, numRanks, bucketSize, bucketSizeFocus, theta, box);
+        EXPECT_THROW(warm.warmStartFocus(focusLeaves), std::runtime_error);
+        warm.warmStart(globalLeaves, globalCounts, assignment);
+        warm.warmStartFocus(focusLeaves);
+        auto warmKeys = syncDomain(warm);
+
+        std::vector<KeyType> warmFocus(warm.focusTree().treeLeaves().begin(), warm.focusTree().treeLeaves().end());
+        EXPECT_EQ(warmFocus, focusLeaves);
+        EXPECT_EQ(warm.startIndex(), cold.startIndex());
+        EXPECT_EQ(warmKeys, coldKeys);
+    }
+
+    Domain<KeyType, Real> synced(rank, numRanks, bucketSize, bucketSizeFocus, theta, box);
+    syncDomain(synced);
+    EXPECT_THROW(synced.warmStart(globalLeaves, globalCounts, assignment), std::runtime_error);
+}
+
+//! @brief the decomposition predicted for virtual ranks in a single process matches the first sync of a Domain
+TEST(FocusDomain, virtualRanks)
+{
+    using KeyType = uint64_t;
+    using Real    = double;
+
+    int rank = 0, numRanks = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+
+    Box<Real> box{-1, 1};
+    LocalIndex numParticles  = (6000 / numRanks) * numRanks;
+    unsigned bucketSize      = 64;
+    unsigned bucketSizeFocus = 8;
+    float theta              = 0.5;
+    Real hValue              = 0.05;
+    LocalIndex firstExtract  = rank * numParticles / numRanks;
+    LocalIndex lastExtract   = (rank + 1) * numParticles / numRanks;
+
+    std::vector<Real> xGlobal(numParticles), yGlobal(numParticles), zGlobal(numParticles);
+    initCoordinates(xGlobal, yGlobal, zGlobal, box);
+
+    std::vector<Real> x{xGlobal.begin() + firstExtract, xGlobal.begin() + lastExtract};
+    std::vector<Real> y{yGlobal.begin() + firstExtract, yGlobal.begin() + lastExtract};
+    std::vector<Real> z{zGlobal.begin() + firstExtract, zGlobal.begin() + lastExtract};
+    std::vector<Real> h(x.size(), hValue);
+    std::vector<KeyType> keys(x.size());
+    std::vector<Real> s1, s2, s3;
+
+    Domain<KeyType, Real> domain(rank, numRanks, bucketSize, bucketSizeFocus, theta, box);
+    domain.sync(keys, x, y, z, h, std::tuple{}, std::tie(s1, s2, s3));
+
+    std::vector<KeyType> globalKeys(numParticles);
+    computeSfcKeys(xGlobal.data(), yGlobal.data(), zGlobal.data(), sfcKindPointer(globalKeys.data()), numParticles,
+                   box);
+    std::sort(globalKeys.begin(), globalKeys.end());
+    std::vector<Real> hGlobal(numParticles, hValue);
+
+    auto stats = simulateVirtualRanks<KeyType>(numRanks, globalKeys, hGlobal.data(), box, bucketSize, bucketSizeFocus,
+                                               theta);
+    ASSERT_EQ(stats.size(), numRanks);
+
+    EXPECT_EQ(stats[rank].numParticles, domain.nParticles());
+    EXPECT_EQ(stats[rank].numHalosRecv, domain.nParticlesWithHalos() - domain.nParticles());
+
+    LocalIndex sumRecv = 0, sumSent = 0;
+    for (const auto& s : stats)
+    {
+        sumRecv += s.numHalosRecv;
+        sumSent += s.numHalosSent;
+    }
+    EXPECT_EQ(sumRecv, sumSent);
+}
@@ -183,3 +183,37 @@ TEST(PeerExchange, arrayWrap)
         EXPECT_EQ(buffer, reference);
     }
 }
+
+TEST(PeerExchange, messageSizesWaitsome)
+{
+    int rank = 0, numRanks = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+
+    int peer = (rank + 1) % numRanks;
+    std::vector<int> peers{peer};
+
+    // rank r sends r + 1 elements with value r
+    std::vector<int> sendCounts{rank + 1};
+    auto recvCounts = exchangeMessageSizes(peers, sendCounts, 0);
+    EXPECT_EQ(recvCounts[0], peer + 1);
+
+    std::vector<int> sendBuffer(sendCounts[0], rank);
+    std::vector<int> recvBuffer(recvCounts[0]);
+
+    std::vector<MPI_Request> recvRequests, sendRequests;
+    mpiRecvAsync(recvBuffer.data(), recvCounts[0], peer, 0, recvRequests);
+    mpiSendAsync(sendBuffer.data(), sendCounts[0], peer, 0, sendRequests);
+
+    int numUnpacked = 0;
+    waitsomeUnpack(recvRequests,
+                   [&](int i)
+                   {
+                       EXPECT_EQ(i, 0);
+                       numUnpacked++;
+                   });
+    MPI_Waitall(int(sendRequests.size()), sendRequests.data(), MPI_STATUS_IGNORE);
+
+    EXPECT_EQ(numUnpacked, 1);
+    EXPECT_EQ(recvBuffer, std::vector<int>(peer + 1, peer));
+}
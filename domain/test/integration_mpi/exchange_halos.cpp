@@ -35,7 +35,8 @@
 
 using namespace cstone;
 
-void simpleTest(int thisRank)
+//! @brief exchange halos of 3 arrays, either with haloexchange or with haloExchangeStart and wait
+void simpleTest(int thisRank, bool splitPhase)
 {
     int nRanks = 2;
     std::vector<int> nodeList{0, 1, 10, 11};
@@ -98,7 +99,12 @@ void simpleTest(int thisRank)
         EXPECT_EQ(yOrig, y);
     }
 
-    haloexchange(0, incomingHalos, outgoingHalos, x.data(), y.data(), velocity.data());
+    if (splitPhase)
+    {
+        auto pending = haloExchangeStart(1, incomingHalos, outgoingHalos, x.data(), y.data(), velocity.data());
+        pending.wait();
+    }
+    else { haloexchange(0, incomingHalos, outgoingHalos, x.data(), y.data(), velocity.data()); }
 
     std::vector<double> xRef{20, 21, 22, 23, 24, 25, 26, 27, 28, 29};
     std::vector<float> yRef{30, 31, 32, 33, 34, 35, 36, 37, 38, 39};
@@ -119,5 +125,51 @@ TEST(HaloExchange, simpleTest)
 
     if (nRanks != thisExampleRanks) throw std::runtime_error("this test needs 2 ranks\n");
 
-    simpleTest(rank);
-}
\ No newline at end of file
+    simpleTest(rank, false);
+}
+
+TEST(HaloExchange, startWait)
+{
+    int rank = 0, nRanks = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &nRanks);
+
+    constexpr int thisExampleRanks = 2;
+
+    if (nRanks != thisExampleRanks) throw std::runtime_error("this test needs 2 ranks\n");
+
+    simpleTest(rank, true);
+}
+
+//! @brief messages of a halo exchange are attributed to the accounting interval in which they are posted
+TEST(HaloExchange, commAccounting)
+{
+    int rank = 0, nRanks = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &nRanks);
+
+    if (nRanks != 2) throw std::runtime_error("this test needs 2 ranks\n");
+
+    commAccounting().setEnabled(true);
+    simpleTest(rank, false);
+    CommVolume volume = commAccounting().collect();
+
+    // x, y and velocity of 3 particles are sent from rank 0 to rank 1 and 7 particles from rank 1 to rank 0
+    uint64_t bytesPerParticle = sizeof(double) + sizeof(float) + sizeof(util::array<int, 3>);
+    uint64_t numSent          = (rank == 0) ? 3 : 7;
+    uint64_t numReceived      = (rank == 0) ? 7 : 3;
+
+    EXPECT_EQ(volume.messagesSent, 1);
+    EXPECT_EQ(volume.messagesReceived, 1);
+    EXPECT_EQ(volume.numPeers, 1);
+    // buffers may be padded for alignment
+    EXPECT_GE(volume.bytesSent, numSent * bytesPerParticle);
+    EXPECT_GE(volume.bytesReceived, numReceived * bytesPerParticle);
+    EXPECT_LT(volume.bytesSent, numSent * bytesPerParticle + 256);
+
+    // counters are reset by collect and ignored while disabled
+    EXPECT_EQ(commAccounting().collect().messagesSent, 0);
+    commAccounting().setEnabled(false);
+    simpleTest(rank, true);
+    EXPECT_EQ(commAccounting().collect().messagesSent, 0);
+}
@@ -0,0 +1,120 @@
+/*
+ * Cornerstone octree
+ *
+ * Copyright (c) 2024 CSCS, ETH Zurich, University of Zurich, 2021 University of Basel
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: MIT License
+ */
+
+/*! @file
+ * @brief Tests for the topology-aware rank order and domain syncs on a reordered communicator
+ */
+
+#include <mpi.h>
+#include <gtest/gtest.h>
+
+#include "cstone/domain/domain.hpp"
+#include "cstone/domain/rank_topology.hpp"
+
+#include "coord_samples/random.hpp"
+
+using namespace cstone;
+
+TEST(RankTopology, rankOrder)
+{
+    // ranks 1 and 3 are in group 0, ranks 0 and 2 in group 1
+    std::vector<int> groups{1, 0, 1, 0};
+    std::vector<int> nodeIds{0, 1, 2, 3};
+
+    std::vector<int> ref{2, 0, 3, 1};
+    EXPECT_EQ(topologyRankOrder(groups, nodeIds), ref);
+
+    // single group, ranks 0 and 2 share node 0
+    std::vector<int> groups2{0, 0, 0, 0};
+    std::vector<int> nodeIds2{0, 1, 0, 1};
+    std::vector<int> ref2{0, 2, 1, 3};
+    EXPECT_EQ(topologyRankOrder(groups2, nodeIds2), ref2);
+}
+
+TEST(RankTopology, lookupGroup)
+{
+    std::string topology = "# host group\nnid001 3\nnid002 1\n\nnid003 0\n";
+
+    EXPECT_EQ(lookupNetworkGroup(topology, "nid001"), 3);
+    EXPECT_EQ(lookupNetworkGroup(topology, "nid002"), 1);
+    EXPECT_EQ(lookupNetworkGroup(topology, "nid003"), 0);
+    EXPECT_EQ(lookupNetworkGroup(topology, "nid004"), -1);
+    EXPECT_EQ(lookupNetworkGroup(topology, "host"), -1);
+}
+
+TEST(RankTopology, orderedCommSingleNode)
+{
+    int rank = 0, numRanks = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+
+    // all test ranks run on the same node, so the order is unchanged
+    MPI_Comm ordered = topologyOrderedComm(MPI_COMM_WORLD);
+
+    int orderedRank, orderedSize;
+    MPI_Comm_rank(ordered, &orderedRank);
+    MPI_Comm_size(ordered, &orderedSize);
+    EXPECT_EQ(orderedSize, numRanks);
+    EXPECT_EQ(orderedRank, rank);
+
+    MPI_Comm_free(&ordered);
+}
+
+//! @brief domain sync on a communicator with reversed rank order must distribute particles according to the new ranks
+template<class KeyType, class T>
+void reversedDomainComm(int worldRank, int numRanks)
+{
+    MPI_Comm reversed;
+    MPI_Comm_split(MPI_COMM_WORLD, 0, numRanks - 1 - worldRank, &reversed);
+    domainComm() = reversed;
+
+    int rank;
+    MPI_Comm_rank(domainComm(), &rank);
+    EXPECT_EQ(rank, numRanks - 1 - worldRank);
+
+    LocalIndex numParticles = 1000;
+    Box<T> box{-1, 1};
+    RandomCoordinates<T, SfcKind<KeyType>> coords(numParticles, box, worldRank);
+
+    std::vector<T> x(coords.x().begin(), coords.x().end());
+    std::vector<T> y(coords.y().begin(), coords.y().end());
+    std::vector<T> z(coords.z().begin(), coords.z().end());
+    std::vector<T> h(numParticles, 0.1);
+    std::vector<KeyType> keys(numParticles);
+
+    Domain<KeyType, T> domain(rank, numRanks, 10, 10, 1.0, box);
+    std::vector<T> s1, s2, s3;
+    domain.sync(keys, x, y, z, h, std::tuple{}, std::tie(s1, s2, s3));
+
+    LocalIndex numAssigned = domain.nParticles();
+    MPI_Allreduce(MPI_IN_PLACE, &numAssigned, 1, MpiType<LocalIndex>{}, MPI_SUM, MPI_COMM_WORLD);
+    EXPECT_EQ(numAssigned, numParticles * numRanks);
+
+    // local particles need to be inside the SFC range of this rank in the reordered communicator
+    auto leaves = domain.focusTree().treeLeaves();
+    KeyType lo  = leaves[domain.startCell()];
+    KeyType hi  = leaves[domain.endCell()];
+    for (LocalIndex i = domain.startIndex(); i < domain.endIndex(); ++i)
+    {
+        EXPECT_TRUE(lo <= keys[i] && keys[i] < hi);
+    }
+
+    domainComm() = MPI_COMM_WORLD;
+    MPI_Comm_free(&reversed);
+}
+
+TEST(RankTopology, reversedDomainComm)
+{
+    int rank = 0, numRanks = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+
+    reversedDomainComm<uint64_t, double>(rank, numRanks);
+    reversedDomainComm<unsigned, float>(rank, numRanks);
+}
@@ -207,6 +207,20 @@ TEST(FocusedOctree, rebalanceDecision)
     rebalanceDecision<uint64_t>();
 }
 
+TEST(FocusedOctree, costWeightedCounts)
+{
+    std::vector<unsigned> leafCounts{10, 10, 10, 10, 10};
+    // mean cost per particle over the leaves with costs: 400 / 40 = 10
+    std::vector<float> leafCosts{100, 200, 50, 0, 50};
+    std::vector<unsigned> weighted(leafCounts.size());
+
+    costWeightedCounts(leafCounts, leafCosts, 4.0f, weighted);
+    EXPECT_EQ(weighted, (std::vector<unsigned>{10, 20, 5, 10, 5}));
+
+    costWeightedCounts(leafCounts, leafCosts, 1.5f, weighted);
+    EXPECT_EQ(weighted, (std::vector<unsigned>{10, 15, 7, 10, 7}));
+}
+
 template<class KeyType>
 static void nodeOpsKeepAlive()
 {
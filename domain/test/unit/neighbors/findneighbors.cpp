@@ -101,10 +101,25 @@ void neighborCheck(const Coordinates& coords, T radius, const Box<T>& box)
 
     findNeighbors(coords.x().data(), coords.y().data(), coords.z().data(), h.data(), 0, n, box, nsView, ngmax,
                   neighborsProbe.data(), neighborsCountProbe.data());
+    std::vector<LocalIndex> neighborsUnsorted = neighborsProbe;
     sortNeighbors(neighborsProbe.data(), neighborsCountProbe.data(), n, ngmax);
 
     EXPECT_EQ(neighborsRef, neighborsProbe);
     EXPECT_EQ(neighborsCountRef, neighborsCountProbe);
+
+    std::vector<TraversalNode<T>> dfNodes;
+    buildDepthFirstNodes(octree.childOffsets.data(), octree.internalToLeaf.data(), centers.data(), sizes.data(),
+                         octree.numNodes, dfNodes);
+    nsView.dfNodes = dfNodes.data();
+
+    std::vector<LocalIndex> neighborsDf(n * ngmax);
+    std::vector<unsigned> neighborsCountDf(n);
+    findNeighbors(coords.x().data(), coords.y().data(), coords.z().data(), h.data(), 0, n, box, nsView, ngmax,
+                  neighborsDf.data(), neighborsCountDf.data());
+
+    // the depth-first layout preserves the traversal order, neighbors are identical even before sorting
+    EXPECT_EQ(neighborsUnsorted, neighborsDf);
+    EXPECT_EQ(neighborsCountRef, neighborsCountDf);
 }
 
 class FindNeighborsRandom
@@ -149,3 +164,17 @@ INSTANTIATE_TEST_SUITE_P(RandomNeighborsLargeRadius,
                                           testing::Values(500),
                                           testing::ValuesIn(boxes),
                                           testing::ValuesIn(pbcUsage)));
+
+TEST(FindNeighbors, tiledSlab)
+{
+    using KeyType = uint64_t;
+
+    for (auto bc : {BoundaryType::open, BoundaryType::periodic})
+    {
+        Box<double> box(0, 1, 0, 1, 0, 0.0625, bc, bc, bc, true);
+        ASSERT_EQ(box.sfcShiftZ(), 4);
+
+        RandomCoordinates<double, HilbertKey<KeyType>> coords(2500, box);
+        neighborCheck(coords, 0.03, box);
+    }
+}
@@ -51,6 +51,28 @@ TEST(GatherCpu, sortInvert)
     EXPECT_EQ(values, reference);
 }
 
+TEST(GatherCpu, sortStable)
+{
+    // enough elements for several merge passes, with many duplicate keys
+    std::size_t n = 1000;
+    std::vector<int> keys(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        keys[i] = (i * 7919) % 13;
+    }
+
+    std::vector<int> values(n);
+    std::iota(begin(values), end(values), 0);
+
+    std::vector<int> reference = values;
+    std::stable_sort(reference.begin(), reference.end(), [&keys](int a, int b) { return keys[a] < keys[b]; });
+
+    sort_by_key(begin(keys), end(keys), begin(values));
+
+    EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+    EXPECT_EQ(values, reference);
+}
+
 template<class ValueType, class KeyType, class IndexType>
 void CpuGatherTest()
 {
@@ -29,8 +29,14 @@
  * @author Sebastian Keller <sebastian.f.keller@gmail.com>
  */
 
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "cstone/sfc/box.hpp"
+#include "cstone/sfc/sfc.hpp"
 
 using namespace cstone;
 
@@ -72,6 +78,26 @@ TEST(SfcBox, applyPbc)
     EXPECT_NEAR(Xpbc[2], -0.1, 1e-10);
 }
 
+TEST(SfcBox, needsPBC)
+{
+    using T = double;
+
+    Box<T> box(0, 1, BoundaryType::periodic);
+    EXPECT_FALSE(needsPBC(box, 0.1, 0.5, 0.5, 0.5));
+    EXPECT_TRUE(needsPBC(box, 0.1, 0.05, 0.5, 0.5));
+    EXPECT_TRUE(needsPBC(box, 0.1, 0.5, 0.95, 0.5));
+    EXPECT_TRUE(needsPBC(box, 0.1, 0.5, 0.5, 0.05));
+
+    // open boundaries never need images
+    Box<T> openBox(0, 1, BoundaryType::open);
+    EXPECT_FALSE(needsPBC(openBox, 0.1, 0.05, 0.95, 0.05));
+
+    // only the periodic dimension is relevant
+    Box<T> slab(0, 1, 0, 1, 0, 1, BoundaryType::periodic, BoundaryType::open, BoundaryType::open);
+    EXPECT_FALSE(needsPBC(slab, 0.1, 0.5, 0.05, 0.95));
+    EXPECT_TRUE(needsPBC(slab, 0.1, 0.95, 0.5, 0.5));
+}
+
 TEST(SfcBox, putInBox)
 {
     using T = double;
@@ -137,6 +163,110 @@ TEST(SfcBox, createIBox)
     }
 }
 
+TEST(SfcBox, sfcShifts)
+{
+    using T       = double;
+    using KeyType = uint64_t;
+    auto pbc      = BoundaryType::periodic;
+
+    // without tiling, all dimensions span the full integer range
+    Box<T> slab(0, 1, 0, 1, 0, 0.0625, pbc, pbc, pbc);
+    EXPECT_FALSE(slab.tiled());
+    EXPECT_EQ(slab.sfcShiftZ(), 0);
+    EXPECT_EQ(sfcRange<KeyType>(slab), IBox(0, 1 << maxTreeLevel<KeyType>{}));
+
+    // Kelvin-Helmholtz slab: tiled by 16x16x1 cubes
+    Box<T> tiledSlab = slab.withTiling(true);
+    EXPECT_TRUE(tiledSlab.tiled());
+    EXPECT_EQ(tiledSlab.sfcShiftX(), 0);
+    EXPECT_EQ(tiledSlab.sfcShiftY(), 0);
+    EXPECT_EQ(tiledSlab.sfcShiftZ(), 4);
+    EXPECT_DOUBLE_EQ(tiledSlab.sfcLz(), 1.0);
+    EXPECT_DOUBLE_EQ(tiledSlab.sfcIlz(), 1.0);
+    EXPECT_FALSE(tiledSlab == slab);
+
+    constexpr int maxCoord = 1 << maxTreeLevel<KeyType>{};
+    EXPECT_EQ(sfcRange<KeyType>(tiledSlab), IBox(0, maxCoord, 0, maxCoord, 0, maxCoord / 16));
+
+    // wind-shock 8:2:2 box
+    Box<T> wind(0, 8, 0, 2, 0, 2, pbc, pbc, pbc, true);
+    EXPECT_EQ(wind.sfcShiftX(), 0);
+    EXPECT_EQ(wind.sfcShiftY(), 2);
+    EXPECT_EQ(wind.sfcShiftZ(), 2);
+
+    // Gresho-Chan: tiles are not exactly cubic if the aspect ratio is not a power of two
+    Box<T> gresho(-0.5, 0.5, -0.5, 0.5, 0, 0.111, pbc, pbc, pbc, true);
+    EXPECT_EQ(gresho.sfcShiftZ(), 3);
+
+    // very thin boxes are limited to maxSfcShift
+    Box<T> sheet(0, 1, 0, 1, 0, 1e-3, pbc, pbc, pbc, true);
+    EXPECT_EQ(sheet.sfcShiftZ(), Box<T>::maxSfcShift);
+}
+
+TEST(SfcBox, tiledSfcKeys)
+{
+    using T       = double;
+    using KeyType = uint32_t;
+
+    constexpr int maxCoord = 1 << maxTreeLevel<KeyType>{};
+
+    Box<T> box(0, 1, 0, 1, 0, 0.25, BoundaryType::periodic, BoundaryType::periodic, BoundaryType::periodic, true);
+    ASSERT_EQ(box.sfcShiftZ(), 2);
+
+    // the upper z-boundary maps to the last cell of the integer z-range
+    KeyType key       = sfc3D<HilbertKey<KeyType>>(T(1), T(1), T(0.25), box);
+    auto [ix, iy, iz] = decodeHilbert(key);
+    EXPECT_EQ(ix, unsigned(maxCoord - 1));
+    EXPECT_EQ(iy, unsigned(maxCoord - 1));
+    EXPECT_EQ(iz, unsigned(maxCoord / 4 - 1));
+
+    // cells in the tiled box are cubic
+    IBox cell(0, 1);
+    auto [center, size] = centerAndSize<KeyType>(cell, box);
+    EXPECT_DOUBLE_EQ(size[0], size[2]);
+
+    // a cube around a point in the box converts to the same integer box as the cell that contains it
+    IBox probe = createIBox<KeyType>(center, size * T(0.5), box);
+    EXPECT_EQ(probe, cell);
+}
+
+//! @brief stores step attributes on the first pass and loads them back afterwards
+struct AttributeArchive
+{
+    template<class T>
+    void stepAttribute(const std::string& key, T* values, int64_t size)
+    {
+        if (!load) { attributes[key].assign((char*)values, (char*)(values + size)); }
+        else if (attributes.count(key)) { std::copy_n(attributes[key].data(), size * sizeof(T), (char*)values); }
+        else { throw std::out_of_range("Attribute " + key + " does not exist\n"); }
+    }
+
+    bool load{false};
+    std::map<std::string, std::vector<char>> attributes;
+};
+
+TEST(SfcBox, loadOrStoreTiling)
+{
+    using T = double;
+
+    AttributeArchive archive;
+    Box<T> box(0, 1, 0, 1, 0, 0.25, BoundaryType::periodic, BoundaryType::periodic, BoundaryType::periodic, true);
+    box.loadOrStore(&archive);
+
+    archive.load = true;
+    Box<T> restored(0, 1);
+    restored.loadOrStore(&archive);
+    EXPECT_EQ(restored, box);
+    EXPECT_EQ(restored.sfcShiftZ(), 2);
+
+    // boxes from files without the tiling attribute keep their setting
+    archive.attributes.erase("tiled");
+    Box<T> untiled(0, 1);
+    untiled.loadOrStore(&archive);
+    EXPECT_FALSE(untiled.tiled());
+    EXPECT_EQ(untiled.zmax(), 0.25);
+}
+
 template<typename T>
 static bool contains(const Box<T>& large_box, const Box<T>& small_box)
 {
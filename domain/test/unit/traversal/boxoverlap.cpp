@@ -389,3 +389,39 @@ TEST(BoxOverlap, minDistance)
         EXPECT_NEAR(dist[2], 0., 1e-10);
     }
 }
+
+//! @brief overlap, containment and halo boxes in a tiled box with a reduced z-range
+TEST(BoxOverlap, tiledRange)
+{
+    using KeyType          = uint64_t;
+    constexpr int maxCoord = 1 << maxTreeLevel<KeyType>{};
+    constexpr int zRange   = maxCoord / 16;
+    constexpr int r        = zRange / 4;
+
+    Box<double> box(0, 1, 0, 1, 0, 0.0625, BoundaryType::periodic, BoundaryType::periodic, BoundaryType::periodic,
+                    true);
+    IBox range = sfcRange<KeyType>(box);
+    EXPECT_EQ(range, IBox(0, maxCoord, 0, maxCoord, 0, zRange));
+
+    // z-wrap happens at zRange
+    IBox top{0, r, 0, r, zRange - r, zRange + 1};
+    IBox bottom{0, r, 0, r, 0, r};
+    EXPECT_TRUE(overlap(top, bottom, range));
+    EXPECT_FALSE(overlap<KeyType>(top, bottom));
+
+    // the halo box of a node at the upper z-boundary extends beyond zRange
+    IBox nodeBox{0, r, 0, r, zRange - r, zRange};
+    IBox haloBox = makeHaloBox<KeyType>(nodeBox, 1e-3, box);
+    EXPECT_GT(haloBox.zmax(), zRange);
+    EXPECT_LT(haloBox.xmin(), 0);
+    EXPECT_TRUE(containedIn(KeyType(0), nodeRange<KeyType>(0), IBox{0, r, 0, r, 0, zRange}, range));
+    EXPECT_FALSE(containedIn(KeyType(0), nodeRange<KeyType>(1), haloBox, range));
+
+    // nodes outside the range are empty, nodes overlapping the range boundary are clipped
+    bool inside;
+    IBox clipped = clampToRange(IBox(0, maxCoord), range, inside);
+    EXPECT_TRUE(inside);
+    EXPECT_EQ(clipped, range);
+    clampToRange(IBox(0, r, 0, r, zRange, zRange + r), range, inside);
+    EXPECT_FALSE(inside);
+}
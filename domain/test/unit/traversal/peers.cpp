@@ -157,3 +157,84 @@ TEST(Peers, find)
     findPeers<unsigned>();
     findPeers<uint64_t>();
 }
+
+TEST(Peers, changedLeafRanges)
+{
+    using KeyType = unsigned;
+
+    std::vector<KeyType> oldLeaves{0, 8, 16, 24, 32, 64};
+    std::vector<KeyType> newLeaves{0, 4, 8, 16, 32, 40, 48, 64};
+
+    auto changes = changedLeafRanges<KeyType>(oldLeaves, newLeaves);
+
+    std::vector<util::array<KeyType, 2>> reference{{0, 8}, {16, 32}, {32, 64}};
+    EXPECT_EQ(changes, reference);
+    EXPECT_TRUE(changedLeafRanges<KeyType>(oldLeaves, oldLeaves).empty());
+}
+
+template<class KeyType>
+static void peerFinderIncremental()
+{
+    Box<double> box{-1, 1};
+    int numParticles  = 100000;
+    int bucketSize    = 64;
+    int numRanks      = 50;
+    float invThetaEff = invThetaMinMac(0.5f);
+
+    auto particleKeys   = makeRandomGaussianKeys<KeyType>(numParticles);
+    auto [tree, counts] = computeOctree(particleKeys.data(), particleKeys.data() + numParticles, bucketSize);
+
+    Octree<KeyType> octree;
+    octree.update(tree.data(), nNodes(tree));
+    auto assignment = makeSfcAssignment(numRanks, counts, tree.data());
+
+    std::vector<PeerFinder<KeyType, double>> finders(numRanks);
+    for (int rank = 0; rank < numRanks; ++rank)
+    {
+        EXPECT_EQ(finders[rank].find(rank, assignment, octree, box, invThetaEff),
+                  findPeersMac(rank, assignment, octree, box, invThetaEff));
+        EXPECT_FALSE(finders[rank].lastCallIncremental());
+    }
+
+    // add particles to a small SFC range to refine the tree locally, this also shifts the rank boundaries
+    std::vector<KeyType> extraKeys(particleKeys.begin() + numParticles / 3,
+                                   particleKeys.begin() + numParticles / 3 + 2000);
+    particleKeys.insert(particleKeys.end(), extraKeys.begin(), extraKeys.end());
+    std::sort(particleKeys.begin(), particleKeys.end());
+
+    auto [tree2, counts2] = computeOctree(particleKeys.data(), particleKeys.data() + particleKeys.size(), bucketSize);
+    ASSERT_NE(tree, tree2);
+
+    octree.update(tree2.data(), nNodes(tree2));
+    assignment = makeSfcAssignment(numRanks, counts2, tree2.data());
+
+    int numIncremental = 0;
+    for (int rank = 0; rank < numRanks; ++rank)
+    {
+        EXPECT_EQ(finders[rank].find(rank, assignment, octree, box, invThetaEff),
+                  findPeersMac(rank, assignment, octree, box, invThetaEff));
+        numIncremental += finders[rank].lastCallIncremental();
+    }
+    EXPECT_GT(numIncremental, 0);
+
+    // an open box that adapts to the particles keeps the cached pairs as long as the rescaling is within the slack
+    Box<double> box1{-1, 1.01, -1, 0.99, -1, 1};
+    for (int rank = 0; rank < numRanks; ++rank)
+    {
+        EXPECT_EQ(finders[rank].find(rank, assignment, octree, box1, invThetaEff),
+                  findPeersMac(rank, assignment, octree, box1, invThetaEff));
+        EXPECT_TRUE(finders[rank].lastCallIncremental());
+    }
+
+    // a box rescaled beyond the slack invalidates all cached pairs
+    Box<double> box2{-1, 2};
+    EXPECT_EQ(finders[0].find(0, assignment, octree, box2, invThetaEff),
+              findPeersMac(0, assignment, octree, box2, invThetaEff));
+    EXPECT_FALSE(finders[0].lastCallIncremental());
+}
+
+TEST(Peers, peerFinderIncremental)
+{
+    peerFinderIncremental<unsigned>();
+    peerFinderIncremental<uint64_t>();
+}
@@ -0,0 +1,123 @@
+/*
+ * Cornerstone octree
+ *
+ * Copyright (c) 2024 CSCS, ETH Zurich, University of Zurich, 2021 University of Basel
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: MIT License
+ */
+
+/*! @file
+ * @brief Tests for sphere, box and cylinder queries on octrees
+ */
+
+#include <numeric>
+
+#include "gtest/gtest.h"
+
+#include "cstone/focus/source_center.hpp"
+#include "cstone/traversal/region_query.hpp"
+#include "cstone/tree/csarray.hpp"
+
+#include "coord_samples/random.hpp"
+
+using namespace cstone;
+
+//! @brief compare octree queries of @p region against testing all particles in [first:last]
+template<class KeyType, class T, class Region>
+void checkRegionQuery(const Box<T>& box, const Region& region, LocalIndex first, LocalIndex last)
+{
+    LocalIndex numParticles = 5000;
+    RandomCoordinates<T, SfcKind<KeyType>> coords(numParticles, box);
+    const T* x = coords.x().data();
+    const T* y = coords.y().data();
+    const T* z = coords.z().data();
+
+    auto [csTree, counts] = computeOctree(coords.particleKeys().data(), coords.particleKeys().data() + numParticles, 16);
+    OctreeData<KeyType, CpuTag> octree;
+    octree.resize(nNodes(csTree));
+    updateInternalTree<KeyType>(csTree, octree.data());
+
+    std::vector<LocalIndex> layout(nNodes(csTree) + 1, 0);
+    std::inclusive_scan(counts.begin(), counts.end(), layout.begin() + 1);
+
+    gsl::span<const KeyType> nodeKeys(octree.prefixes.data(), octree.numNodes);
+    std::vector<Vec3<T>> centers(octree.numNodes), sizes(octree.numNodes);
+    nodeFpCenters<KeyType>(nodeKeys, centers.data(), sizes.data(), box);
+
+    OctreeNsView<T, KeyType> tree{octree.numLeafNodes,
+                                  octree.prefixes.data(),
+                                  octree.childOffsets.data(),
+                                  octree.internalToLeaf.data(),
+                                  octree.levelRange.data(),
+                                  nullptr,
+                                  layout.data(),
+                                  centers.data(),
+                                  sizes.data()};
+
+    std::vector<LocalIndex> reference;
+    for (LocalIndex i = first; i < last; ++i)
+    {
+        if (insideRegion(region, Vec3<T>{x[i], y[i], z[i]}, box)) { reference.push_back(i); }
+    }
+    EXPECT_GT(reference.size(), 0);
+
+    std::vector<LocalIndex> found;
+    forEachInRegion(tree, region, box, first, last, x, y, z, [&found](LocalIndex i) { found.push_back(i); });
+    EXPECT_EQ(found, reference);
+
+    // only a fraction of the particles is tested
+    LocalIndex numTested = 0;
+    for (auto range : regionParticleRanges(tree, region, box, first, last))
+    {
+        EXPECT_LE(first, range.start());
+        EXPECT_LE(range.end(), last);
+        numTested += range.count();
+    }
+    EXPECT_LT(numTested, (last - first) / 2);
+}
+
+template<class KeyType>
+void regionQueries()
+{
+    using T = double;
+    Box<T> open(-1, 1);
+    Box<T> periodic(-1, 1, BoundaryType::periodic);
+
+    SphereRegion<T> sphere{{0.2, -0.3, 0.1}, 0.3};
+    SphereRegion<T> cornerSphere{{0.95, 0.95, -0.95}, 0.3};
+    BoxRegion<T> slab{{0.0, 0.0, 0.9}, {1.0, 1.0, 0.15}};
+    CylinderRegion<T> cylinder{{0.5, -0.5, 0.0}, 0.2, 1.0, 2};
+    CylinderRegion<T> wrappedCylinder{{-1.0, 0.0, 0.5}, 0.25, 0.4, 1};
+
+    checkRegionQuery<KeyType>(open, sphere, 0, 5000);
+    checkRegionQuery<KeyType>(open, cornerSphere, 0, 5000);
+    checkRegionQuery<KeyType>(open, slab, 0, 5000);
+    checkRegionQuery<KeyType>(open, cylinder, 1000, 4000);
+
+    // regions that extend across periodic boundaries also contain particles from the opposite side of the box
+    checkRegionQuery<KeyType>(periodic, cornerSphere, 0, 5000);
+    checkRegionQuery<KeyType>(periodic, slab, 0, 5000);
+    checkRegionQuery<KeyType>(periodic, wrappedCylinder, 500, 5000);
+}
+
+TEST(RegionQuery, sphereBoxCylinder)
+{
+    regionQueries<unsigned>();
+    regionQueries<uint64_t>();
+}
+
+TEST(RegionQuery, periodicImages)
+{
+    using T = double;
+    Box<T> periodic(0, 1, BoundaryType::periodic);
+    SphereRegion<T> sphere{{0.05, 0.5, 0.5}, 0.1};
+
+    EXPECT_TRUE(insideRegion(sphere, Vec3<T>{0.98, 0.5, 0.5}, periodic));
+    EXPECT_FALSE(insideRegion(sphere, Vec3<T>{0.98, 0.5, 0.5}, Box<T>(0, 1)));
+
+    CylinderRegion<T> cylinder{{0.5, 0.5, 0.5}, 0.1, 0.2, 0};
+    EXPECT_TRUE(insideRegion(cylinder, Vec3<T>{0.69, 0.55, 0.45}, periodic));
+    EXPECT_FALSE(insideRegion(cylinder, Vec3<T>{0.71, 0.5, 0.5}, periodic));
+    EXPECT_FALSE(insideRegion(cylinder, Vec3<T>{0.5, 0.5, 0.61}, periodic));
+}
@@ -0,0 +1,192 @@
+/*
+ * Cornerstone octree
+ *
+ * Copyright (c) 2024 CSCS, ETH Zurich, University of Zurich, 2021 University of Basel
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: MIT License
+ */
+
+/*! @file
+ * @brief Scratch arena tests
+ */
+
+#include <numeric>
+#include <optional>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "cstone/util/scratch_arena.hpp"
+
+using namespace cstone;
+
+TEST(ScratchArena, frames)
+{
+    ScratchArena arena;
+    {
+        auto frame = arena.frame();
+        auto a     = arena.allocate<int>(100);
+        EXPECT_EQ(a.size(), 100);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(a.data()) % 64, 0);
+        std::iota(a.begin(), a.end(), 0);
+
+        {
+            auto innerFrame = arena.frame();
+            auto b          = arena.allocate<double>(10);
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(b.data()) % 64, 0);
+            EXPECT_GE((char*)b.data(), (char*)(a.data() + a.size()));
+            EXPECT_EQ(arena.bytesInUse(), 448 + 128);
+        }
+        EXPECT_EQ(arena.bytesInUse(), 448);
+
+        auto c = arena.allocate<char>(1);
+        EXPECT_EQ(arena.bytesInUse(), 448 + 64);
+
+        EXPECT_EQ(a[0], 0);
+        EXPECT_EQ(a[99], 99);
+        (void)c;
+    }
+    EXPECT_EQ(arena.bytesInUse(), 0);
+    EXPECT_EQ(arena.highWaterMark(), 448 + 128);
+}
+
+TEST(ScratchArena, movedFrame)
+{
+    ScratchArena arena;
+    std::optional<ScratchArena::Frame> outer;
+    {
+        auto frame = arena.frame();
+        auto a     = arena.allocate<int>(100);
+        outer.emplace(std::move(frame));
+        (void)a;
+    }
+    EXPECT_EQ(arena.bytesInUse(), 448);
+
+    outer.reset();
+    EXPECT_EQ(arena.bytesInUse(), 0);
+}
+
+TEST(ScratchArena, coalesce)
+{
+    ScratchArena arena;
+    size_t blockBytes = size_t(1) << 20;
+    {
+        auto frame = arena.frame();
+        auto a     = arena.allocate<char>(blockBytes);
+        auto b     = arena.allocate<char>(3 * blockBytes);
+        auto c     = arena.allocate<char>(blockBytes);
+        EXPECT_EQ(arena.numBlocks(), 3);
+        (void)a, (void)b, (void)c;
+
+        {
+            // reuses the space of c after the inner frame is released
+            auto inner = arena.frame();
+            auto d     = arena.allocate<char>(blockBytes);
+            (void)d;
+        }
+        EXPECT_EQ(arena.numBlocks(), 3);
+        EXPECT_EQ(arena.highWaterMark(), 6 * blockBytes);
+    }
+
+    // an empty arena merges its blocks into one that can hold the high-water mark
+    EXPECT_EQ(arena.numBlocks(), 1);
+    EXPECT_EQ(arena.capacity(), 6 * blockBytes);
+
+    {
+        auto frame = arena.frame();
+        auto a     = arena.allocate<char>(2 * blockBytes);
+        auto b     = arena.allocate<char>(4 * blockBytes);
+        EXPECT_EQ(b.data(), a.data() + a.size());
+    }
+    EXPECT_EQ(arena.numBlocks(), 1);
+}
+
+TEST(ScratchArena, threadLocal)
+{
+    ScratchArena* mainArena  = &scratchArena();
+    ScratchArena* otherArena = nullptr;
+
+    std::thread worker([&otherArena]() { otherArena = &scratchArena(); });
+    worker.join();
+
+    EXPECT_NE(otherArena, mainArena);
+    EXPECT_EQ(&scratchArena(), mainArena);
+}
+
+TEST(ScratchArena, trim)
+{
+    ScratchArena arena;
+    size_t blockBytes = size_t(1) << 20;
+    {
+        auto frame = arena.frame();
+        auto a     = arena.allocate<char>(8 * blockBytes);
+        (void)a;
+    }
+    EXPECT_EQ(arena.capacity(), 8 * blockBytes);
+
+    // the peak since the last trim still needs all of the capacity
+    arena.trim();
+    EXPECT_EQ(arena.capacity(), 8 * blockBytes);
+
+    {
+        auto frame = arena.frame();
+        auto a     = arena.allocate<char>(3 * blockBytes);
+        (void)a;
+    }
+    arena.trim();
+    EXPECT_EQ(arena.capacity(), 3 * blockBytes);
+    EXPECT_EQ(arena.numBlocks(), 1);
+    EXPECT_EQ(arena.highWaterMark(), 8 * blockBytes);
+
+    // without any use since the last trim, all storage is released
+    arena.trim();
+    EXPECT_EQ(arena.capacity(), 0);
+
+    {
+        auto frame = arena.frame();
+        auto a     = arena.allocate<char>(blockBytes);
+        EXPECT_EQ(arena.numBlocks(), 1);
+        (void)a;
+    }
+
+    // a shrunk arena keeps at least the minimum block size
+    {
+        auto frame = arena.frame();
+        auto a     = arena.allocate<char>(3 * blockBytes);
+        (void)a;
+    }
+    arena.trim();
+    {
+        auto frame = arena.frame();
+        auto a     = arena.allocate<char>(4096);
+        (void)a;
+    }
+    arena.trim();
+    EXPECT_EQ(arena.capacity(), blockBytes);
+}
+
+TEST(ScratchArena, allThreads)
+{
+    size_t blockBytes = size_t(1) << 20;
+    size_t mainPeak   = scratchHighWaterMark();
+
+    std::thread worker(
+        [blockBytes, mainPeak]()
+        {
+            {
+                auto frame = scratchArena().frame();
+                auto a     = scratchArena().allocate<char>(mainPeak + 4 * blockBytes);
+                (void)a;
+            }
+            EXPECT_EQ(scratchHighWaterMark(), mainPeak + 4 * blockBytes);
+
+            trimScratchArenas();
+            trimScratchArenas();
+            EXPECT_EQ(scratchArena().capacity(), 0);
+        });
+    worker.join();
+
+    // the arena of the exited thread is no longer listed
+    EXPECT_EQ(scratchHighWaterMark(), mainPeak);
+}
@@ -82,6 +82,10 @@ std::unique_ptr<ISimInitializer<Dataset>> initializerFactory(std::string testCas
         if (glassBlock.empty()) { throw std::runtime_error("need a valid glass block for turbulence test\n"); }
         else { return SimInitializers<Dataset>::makeTurbulence(glassBlock, settingsFile, reader); }
     }
+    if (testNamedBase == "kelvin-helmholtz-2d")
+    {
+        return SimInitializers<Dataset>::makeKelvinHelmholtz2D(settingsFile, reader);
+    }
     if (testNamedBase == "kelvin-helmholtz")
     {
         if (glassBlock.empty()) { throw std::runtime_error("need a valid glass block for Kelvin-Helmholtz test\n"); }
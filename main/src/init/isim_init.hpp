@@ -66,6 +66,7 @@ struct SimInitializers
     static InitPtr makeFileSplit(std::string testCase, int numsplits, IFileReader* reader);
     static InitPtr makeGreshoChan(std::string glassBlock, std::string settingsFile, IFileReader* reader);
     static InitPtr makeKelvinHelmholtz(std::string glassBlock, std::string settingsFile, IFileReader* reader);
+    static InitPtr makeKelvinHelmholtz2D(std::string settingsFile, IFileReader* reader);
     static InitPtr makeIsobaricCube(std::string glassBlock, std::string settingsFile, IFileReader* reader);
     static InitPtr makeNoh(std::string glassBlock, std::string settingsFile, IFileReader* reader);
     static InitPtr makeSedovGlass(std::string glassBlock, std::string settingsFile, IFileReader* reader);
@@ -74,7 +75,11 @@ struct SimInitializers
     static InitPtr makeWindShock(std::string glassBlock, std::string settingsFile, IFileReader* reader);
 };
 
-extern template struct SimInitializers<SimulationData<cstone::CpuTag>>;
-extern template struct SimInitializers<SimulationData<cstone::GpuTag>>;
+#define EXTERN_SIM_INITIALIZERS(Types)                                                                                 \
+    extern template struct SimInitializers<SimulationData<cstone::CpuTag, Types>>;                                     \
+    extern template struct SimInitializers<SimulationData<cstone::GpuTag, Types>>
+
+SPH_EXA_FOR_EACH_TYPE_CONFIG(EXTERN_SIM_INITIALIZERS);
+#undef EXTERN_SIM_INITIALIZERS
 
 } // namespace sphexa
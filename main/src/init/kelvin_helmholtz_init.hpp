@@ -51,6 +51,18 @@ InitSettings KelvinHelmholtzConstants()
             {"gravConstant", 0.0}, {"kelvin-helmholtz", 1.0}};
 }
 
+//! @brief planar Kelvin-Helmholtz test with 2D SPH kernels, no glass block and fewer neighbors
+InitSettings KelvinHelmholtz2DConstants()
+{
+    InitSettings ret = KelvinHelmholtzConstants();
+    // the growth rate observable requires volume elements, which the 2D propagator does not compute
+    ret.erase("kelvin-helmholtz");
+    ret["ng0"]    = 30;
+    ret["ngmax"]  = 60;
+    ret["numDim"] = 2;
+    return ret;
+}
+
 template<class T, class Dataset>
 void initKelvinHelmholtzFields(Dataset& d, const std::map<std::string, double>& constants, T massPart)
 {
@@ -67,8 +79,14 @@ void initKelvinHelmholtzFields(Dataset& d, const std::map<std::string, double>&
     T vDif = 0.5 * (vxExt - vxInt);
     T ls   = 0.025;
 
-    T hInt = 0.5 * std::cbrt(3. * d.ng0 * massPart / 4. / M_PI / rhoInt);
-    T hExt = 0.5 * std::cbrt(3. * d.ng0 * massPart / 4. / M_PI / rhoExt);
+    // smoothing length for ng0 neighbors within a radius of 2h
+    auto hFromDensity = [&d, massPart](T rho) -> T
+    {
+        if (d.numDim == 2) { return 0.5 * std::sqrt(d.ng0 * massPart / M_PI / rho); }
+        return 0.5 * std::cbrt(3. * d.ng0 * massPart / 4. / M_PI / rho);
+    };
+    T hInt = hFromDensity(rhoInt);
+    T hExt = hFromDensity(rhoExt);
 
     std::fill(d.m.begin(), d.m.end(), massPart);
     std::fill(d.du_m1.begin(), d.du_m1.end(), 0.0);
@@ -207,4 +225,98 @@ public:
     [[nodiscard]] const InitSettings& constants() const override { return settings_; }
 };
 
+/*! @brief number of halvings k of the lattice density in the low density layers, rhoInt / rhoExt = 2^k
+ *
+ * Thinning the lattice of the high density band keeps all particle masses equal. Other density ratios cannot be
+ * represented by a thinned lattice and are rejected.
+ */
+inline int kelvinHelmholtz2DThinning(const InitSettings& settings)
+{
+    double densityRatio = settings.at("rhoInt") / settings.at("rhoExt");
+    int    thinning     = std::lround(std::log2(densityRatio));
+    if (thinning < 0 || std::abs(std::ldexp(1.0, thinning) - densityRatio) > 1e-10 * densityRatio)
+    {
+        throw std::runtime_error("kelvin-helmholtz-2d requires rhoInt / rhoExt to be a power of 2, got " +
+                                 std::to_string(densityRatio) + "\n");
+    }
+    return thinning;
+}
+
+/*! @brief planar Kelvin-Helmholtz initial conditions for 2D SPH kernels
+ *
+ * All particles are placed on a square lattice in the plane z = 0.5 of a periodic unit cube. The high density band
+ * uses every lattice point. For rhoInt / rhoExt = 2^k, the low density layers only keep the points of a sublattice
+ * with spacing 2^(k/2). For odd k, the sublattice is additionally thinned to points with an even index sum, which
+ * forms a square lattice rotated by 45 degrees. This avoids the need for a relaxed glass.
+ */
+template<class Dataset>
+class KelvinHelmholtz2D : public ISimInitializer<Dataset>
+{
+    mutable InitSettings settings_;
+    int                  thinning_;
+
+public:
+    KelvinHelmholtz2D(std::string settingsFile, IFileReader* reader)
+    {
+        Dataset d;
+        settings_ = buildSettings(d, KelvinHelmholtz2DConstants(), settingsFile, reader);
+        thinning_ = kelvinHelmholtz2DThinning(settings_);
+    }
+
+    /*! @brief initialize a square lattice with @p side points per dimension in the high density band
+     *
+     * @p side is rounded up to a multiple of 2^(k+1), at least 4, such that the edges of the band coincide with planes
+     * of the thinned lattice.
+     */
+    cstone::Box<typename Dataset::RealType> init(int rank, int numRanks, size_t side, Dataset& simData,
+                                                 IFileReader*) const override
+    {
+        using KeyType = typename Dataset::KeyType;
+        using T       = typename Dataset::RealType;
+        auto& d       = simData.hydro;
+        auto  pbc     = cstone::BoundaryType::periodic;
+
+        size_t multiple = std::max(size_t(4), size_t(2) << thinning_);
+        side            = (side + multiple - 1) / multiple * multiple;
+        cstone::Box<T> globalBox(0, 1, pbc);
+
+        size_t spacing   = size_t(1) << (thinning_ / 2);
+        bool   rotated   = thinning_ % 2;
+        auto   keepOuter = [spacing, rotated](size_t i, size_t j)
+        { return i % spacing == 0 && j % spacing == 0 && (!rotated || (i / spacing + j / spacing) % 2 == 0); };
+
+        T step = T(1) / side;
+        auto [firstRow, lastRow] = partitionRange(side, rank, numRanks);
+        for (size_t j = firstRow; j < lastRow; ++j)
+        {
+            bool inBand = (j >= side / 4 && j < 3 * side / 4);
+            for (size_t i = 0; i < side; ++i)
+            {
+                if (!inBand && !keepOuter(i, j)) { continue; }
+                d.x.push_back((i + T(0.5)) * step);
+                d.y.push_back((j + T(0.5)) * step);
+                d.z.push_back(T(0.5));
+            }
+        }
+
+        size_t numParticlesGlobal = side * side / 2 + (side * side / 2 >> thinning_);
+        syncCoords<KeyType>(rank, numRanks, numParticlesGlobal, d.x, d.y, d.z, globalBox);
+        d.resize(d.x.size());
+
+        // the band of area 0.5 contains side^2 / 2 particles, the low density layers 2^k times fewer per area
+        T particleMass = T(0.5) * settings_.at("rhoInt") / (side * side / 2);
+
+        settings_["numParticlesGlobal"] = double(numParticlesGlobal);
+        BuiltinWriter attributeSetter(settings_);
+        d.loadOrStoreAttributes(&attributeSetter);
+
+        if (d.numDim != 2) { throw std::runtime_error("kelvin-helmholtz-2d requires numDim = 2\n"); }
+        initKelvinHelmholtzFields(d, settings_, particleMass);
+
+        return globalBox;
+    }
+
+    [[nodiscard]] const InitSettings& constants() const override { return settings_; }
+};
+
 } // namespace sphexa
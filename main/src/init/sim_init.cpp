@@ -101,6 +101,13 @@ SimInitializers<Dataset>::makeKelvinHelmholtz(std::string glassBlock, std::strin
     return std::make_unique<KelvinHelmholtzGlass<Dataset>>(glassBlock, settingsFile, reader);
 }
 
+template<class Dataset>
+std::unique_ptr<ISimInitializer<Dataset>>
+SimInitializers<Dataset>::makeKelvinHelmholtz2D(std::string settingsFile, IFileReader* reader)
+{
+    return std::make_unique<KelvinHelmholtz2D<Dataset>>(settingsFile, reader);
+}
+
 template<class Dataset>
 std::unique_ptr<ISimInitializer<Dataset>>
 SimInitializers<Dataset>::makeIsobaricCube(std::string glassBlock, std::string settingsFile, IFileReader* reader)
@@ -142,10 +149,15 @@ SimInitializers<Dataset>::makeWindShock(std::string glassBlock, std::string sett
     return std::make_unique<WindShockGlass<Dataset>>(glassBlock, settingsFile, reader);
 }
 
+#define SIM_INITIALIZERS(AccType, Types)                                                                               \
+    template struct SimInitializers<SimulationData<AccType, Types>>
+#define SIM_INITIALIZERS_CPU(Types) SIM_INITIALIZERS(cstone::CpuTag, Types)
+#define SIM_INITIALIZERS_GPU(Types) SIM_INITIALIZERS(cstone::GpuTag, Types)
+
 #ifdef USE_CUDA
-template struct SimInitializers<SimulationData<cstone::GpuTag>>;
+SPH_EXA_FOR_EACH_TYPE_CONFIG(SIM_INITIALIZERS_GPU);
 #else
-template struct SimInitializers<SimulationData<cstone::CpuTag>>;
+SPH_EXA_FOR_EACH_TYPE_CONFIG(SIM_INITIALIZERS_CPU);
 #endif
 
 } // namespace sphexa
@@ -31,12 +31,14 @@
 
 #pragma once
 
+#include <array>
 #include <map>
 #include <cmath>
 #include <algorithm>
 
 #include "cstone/sfc/box.hpp"
 #include "sph/eos.hpp"
+#include "sph/hydro_turb/initial_velocity.hpp"
 
 #include "isim_init.hpp"
 #include "grid.hpp"
@@ -67,6 +69,7 @@ InitSettings TurbulenceConstants()
             {"gravConstant", 0.0},
             {"ng0", 100},
             {"ngmax", 150},
+            {"stInitVelocity", 0.0},
             {"turbulence", 1.0}};
 }
 
@@ -96,6 +99,57 @@ void initTurbulenceHydroFields(Dataset& d, const std::map<std::string, double>&
     generateParticleIDs(d.id);
 }
 
+/*! @brief overwrite particle velocities with a Gaussian random field of global rms velocity stInitVelocity
+ *
+ * The field has the spectrum of the stirring modes (stSpectForm, powerLawExp, anglesExp) and the solenoidal weight
+ * solWeight. Phases are drawn on all ranks from sph::initialVelocityEngine, which derives its state from rngSeed and a
+ * stream tag, such that the initial field is independent of the forcing. A value of zero for stInitVelocity starts
+ * from rest.
+ */
+template<class Dataset>
+void initTurbulenceVelocities(Dataset& d, const std::map<std::string, double>& constants, MPI_Comm comm)
+{
+    using T = typename Dataset::RealType;
+
+    double vRms = constants.at("stInitVelocity");
+    if (vRms <= 0) { return; }
+
+    sph::TurbulenceData<T, cstone::CpuTag> turb(constants, false);
+    std::mt19937                           gen = sph::initialVelocityEngine(uint32_t(constants.at("rngSeed")));
+    sph::turbulentVelocityField(0, d.x.size(), d.x.data(), d.y.data(), d.z.data(), d.vx.data(), d.vy.data(),
+                                d.vz.data(), turb, gen);
+
+    // remove the net momentum and rescale to the requested rms velocity, particles have equal masses
+    double sumVx = 0, sumVy = 0, sumVz = 0, sumV2 = 0;
+#pragma omp parallel for reduction(+ : sumVx, sumVy, sumVz, sumV2)
+    for (size_t i = 0; i < d.x.size(); ++i)
+    {
+        sumVx += d.vx[i];
+        sumVy += d.vy[i];
+        sumVz += d.vz[i];
+        sumV2 += d.vx[i] * d.vx[i] + d.vy[i] * d.vy[i] + d.vz[i] * d.vz[i];
+    }
+    std::array<double, 5> sums{sumVx, sumVy, sumVz, sumV2, double(d.x.size())};
+    MPI_Allreduce(MPI_IN_PLACE, sums.data(), sums.size(), MPI_DOUBLE, MPI_SUM, comm);
+
+    T meanVx = sums[0] / sums[4];
+    T meanVy = sums[1] / sums[4];
+    T meanVz = sums[2] / sums[4];
+    T scale  = vRms / std::sqrt(sums[3] / sums[4] - meanVx * meanVx - meanVy * meanVy - meanVz * meanVz);
+
+    double minDt = constants.at("minDt");
+#pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < d.x.size(); ++i)
+    {
+        d.vx[i]   = (d.vx[i] - meanVx) * scale;
+        d.vy[i]   = (d.vy[i] - meanVy) * scale;
+        d.vz[i]   = (d.vz[i] - meanVz) * scale;
+        d.x_m1[i] = d.vx[i] * minDt;
+        d.y_m1[i] = d.vy[i] * minDt;
+        d.z_m1[i] = d.vz[i] * minDt;
+    }
+}
+
 template<class Dataset>
 class TurbulenceGlass : public ISimInitializer<Dataset>
 {
@@ -138,6 +192,7 @@ public:
         d.loadOrStoreAttributes(&attributeSetter);
 
         initTurbulenceHydroFields(d, settings_);
+        initTurbulenceVelocities(d, settings_, simData.comm);
 
         return globalBox;
     }
@@ -68,11 +68,11 @@ void sortBySfcKey(std::vector<T>& x, std::vector<T>& y, std::vector<T>& z)
     std::swap(z, buffer);
 }
 
-//! @brief read x,y,z coordinates from an H5Part file (at step 0)
+//! @brief read x,y,z coordinates from the last step of an H5Part file on the first rank and broadcast them
 template<class Vector>
 void readTemplateBlock(const std::string& block, IFileReader* reader, Vector& x, Vector& y, Vector& z)
 {
-    reader->setStep(block, -1, FileMode::independent);
+    reader->setStep(block, -1, FileMode::broadcast);
     size_t blockSize = reader->numParticles();
     x.resize(blockSize);
     y.resize(blockSize);
@@ -90,7 +90,7 @@ void readFileAttributes(InitSettings& settings, const std::string& settingsFile,
 {
     if (not settingsFile.empty())
     {
-        reader->setStep(settingsFile, -1, FileMode::independent);
+        reader->setStep(settingsFile, -1, FileMode::broadcast);
 
         auto fileAttributes = reader->fileAttributes();
         for (const auto& attr : fileAttributes)
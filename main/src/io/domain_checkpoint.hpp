@@ -0,0 +1,161 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 CSCS, ETH Zurich
+ *               2024 University of Basel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*! @file
+ * @brief Save and restore the domain decomposition alongside checkpoints
+ *
+ * The global tree leaves, their particle counts and the rank that owns each leaf are stored in a separate file
+ * next to the checkpoint, with one step per checkpoint. On a restart, the domain is warm-started from the matching
+ * step, which skips the convergence of the global tree and of the assignment and starts the focus tree from the
+ * global leaves in the local SFC range.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "cstone/sfc/common.hpp"
+#include "ifile_io.hpp"
+
+namespace sphexa
+{
+
+//! @brief the file holding the domain state of the checkpoints in @p checkpointFile
+inline std::string domainCheckpointPath(const std::string& checkpointFile)
+{
+    std::filesystem::path path(checkpointFile);
+    return (path.parent_path() / (path.stem().string() + "_domain" + path.extension().string())).string();
+}
+
+/*! @brief append the global tree and assignment of @p domain as a new step to @p path
+ *
+ * The leaf arrays are replicated on all ranks, each rank of @p writer writes a contiguous part of them. With a writer
+ * on MPI_COMM_SELF, the calling rank writes all of them.
+ */
+template<class Domain>
+void writeDomainCheckpoint(const Domain& domain, uint64_t iteration, const std::string& path, IFileWriter* writer)
+{
+    auto leaves     = domain.globalTree().treeLeaves();
+    auto counts     = domain.globalCounts();
+    auto assignment = domain.assignment();
+
+    size_t   numLeaves  = counts.size();
+    uint64_t numRanks   = domain.numRanks();
+    uint64_t numWriters = writer->numRanks();
+    // steps are only created on ranks with a non-empty range
+    if (numLeaves < numWriters)
+    {
+        if (writer->rank() == 0)
+        {
+            std::cout << "Skipping domain checkpoint of iteration " << iteration << ": the global tree has "
+                      << numLeaves << " leaves for " << numWriters << " writing ranks, a restart from this "
+                      << "iteration will cold-start the domain" << std::endl;
+        }
+        return;
+    }
+
+    std::vector<int> leafRanks(numLeaves);
+    for (size_t i = 0; i < numLeaves; ++i)
+    {
+        leafRanks[i] = std::upper_bound(assignment.begin(), assignment.end(), leaves[i]) - assignment.begin() - 1;
+    }
+
+    size_t first = writer->rank() * numLeaves / numWriters;
+    size_t last  = (writer->rank() + 1) * numLeaves / numWriters;
+
+    writer->addStep(first, last, path);
+    writer->stepAttribute("iteration", &iteration, 1);
+    writer->stepAttribute("numRanks", &numRanks, 1);
+    writer->writeField("treeLeaves", leaves.data(), 0);
+    writer->writeField("nodeCounts", counts.data(), 1);
+    writer->writeField("rank", leafRanks.data(), 2);
+    writer->closeStep();
+}
+
+/*! @brief warm-start @p domain from step @p step in @p path if it was written at @p iteration
+ *
+ * @return true if the domain was warm-started
+ *
+ * If the number of ranks differs from the stored one, only the global tree is restored and the SFC is re-split
+ * into ranges of equal particle counts. A missing file or a step written at a different iteration leaves the
+ * domain untouched, i.e. it will be cold-started in the first sync.
+ */
+template<class Domain>
+bool readDomainCheckpoint(Domain& domain, uint64_t iteration, const std::string& path, int step, IFileReader* reader)
+{
+    using KeyType = typename std::decay_t<decltype(domain.assignment())>::value_type;
+
+    if (!std::filesystem::exists(path)) { return false; }
+
+    reader->setStep(path, step, FileMode::broadcast);
+
+    auto attributes = reader->stepAttributes();
+    if (std::find(attributes.begin(), attributes.end(), "iteration") == attributes.end())
+    {
+        reader->closeStep();
+        return false;
+    }
+
+    uint64_t stepIteration = 0, stepRanks = 0;
+    reader->stepAttribute("iteration", &stepIteration, 1);
+    reader->stepAttribute("numRanks", &stepRanks, 1);
+    if (stepIteration != iteration)
+    {
+        reader->closeStep();
+        return false;
+    }
+
+    size_t numLeaves = reader->localNumParticles();
+    std::vector<KeyType> leaves(numLeaves + 1);
+    std::vector<unsigned> counts(numLeaves);
+    std::vector<int> leafRanks(numLeaves);
+    reader->readField("treeLeaves", leaves.data());
+    reader->readField("nodeCounts", counts.data());
+    reader->readField("rank", leafRanks.data());
+    reader->closeStep();
+    leaves.back() = cstone::nodeRange<KeyType>(0);
+
+    int numRanks = domain.numRanks();
+    std::vector<KeyType> assignment;
+    if (stepRanks == uint64_t(numRanks))
+    {
+        // the first key of each rank is the first leaf that belongs to it or to a higher rank
+        assignment.resize(numRanks + 1);
+        for (int r = 0; r <= numRanks; ++r)
+        {
+            size_t firstLeaf = std::lower_bound(leafRanks.begin(), leafRanks.end(), r) - leafRanks.begin();
+            assignment[r]    = leaves[firstLeaf];
+        }
+    }
+
+    domain.warmStart(leaves, counts, assignment);
+    return true;
+}
+
+} // namespace sphexa
@@ -34,6 +34,8 @@
 #include <string>
 #include <vector>
 
+#include <mpi.h>
+
 #include "cstone/util/type_list.hpp"
 #include "cstone/util/tuple_util.hpp"
 
@@ -73,8 +73,12 @@ public:
 
 enum class FileMode
 {
-    collective  = 0,
+    //! ranks read disjoint parts of the particle fields
+    collective = 0,
+    //! every rank reads all particles from the file
     independent = 1,
+    //! the first rank reads all particles and broadcasts them, such that only one rank accesses the file system
+    broadcast = 2,
 };
 
 class IFileReader
@@ -30,7 +30,10 @@
 
 #include <mpi.h>
 
+#include <algorithm>
 #include <filesystem>
+#include <limits>
+#include <stdexcept>
 #include <string>
 #include <variant>
 #include <vector>
@@ -164,6 +167,7 @@ public:
     [[nodiscard]] int     rank() const override { return rank_; }
     [[nodiscard]] int64_t numParticles() const override
     {
+        if (mode_ == FileMode::broadcast) { return globalCount_; }
         if (!h5File_) { throw std::runtime_error("Cannot get number of particles: file not open\n"); }
         return H5PartGetNumParticles(h5File_);
     }
@@ -173,21 +177,25 @@ public:
      * @param path  filesystem path
      * @param step  snapshot index to load from
      * @param mode  collective mode causes MPI ranks to distribute particles amongst themselves,
-     *              independent mode causes all MPI ranks to load all particles
+     *              independent mode causes all MPI ranks to load all particles,
+     *              broadcast mode loads all particles on all ranks, but only the first rank opens the file
      */
     void setStep(std::string path, int step, FileMode mode) override
     {
         closeStep();
-        pathStep_ = path;
-        h5File_   = fileutils::openH5Part(path, H5PART_READ | H5PART_VFD_MPIIO_IND, comm_);
-
-        if (H5PartGetNumSteps(h5File_) == 0) { return; }
+        pathStep_    = path;
+        mode_        = mode;
+        globalCount_ = 0;
 
-        // set step to last step in file if negative
-        if (step < 0) { step = H5PartGetNumSteps(h5File_) - 1; }
-        H5PartSetStep(h5File_, step);
+        if (mode == FileMode::broadcast)
+        {
+            onRoot([this, &path, step]() { openStep(path, step, MPI_COMM_SELF); });
+            MPI_Bcast(&globalCount_, 1, MPI_UINT64_T, 0, comm_);
+            std::tie(firstIndex_, lastIndex_, localCount_) = std::make_tuple(0, globalCount_, globalCount_);
+            return;
+        }
 
-        globalCount_ = H5PartGetNumParticles(h5File_);
+        openStep(path, step, comm_);
         if (globalCount_ < 1) { return; }
 
         int rank, numRanks;
@@ -205,60 +213,102 @@ public:
 
     std::vector<std::string> fileAttributes() override
     {
-        if (h5File_) { return fileutils::fileAttributeNames(h5File_); }
-        else { throw std::runtime_error("Cannot read file attributes: file not opened\n"); }
+        std::vector<std::string> names;
+        onRoot(
+            [this, &names]()
+            {
+                if (h5File_) { names = fileutils::fileAttributeNames(h5File_); }
+                else { throw std::runtime_error("Cannot read file attributes: file not opened\n"); }
+            });
+        broadcastNames(names);
+        return names;
     }
 
     std::vector<std::string> stepAttributes() override
     {
-        if (h5File_) { return fileutils::stepAttributeNames(h5File_); }
-        else { throw std::runtime_error("Cannot read file attributes: file not opened\n"); }
+        std::vector<std::string> names;
+        onRoot(
+            [this, &names]()
+            {
+                if (h5File_) { names = fileutils::stepAttributeNames(h5File_); }
+                else { throw std::runtime_error("Cannot read file attributes: file not opened\n"); }
+            });
+        broadcastNames(names);
+        return names;
     }
 
     int64_t fileAttributeSize(const std::string& key) override
     {
-        int64_t attrIndex = fileAttributeIndex(key);
-        int64_t typeId, attrSize;
-        char    dummy[256];
-        H5PartGetFileAttribInfo(h5File_, attrIndex, dummy, 256, &typeId, &attrSize);
+        int64_t attrSize = 0;
+        onRoot(
+            [this, &key, &attrSize]()
+            {
+                int64_t attrIndex = fileAttributeIndex(key);
+                int64_t typeId;
+                char    dummy[256];
+                H5PartGetFileAttribInfo(h5File_, attrIndex, dummy, 256, &typeId, &attrSize);
+            });
+        broadcastBytes(&attrSize, 1);
         return attrSize;
     }
 
     int64_t stepAttributeSize(const std::string& key) override
     {
-        int64_t attrIndex = stepAttributeIndex(key);
-        int64_t typeId, attrSize;
-        char    dummy[256];
-        H5PartGetStepAttribInfo(h5File_, attrIndex, dummy, 256, &typeId, &attrSize);
+        int64_t attrSize = 0;
+        onRoot(
+            [this, &key, &attrSize]()
+            {
+                int64_t attrIndex = stepAttributeIndex(key);
+                int64_t typeId;
+                char    dummy[256];
+                H5PartGetStepAttribInfo(h5File_, attrIndex, dummy, 256, &typeId, &attrSize);
+            });
+        broadcastBytes(&attrSize, 1);
         return attrSize;
     }
 
     void fileAttribute(const std::string& key, FieldType val, int64_t size) override
     {
-        std::visit(
-            [this, size, &key](auto arg)
+        onRoot(
+            [this, size, &key, val]()
             {
-                auto index = fileAttributeIndex(key);
-                fileutils::readH5PartFileAttribute(arg, size, index, h5File_);
-            },
-            val);
+                std::visit(
+                    [this, size, &key](auto arg)
+                    {
+                        auto index = fileAttributeIndex(key);
+                        fileutils::readH5PartFileAttribute(arg, size, index, h5File_);
+                    },
+                    val);
+            });
+        std::visit([this, size](auto arg) { broadcastBytes(arg, size); }, val);
     }
 
     void stepAttribute(const std::string& key, FieldType val, int64_t size) override
     {
-        std::visit(
-            [this, size, &key](auto arg)
+        onRoot(
+            [this, size, &key, val]()
             {
-                auto index = stepAttributeIndex(key);
-                fileutils::readH5PartStepAttribute(arg, size, index, h5File_);
-            },
-            val);
+                std::visit(
+                    [this, size, &key](auto arg)
+                    {
+                        auto index = stepAttributeIndex(key);
+                        fileutils::readH5PartStepAttribute(arg, size, index, h5File_);
+                    },
+                    val);
+            });
+        std::visit([this, size](auto arg) { broadcastBytes(arg, size); }, val);
     }
 
     void readField(const std::string& key, FieldType field) override
     {
-        auto err = std::visit([this, &key](auto arg) { return fileutils::readH5PartField(h5File_, key, arg); }, field);
-        if (err != H5PART_SUCCESS) { throw std::runtime_error("Could not read field: " + key); }
+        onRoot(
+            [this, &key, field]()
+            {
+                auto err = std::visit([this, &key](auto arg) { return fileutils::readH5PartField(h5File_, key, arg); },
+                                      field);
+                if (err != H5PART_SUCCESS) { throw std::runtime_error("Could not read field: " + key); }
+            });
+        std::visit([this](auto arg) { broadcastBytes(arg, localCount_); }, field);
     }
 
     uint64_t localNumParticles() override { return localCount_; }
@@ -275,6 +325,90 @@ public:
     }
 
 private:
+    //! @brief open @p path on @p comm, select @p step and set the global particle count
+    void openStep(const std::string& path, int step, MPI_Comm comm)
+    {
+        h5File_ = fileutils::openH5Part(path, H5PART_READ | H5PART_VFD_MPIIO_IND, comm);
+
+        if (H5PartGetNumSteps(h5File_) == 0) { return; }
+
+        // set step to last step in file if negative
+        if (step < 0) { step = H5PartGetNumSteps(h5File_) - 1; }
+        H5PartSetStep(h5File_, step);
+
+        globalCount_ = H5PartGetNumParticles(h5File_);
+    }
+
+    /*! @brief execute @p readFunc on the first rank only if in broadcast mode, otherwise on all ranks
+     *
+     * In broadcast mode, exceptions thrown on the first rank are rethrown on all ranks, such that no rank is left
+     * waiting in the subsequent broadcast.
+     */
+    template<class F>
+    void onRoot(F&& readFunc)
+    {
+        if (mode_ != FileMode::broadcast)
+        {
+            readFunc();
+            return;
+        }
+
+        std::vector<std::string> error;
+        if (rank_ == 0)
+        {
+            try
+            {
+                readFunc();
+            }
+            catch (const std::exception& e)
+            {
+                error.emplace_back(e.what());
+            }
+        }
+        broadcastNames(error);
+        if (!error.empty()) { throw std::runtime_error(error.front()); }
+    }
+
+    //! @brief in broadcast mode, copy @p count elements pointed to by @p data from the first rank to all ranks
+    template<class T>
+    void broadcastBytes(T* data, uint64_t count)
+    {
+        if (mode_ != FileMode::broadcast) { return; }
+
+        auto*    bytes    = reinterpret_cast<char*>(data);
+        uint64_t numBytes = count * sizeof(T);
+        uint64_t maxChunk = std::numeric_limits<int>::max();
+        for (uint64_t offset = 0; offset < numBytes; offset += maxChunk)
+        {
+            int chunk = std::min(maxChunk, numBytes - offset);
+            MPI_Bcast(bytes + offset, chunk, MPI_CHAR, 0, comm_);
+        }
+    }
+
+    //! @brief in broadcast mode, copy a list of strings from the first rank to all ranks
+    void broadcastNames(std::vector<std::string>& names)
+    {
+        if (mode_ != FileMode::broadcast) { return; }
+
+        std::string packed;
+        for (const auto& name : names)
+        {
+            packed += name + '\0';
+        }
+        uint64_t packedSize = packed.size();
+        broadcastBytes(&packedSize, 1);
+        packed.resize(packedSize);
+        broadcastBytes(packed.data(), packedSize);
+
+        names.clear();
+        for (size_t start = 0; start < packed.size();)
+        {
+            size_t end = packed.find('\0', start);
+            names.push_back(packed.substr(start, end - start));
+            start = end + 1;
+        }
+    }
+
     int64_t stepAttributeIndex(const std::string& key)
     {
         auto    attributes = fileutils::stepAttributeNames(h5File_);
@@ -293,10 +427,11 @@ private:
 
     int      rank_{0};
     MPI_Comm comm_;
+    FileMode mode_{FileMode::collective};
 
     uint64_t    firstIndex_, lastIndex_;
     uint64_t    localCount_;
-    uint64_t    globalCount_;
+    uint64_t    globalCount_{0};
     std::string pathStep_;
 
     H5PartFile* h5File_;
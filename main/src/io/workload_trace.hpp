@@ -0,0 +1,177 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 CSCS, ETH Zurich
+ *               2024 University of Basel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*! @file
+ * @brief Capture the workload of each rank at one step for offline replay
+ *
+ * Each rank writes its own trace file with a writer on MPI_COMM_SELF. The file contains the initial settings as file
+ * attributes and three steps:
+ *   - 0: a snapshot of the assigned particles with their conserved fields and SFC keys from the last sync, readable
+ *        as initial conditions with the FileInit initializer
+ *   - 1: the global tree and assignment, see writeDomainCheckpoint
+ *   - 2: the leaves of the focus tree of the rank and the domain parameters that determine its resolution
+ * Loading the traces of all ranks into a run with the same number of ranks reproduces the decomposition and
+ * particle distribution of the captured step.
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "cstone/sfc/common.hpp"
+#include "init/settings.hpp"
+#include "domain_checkpoint.hpp"
+#include "ifile_io.hpp"
+
+namespace sphexa
+{
+
+//! @brief the trace file of @p rank for traces named @p base
+inline std::string workloadTracePath(const std::string& base, int rank)
+{
+    return base + "_" + std::to_string(rank) + ".h5";
+}
+
+//! @brief domain parameters stored in a trace
+struct WorkloadTraceInfo
+{
+    uint64_t iteration{0};
+    uint64_t numRanks{0};
+    float    theta{0};
+    unsigned bucketSize{0};
+    unsigned bucketSizeFocus{0};
+};
+
+//! @brief write the conserved fields and SFC keys of @p d in [first:last] to the current step of @p writer
+template<class Dataset>
+void storeTraceDataset(IFileWriter* writer, size_t first, size_t last, Dataset& d)
+{
+    auto fieldPointers = d.data();
+    for (size_t i = 0; i < fieldPointers.size(); ++i)
+    {
+        bool isKeys = std::string(d.fieldNames[i]) == "keys";
+        if (!d.isConserved(i) && !(isKeys && d.isAllocated(i))) { continue; }
+
+        transferToHost(d, first, last, {d.fieldNames[i]});
+        std::visit([writer, key = Dataset::prefix + d.fieldNames[i], column = int(i)](auto field)
+                   { writer->writeField(key, field->data(), column); },
+                   fieldPointers[i]);
+    }
+}
+
+/*! @brief write the trace of the calling rank to @p path, replacing an existing file
+ *
+ * Must be called between two time-steps, i.e. with particles and domain in the state at the start of computeForces.
+ */
+template<class Domain, class SimulationData, class Propagator>
+void writeWorkloadTrace(const std::string& path, const InitSettings& settings, const Domain& domain,
+                        SimulationData& simData, Propagator& propagator, IFileWriter* writer)
+{
+    auto&  d     = simData.hydro;
+    size_t first = domain.startIndex();
+    size_t last  = domain.endIndex();
+
+    if (std::filesystem::exists(path)) { std::filesystem::remove(path); }
+    writeSettings(settings, path, writer);
+
+    auto box = domain.box();
+    writer->addStep(first, last, path);
+    d.loadOrStoreAttributes(writer);
+    box.loadOrStore(writer);
+    storeTraceDataset(writer, first, last, d);
+    storeTraceDataset(writer, first, last, simData.chem);
+    propagator.save(writer);
+    writer->closeStep();
+
+    writeDomainCheckpoint(domain, d.iteration, path, writer);
+
+    auto     focusLeaves     = domain.focusTree().treeLeaves();
+    uint64_t iteration       = d.iteration;
+    uint64_t numRanks        = domain.numRanks();
+    float    theta           = domain.theta();
+    unsigned bucketSize      = domain.bucketSize();
+    unsigned bucketSizeFocus = domain.bucketSizeFocus();
+
+    writer->addStep(0, focusLeaves.size() - 1, path);
+    writer->stepAttribute("iteration", &iteration, 1);
+    writer->stepAttribute("numRanks", &numRanks, 1);
+    writer->stepAttribute("theta", &theta, 1);
+    writer->stepAttribute("bucketSize", &bucketSize, 1);
+    writer->stepAttribute("bucketSizeFocus", &bucketSizeFocus, 1);
+    writer->writeField("focusLeaves", focusLeaves.data(), 0);
+    writer->closeStep();
+}
+
+//! @brief read the domain parameters of the trace in @p path
+inline WorkloadTraceInfo readWorkloadTraceInfo(const std::string& path, IFileReader* reader)
+{
+    if (!std::filesystem::exists(path)) { throw std::runtime_error("Workload trace " + path + " not found\n"); }
+
+    WorkloadTraceInfo info;
+    reader->setStep(path, 2, FileMode::independent);
+    reader->stepAttribute("iteration", &info.iteration, 1);
+    reader->stepAttribute("numRanks", &info.numRanks, 1);
+    reader->stepAttribute("theta", &info.theta, 1);
+    reader->stepAttribute("bucketSize", &info.bucketSize, 1);
+    reader->stepAttribute("bucketSizeFocus", &info.bucketSizeFocus, 1);
+    reader->closeStep();
+
+    return info;
+}
+
+/*! @brief warm-start the global and focus trees of @p domain from the trace in @p path
+ *
+ * The domain has to be constructed with the number of ranks and the parameters returned by readWorkloadTraceInfo.
+ */
+template<class Domain>
+void readWorkloadTrace(Domain& domain, const std::string& path, IFileReader* reader)
+{
+    using KeyType = typename std::decay_t<decltype(domain.assignment())>::value_type;
+
+    auto info = readWorkloadTraceInfo(path, reader);
+    if (info.numRanks != uint64_t(domain.numRanks()))
+    {
+        throw std::runtime_error("Workload trace " + path + " was captured with " + std::to_string(info.numRanks) +
+                                 " ranks\n");
+    }
+    if (!readDomainCheckpoint(domain, info.iteration, path, 1, reader))
+    {
+        throw std::runtime_error("Workload trace " + path + " does not contain a domain decomposition\n");
+    }
+
+    reader->setStep(path, 2, FileMode::independent);
+    std::vector<KeyType> focusLeaves(reader->localNumParticles() + 1);
+    reader->readField("focusLeaves", focusLeaves.data());
+    reader->closeStep();
+    focusLeaves.back() = cstone::nodeRange<KeyType>(0);
+
+    domain.warmStartFocus(focusLeaves);
+}
+
+} // namespace sphexa
@@ -0,0 +1,143 @@
+/*
+ * MIT License
+ *
+ * SPH-EXA
+ * Copyright (c) 2024 CSCS, ETH Zurich, University of Basel, University of Zurich
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*! @file
+ * @brief output L1 and L2 error norms of density, pressure and velocity against an analytical solution
+ *
+ * Replaces post-processing of snapshots with compare_*.py for the sedov, noh and gresho-chan test cases.
+ */
+
+#pragma once
+
+#include <functional>
+#include <mpi.h>
+
+#include "cstone/primitives/accel_switch.hpp"
+#include "cstone/primitives/mpi_wrappers.hpp"
+#include "cstone/util/array.hpp"
+#include "sph/eos.hpp"
+
+#include "io/file_utils.hpp"
+#include "analytical_profiles.hpp"
+#include "conserved_quantities.hpp"
+#include "gpu_reductions.h"
+#include "iobservables.hpp"
+
+namespace sphexa
+{
+
+//! @brief Observables that includes times, energies and L1/L2 errors against an analytical radial solution
+template<class Dataset>
+class AnalyticalErrors : public IObservables<Dataset>
+{
+    std::ostream& constantsFile;
+    //! @brief tabulates the analytical solution at the given time
+    std::function<RadialProfile(double)> solution_;
+    bool                                 cylindrical_;
+
+public:
+    AnalyticalErrors(std::ostream& constPath, std::function<RadialProfile(double)> solution, bool cylindrical)
+        : constantsFile(constPath)
+        , solution_(std::move(solution))
+        , cylindrical_(cylindrical)
+    {
+    }
+
+    using T = typename Dataset::RealType;
+
+    void computeAndWrite(Dataset& simData, size_t firstIndex, size_t lastIndex, const cstone::Box<T>& /*box*/) override
+    {
+        auto& d = simData.hydro;
+        computeConservedQuantities(firstIndex, lastIndex, d, simData.comm);
+
+        int rank;
+        MPI_Comm_rank(simData.comm, &rank);
+
+        // tabulating the solution can be expensive (Sedov), so it is done once and shared with all ranks
+        RadialProfile profile;
+        if (rank == 0) { profile = solution_(d.ttot); }
+        broadcastProfile(profile, simData.comm);
+
+        double cv = sph::idealGasCv(d.muiConst, d.gamma);
+
+        util::array<double, 6> localErrors;
+        if constexpr (cstone::HaveGpu<typename Dataset::AcceleratorType>{})
+        {
+            auto& dev   = d.devData;
+            localErrors = profileErrorsGpu(firstIndex, lastIndex, rawPtr(dev.x), rawPtr(dev.y), rawPtr(dev.z),
+                                           rawPtr(dev.vx), rawPtr(dev.vy), rawPtr(dev.vz), optionalPtr(dev.temp),
+                                           optionalPtr(dev.u), optionalPtr(dev.kx), optionalPtr(dev.xm),
+                                           optionalPtr(dev.rho), rawPtr(dev.m), profile, cv, d.gamma, cylindrical_);
+        }
+        else
+        {
+            localErrors = localProfileErrors(firstIndex, lastIndex, d.x.data(), d.y.data(), d.z.data(), d.vx.data(),
+                                             d.vy.data(), d.vz.data(), optionalPtr(d.temp), optionalPtr(d.u),
+                                             optionalPtr(d.kx), optionalPtr(d.xm), optionalPtr(d.rho), d.m.data(),
+                                             profile, cv, d.gamma, cylindrical_);
+        }
+
+        util::array<double, 6> errors;
+        MPI_Reduce(localErrors.data(), errors.data(), errors.size(), MpiType<double>{}, MPI_SUM, 0, simData.comm);
+
+        if (rank == 0)
+        {
+            double numParticles = d.numParticlesGlobal;
+            double L1rho        = errors[0] / numParticles;
+            double L2rho        = std::sqrt(errors[1] / numParticles);
+            double L1p          = errors[2] / numParticles;
+            double L2p          = std::sqrt(errors[3] / numParticles);
+            double L1v          = errors[4] / numParticles;
+            double L2v          = std::sqrt(errors[5] / numParticles);
+
+            fileutils::writeColumns(constantsFile, ' ', d.iteration, d.ttot, d.minDt, d.etot, d.ecin, d.eint, d.egrav,
+                                    d.linmom, d.angmom, L1rho, L2rho, L1p, L2p, L1v, L2v);
+        }
+    }
+
+private:
+    //! @brief replicate @p profile of rank 0 on all ranks of @p comm
+    static void broadcastProfile(RadialProfile& profile, MPI_Comm comm)
+    {
+        uint64_t numSamples = profile.numSamples();
+        MPI_Bcast(&numSamples, 1, MpiType<uint64_t>{}, 0, comm);
+        MPI_Bcast(&profile.rMax, 1, MpiType<double>{}, 0, comm);
+
+        for (auto* table : {&profile.rho, &profile.p, &profile.vel})
+        {
+            table->resize(numSamples);
+            MPI_Bcast(table->data(), numSamples, MpiType<double>{}, 0, comm);
+        }
+    }
+
+    //! @brief pointer to field data or nullptr if the field is not in use
+    template<class Vector>
+    static auto optionalPtr(Vector& field)
+    {
+        return field.empty() ? nullptr : rawPtr(field);
+    }
+};
+
+} // namespace sphexa
@@ -0,0 +1,152 @@
+/*
+ * MIT License
+ *
+ * SPH-EXA
+ * Copyright (c) 2024 CSCS, ETH Zurich, University of Basel, University of Zurich
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*! @file
+ * @brief Tabulation of analytical solutions on a uniform radial grid
+ */
+
+#include <algorithm>
+
+#include "analytical_solutions/sedov_solution/sedov_solution.hpp"
+
+#include "analytical_profiles.hpp"
+
+namespace sphexa
+{
+
+//! @brief uniform sample points in [0, rMax], the first point is moved off the (possibly singular) origin
+static std::vector<double> radialSamples(double rMax, size_t numSamples)
+{
+    std::vector<double> r(numSamples);
+    double              dr = rMax / double(numSamples - 1);
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        r[i] = double(i) * dr;
+    }
+    r[0] = 0.01 * dr;
+    return r;
+}
+
+static RadialProfile allocateProfile(double rMax, size_t numSamples)
+{
+    RadialProfile ret;
+    ret.rMax = rMax;
+    ret.rho.resize(numSamples);
+    ret.p.resize(numSamples);
+    ret.vel.resize(numSamples);
+    return ret;
+}
+
+RadialProfile sedovProfile(const std::map<std::string, double>& settings, double time, size_t numSamples)
+{
+    // the corners of the cube [-r1, r1]^3 are at a distance of sqrt(3) * r1 from the center
+    double rMax = std::sqrt(3.0) * settings.at("r1");
+    auto   ret  = allocateProfile(rMax, numSamples);
+
+    if (time <= 0.0)
+    {
+        std::fill(ret.rho.begin(), ret.rho.end(), settings.at("rho0"));
+        std::fill(ret.p.begin(), ret.p.end(), settings.at("p0"));
+        std::fill(ret.vel.begin(), ret.vel.end(), std::abs(settings.at("vr0")));
+        return ret;
+    }
+
+    auto                r = radialSamples(rMax, numSamples);
+    std::vector<double> u(numSamples), cs(numSamples);
+
+    SedovSolution::sedovSol(size_t(settings.at("dim")), time, settings.at("energyTotal"), settings.at("omega"),
+                            settings.at("gamma"), settings.at("rho0"), settings.at("u0"), settings.at("p0"),
+                            settings.at("vr0"), settings.at("cs0"), r, ret.rho, ret.p, u, ret.vel, cs);
+
+    for (auto& v : ret.vel)
+    {
+        v = std::abs(v);
+    }
+    return ret;
+}
+
+RadialProfile nohProfile(const std::map<std::string, double>& settings, double time, size_t numSamples)
+{
+    double rMax = std::sqrt(3.0) * settings.at("r1");
+    auto   ret  = allocateProfile(rMax, numSamples);
+    auto   r    = radialSamples(rMax, numSamples);
+
+    double dim   = settings.at("dim");
+    double gamma = settings.at("gamma");
+    double rho0  = settings.at("rho0");
+    double vr0   = settings.at("vr0");
+
+    double shockFront = 0.5 * (gamma - 1) * std::abs(vr0) * time;
+    double rhoShocked = rho0 * std::pow((gamma + 1) / (gamma - 1), dim);
+    double uShocked   = 0.5 * vr0 * vr0;
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        if (r[i] > shockFront)
+        {
+            ret.rho[i] = rho0 * std::pow(1.0 - vr0 * time / r[i], dim - 1);
+            ret.p[i]   = settings.at("p0");
+            ret.vel[i] = std::abs(vr0);
+        }
+        else
+        {
+            ret.rho[i] = rhoShocked;
+            ret.p[i]   = (gamma - 1) * rhoShocked * uShocked;
+            ret.vel[i] = 0.0;
+        }
+    }
+    return ret;
+}
+
+RadialProfile greshoChanProfile(const std::map<std::string, double>& settings, size_t numSamples)
+{
+    double R1 = settings.at("R1");
+    double v0 = settings.at("v0");
+    double P0 = settings.at("P0");
+
+    // beyond 2 * R1 the solution is constant, which matches the extrapolation of the profile beyond rMax
+    double rMax = 2.0 * R1;
+    auto   ret  = allocateProfile(rMax, numSamples);
+    auto   r    = radialSamples(rMax, numSamples);
+
+    std::fill(ret.rho.begin(), ret.rho.end(), settings.at("rho"));
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        double psi = r[i] / R1;
+        if (psi <= 1.0)
+        {
+            ret.p[i]   = P0 + 4 * v0 * v0 * psi * psi / 8;
+            ret.vel[i] = v0 * psi;
+        }
+        else
+        {
+            ret.p[i]   = P0 + 4 * v0 * v0 * (psi * psi / 8 - psi + std::log(psi) + 1);
+            ret.vel[i] = v0 * (2 - psi);
+        }
+    }
+    return ret;
+}
+
+} // namespace sphexa
@@ -0,0 +1,142 @@
+/*
+ * MIT License
+ *
+ * SPH-EXA
+ * Copyright (c) 2024 CSCS, ETH Zurich, University of Basel, University of Zurich
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*! @file
+ * @brief Tabulated radial profiles of analytical solutions for in-situ validation
+ *
+ * The Sedov, Noh and Gresho-Chan solutions are functions of a single (spherical or cylindrical) radius.
+ * They are evaluated once per time-step on a uniform radial grid and linearly interpolated for each particle.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "cstone/cuda/annotation.hpp"
+#include "cstone/util/array.hpp"
+
+namespace sphexa
+{
+
+//! @brief density, pressure and velocity magnitude sampled at numSamples() uniform radii in [0, rMax]
+struct RadialProfile
+{
+    double              rMax{0};
+    std::vector<double> rho, p, vel;
+
+    [[nodiscard]] size_t numSamples() const { return rho.size(); }
+};
+
+//! @brief linear interpolation of a profile @p table with @p n samples in [0, rMax], constant beyond rMax
+template<class T>
+HOST_DEVICE_FUN double interpolateProfile(const double* table, size_t n, double rMax, T r)
+{
+    double pos = double(r) / rMax * double(n - 1);
+    if (pos >= double(n - 1)) { return table[n - 1]; }
+
+    size_t i    = size_t(pos);
+    double frac = pos - double(i);
+    return (1.0 - frac) * table[i] + frac * table[i + 1];
+}
+
+/*! @brief accumulate L1 and L2 error sums of a single particle against the analytical profile
+ *
+ * @param[in] rhoSol   analytical density table, length @p n
+ * @param[in] pSol     analytical pressure table, length @p n
+ * @param[in] velSol   analytical velocity magnitude table, length @p n
+ * @param[in] radius   spherical or cylindrical radius of the particle
+ * @param[in] rhoi     density of the particle
+ * @param[in] pi       pressure of the particle
+ * @param[in] veli     velocity magnitude of the particle
+ * @return             {|drho|, drho^2, |dp|, dp^2, |dv|, dv^2}
+ */
+HOST_DEVICE_FUN inline util::array<double, 6> profileErrors(const double* rhoSol, const double* pSol,
+                                                            const double* velSol, size_t n, double rMax, double radius,
+                                                            double rhoi, double pi, double veli)
+{
+    double drho = rhoi - interpolateProfile(rhoSol, n, rMax, radius);
+    double dp   = pi - interpolateProfile(pSol, n, rMax, radius);
+    double dv   = veli - interpolateProfile(velSol, n, rMax, radius);
+
+    return {std::abs(drho), drho * drho, std::abs(dp), dp * dp, std::abs(dv), dv * dv};
+}
+
+/*! @brief sum up L1 and L2 errors against @p profile of all particles in [first:last]
+ *
+ * @param[in] temp      temperature, or nullptr if @p u is used
+ * @param[in] u         internal energy, or nullptr if @p temp is used
+ * @param[in] kx        VE normalization, or nullptr if @p rho is used
+ * @param[in] xm        VE definition, or nullptr if @p rho is used
+ * @param[in] rho       density, or nullptr if @p kx and @p xm are used
+ * @param[in] cv        heat capacity to convert @p temp to internal energy
+ * @param[in] cylindrical  if true, use the radius and velocity projected onto the x-y plane
+ * @return              {sum |drho|, sum drho^2, sum |dp|, sum dp^2, sum |dv|, sum dv^2}
+ */
+template<class Tc, class Tv, class Tm>
+util::array<double, 6> localProfileErrors(size_t first, size_t last, const Tc* x, const Tc* y, const Tc* z,
+                                          const Tv* vx, const Tv* vy, const Tv* vz, const Tc* temp, const Tc* u,
+                                          const Tv* kx, const Tv* xm, const Tv* rho, const Tm* m,
+                                          const RadialProfile& profile, double cv, double gamma, bool cylindrical)
+{
+    const double* rhoSol = profile.rho.data();
+    const double* pSol   = profile.p.data();
+    const double* velSol = profile.vel.data();
+    size_t        n      = profile.numSamples();
+
+    util::array<double, 6> errors{0, 0, 0, 0, 0, 0};
+
+#pragma omp declare reduction(+ : util::array <double, 6> : omp_out += omp_in) initializer(omp_priv(omp_orig))
+
+#pragma omp parallel for reduction(+ : errors)
+    for (size_t i = first; i < last; ++i)
+    {
+        double zi  = cylindrical ? 0.0 : z[i];
+        double vzi = cylindrical ? 0.0 : vz[i];
+
+        double radius = std::sqrt(x[i] * x[i] + y[i] * y[i] + zi * zi);
+        double veli   = std::sqrt(vx[i] * vx[i] + vy[i] * vy[i] + vzi * vzi);
+        double rhoi   = rho ? double(rho[i]) : double(kx[i]) * m[i] / xm[i];
+        double ui     = temp ? cv * temp[i] : u[i];
+        double pi     = (gamma - 1.0) * rhoi * ui;
+
+        errors += profileErrors(rhoSol, pSol, velSol, n, profile.rMax, radius, rhoi, pi, veli);
+    }
+
+    return errors;
+}
+
+//! @brief Sedov blast wave (Kamm & Timmes) solution at @p time, uses the settings of the sedov test case
+RadialProfile sedovProfile(const std::map<std::string, double>& settings, double time, size_t numSamples);
+
+//! @brief Noh implosion solution at @p time, uses the settings of the noh test case
+RadialProfile nohProfile(const std::map<std::string, double>& settings, double time, size_t numSamples);
+
+//! @brief stationary Gresho-Chan vortex in the cylindrical radius, uses the settings of the gresho-chan test case
+RadialProfile greshoChanProfile(const std::map<std::string, double>& settings, size_t numSamples);
+
+} // namespace sphexa
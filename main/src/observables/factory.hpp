@@ -35,16 +35,22 @@
 #include <string>
 
 #include "cstone/sfc/box.hpp"
+#include "io/arg_parser.hpp"
 #include "io/ifile_io.hpp"
 
+#include "analytical_profiles.hpp"
+
 #include "iobservables.hpp"
 
 namespace sphexa
 {
 
 template<class Dataset>
-std::unique_ptr<IObservables<Dataset>> observablesFactory(const InitSettings& settings, std::ostream& constantsFile)
+std::unique_ptr<IObservables<Dataset>> observablesFactory(const std::string& testCase, const InitSettings& settings,
+                                                          std::ostream& constantsFile)
 {
+    std::string testNamedBase = strBeforeSign(testCase, ":");
+
     if (settings.count("observeGravWaves"))
     {
         if (not settings.count("gravWaveTheta") || not settings.count("graveWavePhi"))
@@ -65,6 +71,25 @@ std::unique_ptr<IObservables<Dataset>> observablesFactory(const InitSettings& se
     if (settings.count("turbulence")) { return Observables<Dataset>::makeTurbMachObs(constantsFile); }
     if (settings.count("kelvin-helmholtz")) { return Observables<Dataset>::makeTimeEnergyGrowthObs(constantsFile); }
 
+    //! @brief number of radial samples for tabulating analytical solutions
+    constexpr size_t numSamples = 4096;
+
+    if (testNamedBase == "sedov")
+    {
+        auto solution = [settings](double time) { return sedovProfile(settings, time, numSamples); };
+        return Observables<Dataset>::makeAnalyticalErrorsObs(constantsFile, solution, false);
+    }
+    if (testNamedBase == "noh")
+    {
+        auto solution = [settings](double time) { return nohProfile(settings, time, numSamples); };
+        return Observables<Dataset>::makeAnalyticalErrorsObs(constantsFile, solution, false);
+    }
+    if (settings.count("gresho-chan"))
+    {
+        auto solution = [settings](double) { return greshoChanProfile(settings, numSamples); };
+        return Observables<Dataset>::makeAnalyticalErrorsObs(constantsFile, solution, true);
+    }
+
     return Observables<Dataset>::makeTimeEnergyObs(constantsFile);
 }
 
@@ -29,7 +29,9 @@
  * @author Lukas Schmidt
  */
 
+#include <thrust/device_vector.h>
 #include <thrust/execution_policy.h>
+#include <thrust/iterator/counting_iterator.h>
 #include <thrust/iterator/zip_iterator.h>
 #include <thrust/transform_reduce.h>
 
@@ -175,4 +177,70 @@ SURVIVORS(double, double, double);
 SURVIVORS(float, float, float);
 SURVIVORS(float, double, float);
 
+//!@brief functor for the L1 and L2 errors of a single particle against an analytical profile
+template<class Tc, class Tv, class Tm>
+struct ProfileErrors
+{
+    HOST_DEVICE_FUN util::array<double, 6> operator()(size_t i)
+    {
+        double zi  = cylindrical ? 0.0 : z[i];
+        double vzi = cylindrical ? 0.0 : vz[i];
+
+        double radius = std::sqrt(x[i] * x[i] + y[i] * y[i] + zi * zi);
+        double veli   = std::sqrt(vx[i] * vx[i] + vy[i] * vy[i] + vzi * vzi);
+        double rhoi   = rho ? double(rho[i]) : double(kx[i]) * m[i] / xm[i];
+        double ui     = temp ? cv * temp[i] : u[i];
+        double pi     = (gamma - 1.0) * rhoi * ui;
+
+        return profileErrors(rhoSol, pSol, velSol, n, rMax, radius, rhoi, pi, veli);
+    }
+
+    const Tc *x, *y, *z;
+    const Tv *vx, *vy, *vz;
+    const Tc *temp, *u;
+    const Tv *kx, *xm, *rho;
+    const Tm* m;
+
+    const double *rhoSol, *pSol, *velSol;
+    size_t        n;
+    double        rMax, cv, gamma;
+    bool          cylindrical;
+};
+
+template<class Tc, class Tv, class Tm>
+util::array<double, 6> profileErrorsGpu(size_t first, size_t last, const Tc* x, const Tc* y, const Tc* z, const Tv* vx,
+                                        const Tv* vy, const Tv* vz, const Tc* temp, const Tc* u, const Tv* kx,
+                                        const Tv* xm, const Tv* rho, const Tm* m, const RadialProfile& profile,
+                                        double cv, double gamma, bool cylindrical)
+{
+    thrust::device_vector<double> rhoSol = profile.rho;
+    thrust::device_vector<double> pSol   = profile.p;
+    thrust::device_vector<double> velSol = profile.vel;
+
+    ProfileErrors<Tc, Tv, Tm> errorFunctor{x, y, z, vx, vy, vz, temp, u, kx, xm, rho, m};
+    errorFunctor.rhoSol      = thrust::raw_pointer_cast(rhoSol.data());
+    errorFunctor.pSol        = thrust::raw_pointer_cast(pSol.data());
+    errorFunctor.velSol      = thrust::raw_pointer_cast(velSol.data());
+    errorFunctor.n           = profile.numSamples();
+    errorFunctor.rMax        = profile.rMax;
+    errorFunctor.cv          = cv;
+    errorFunctor.gamma       = gamma;
+    errorFunctor.cylindrical = cylindrical;
+
+    auto                   plus = thrust::plus<util::array<double, 6>>{};
+    util::array<double, 6> init{0, 0, 0, 0, 0, 0};
+
+    return thrust::transform_reduce(thrust::device, thrust::counting_iterator<size_t>(first),
+                                    thrust::counting_iterator<size_t>(last), errorFunctor, init, plus);
+}
+
+#define PROFILE_ERRORS_GPU(Tc, Tv, Tm)                                                                                 \
+    template util::array<double, 6> profileErrorsGpu(size_t, size_t, const Tc*, const Tc*, const Tc*, const Tv*,      \
+                                                     const Tv*, const Tv*, const Tc*, const Tc*, const Tv*, const Tv*, \
+                                                     const Tv*, const Tm*, const RadialProfile&, double, double, bool)
+
+PROFILE_ERRORS_GPU(double, double, double);
+PROFILE_ERRORS_GPU(double, float, float);
+PROFILE_ERRORS_GPU(float, float, float);
+
 } // namespace sphexa
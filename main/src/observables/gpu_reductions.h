@@ -34,6 +34,9 @@
 #include <tuple>
 #include "cstone/sfc/box.hpp"
 #include "cstone/tree/definitions.h"
+#include "cstone/util/array.hpp"
+
+#include "analytical_profiles.hpp"
 
 namespace sphexa
 {
@@ -87,4 +90,16 @@ extern double machSquareSumGpu(const Tv* vx, const Tv* vy, const Tv* vz, const T
 template<class T, class Tt, class Tm>
 extern size_t survivorsGpu(const Tt* temp, const T* kx, const T* xmass, const Tm* m, double rhoBubble, double tempWind,
                            size_t first, size_t last);
+
+/*! @brief sum up L1 and L2 errors of density, pressure and velocity against an analytical radial profile
+ *
+ * See localProfileErrors for a description of the arguments. Optional fields are passed as nullptr.
+ *
+ * @return {sum |drho|, sum drho^2, sum |dp|, sum dp^2, sum |dv|, sum dv^2}
+ */
+template<class Tc, class Tv, class Tm>
+extern util::array<double, 6> profileErrorsGpu(size_t first, size_t last, const Tc* x, const Tc* y, const Tc* z,
+                                               const Tv* vx, const Tv* vy, const Tv* vz, const Tc* temp, const Tc* u,
+                                               const Tv* kx, const Tv* xm, const Tv* rho, const Tm* m,
+                                               const RadialProfile& profile, double cv, double gamma, bool cylindrical);
 } // namespace sphexa
\ No newline at end of file
@@ -31,8 +31,11 @@
 
 #pragma once
 
+#include <functional>
+
 #include "cstone/sfc/box.hpp"
 #include "sphexa/simulation_data.hpp"
+#include "analytical_profiles.hpp"
 
 namespace sphexa
 {
@@ -57,9 +60,15 @@ struct Observables
     static ObsPtr makeTimeEnergyGrowthObs(std::ostream& out);
     static ObsPtr makeTurbMachObs(std::ostream& out);
     static ObsPtr makeWindBubbleObs(std::ostream& out, double rhoI, double uE, double r);
+    static ObsPtr makeAnalyticalErrorsObs(std::ostream& out, std::function<RadialProfile(double)> solution,
+                                          bool cylindrical);
 };
 
-extern template struct Observables<SimulationData<cstone::CpuTag>>;
-extern template struct Observables<SimulationData<cstone::GpuTag>>;
+#define EXTERN_OBSERVABLES(Types)                                                                                      \
+    extern template struct Observables<SimulationData<cstone::CpuTag, Types>>;                                         \
+    extern template struct Observables<SimulationData<cstone::GpuTag, Types>>
+
+SPH_EXA_FOR_EACH_TYPE_CONFIG(EXTERN_OBSERVABLES);
+#undef EXTERN_OBSERVABLES
 
 } // namespace sphexa
@@ -4,6 +4,7 @@
 
 #include "cstone/primitives/accel_switch.hpp"
 
+#include "analytical_errors.hpp"
 #include "gravitational_waves.hpp"
 #include "time_energies.hpp"
 #include "time_energy_growth.hpp"
@@ -47,10 +48,23 @@ std::unique_ptr<IObservables<Dataset>> Observables<Dataset>::makeWindBubbleObs(s
     return std::make_unique<WindBubble<Dataset>>(out, rhoI, uExt, r);
 }
 
+template<class Dataset>
+std::unique_ptr<IObservables<Dataset>>
+Observables<Dataset>::makeAnalyticalErrorsObs(std::ostream& out, std::function<RadialProfile(double)> solution,
+                                              bool cylindrical)
+{
+    return std::make_unique<AnalyticalErrors<Dataset>>(out, std::move(solution), cylindrical);
+}
+
+#define OBSERVABLES(AccType, Types)                                                                                    \
+    template struct Observables<SimulationData<AccType, Types>>
+#define OBSERVABLES_CPU(Types) OBSERVABLES(cstone::CpuTag, Types)
+#define OBSERVABLES_GPU(Types) OBSERVABLES(cstone::GpuTag, Types)
+
 #ifdef USE_CUDA
-template struct Observables<SimulationData<cstone::GpuTag>>;
+SPH_EXA_FOR_EACH_TYPE_CONFIG(OBSERVABLES_GPU);
 #else
-template struct Observables<SimulationData<cstone::CpuTag>>;
+SPH_EXA_FOR_EACH_TYPE_CONFIG(OBSERVABLES_CPU);
 #endif
 
 } // namespace sphexa
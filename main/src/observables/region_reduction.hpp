@@ -0,0 +1,77 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 CSCS, ETH Zurich
+ *               2024 University of Basel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*! @file
+ * @brief Reductions of particle quantities inside a spatial region across ranks
+ *
+ * Only the particles in leaves of the focus tree that overlap the region are visited, such that the cost scales with
+ * the size of the region instead of the number of local particles, see cstone/traversal/region_query.hpp.
+ */
+
+#pragma once
+
+#include <type_traits>
+
+#include "mpi.h"
+
+#include "cstone/primitives/accel_switch.hpp"
+#include "cstone/primitives/mpi_wrappers.hpp"
+#include "cstone/traversal/region_query.hpp"
+#include "cstone/util/array.hpp"
+
+namespace sphexa
+{
+
+/*! @brief sum of @p quantity over the particles inside @p region on all ranks of @p comm
+ *
+ * @param[in] startIndex  first locally assigned particle index of buffers in @p d
+ * @param[in] endIndex    last locally assigned particle index of buffers in @p d
+ * @param[in] d           particle data set, its treeView has to be up to date with the last domain sync
+ * @param[in] box         global coordinate bounding box
+ * @param[in] region      cstone::SphereRegion, BoxRegion or CylinderRegion
+ * @param[in] quantity    called with the index of each particle inside @p region, returns a util::array
+ * @param[in] comm        communicator of the ranks that hold the particles
+ * @return                the sum of the returned arrays over all particles inside @p region, on all ranks
+ *
+ * Example: mass and number of particles within a radius r of the origin
+ *   auto [mass, count] = regionSum(first, last, d, box, cstone::SphereRegion<T>{{0, 0, 0}, r},
+ *                                  [&d](size_t i) { return util::array<double, 2>{d.m[i], 1.0}; }, comm);
+ */
+template<class Dataset, class T, class Region, class F>
+auto regionSum(size_t startIndex, size_t endIndex, const Dataset& d, const cstone::Box<T>& box, const Region& region,
+               F&& quantity, MPI_Comm comm)
+{
+    static_assert(!cstone::HaveGpu<typename Dataset::AcceleratorType>{}, "Region queries require the tree on the host");
+    using Result = std::decay_t<decltype(quantity(size_t(0)))>;
+
+    Result sums{};
+    cstone::forEachInRegion(d.treeView, region, box, startIndex, endIndex, d.x.data(), d.y.data(), d.z.data(),
+                            [&sums, &quantity](cstone::LocalIndex i) { sums += quantity(i); });
+
+    MPI_Allreduce(MPI_IN_PLACE, sums.data(), sums.size(), MpiType<typename Result::value_type>{}, MPI_SUM, comm);
+    return sums;
+}
+
+} // namespace sphexa
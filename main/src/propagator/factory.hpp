@@ -49,6 +49,7 @@ propagatorFactory(const std::string& choice, bool avClean, std::ostream& output,
         return PropLib<DomainType, ParticleDataType>::makeHydroVeBdtProp(output, rank, s, avClean);
     }
     if (choice == "std") { return PropLib<DomainType, ParticleDataType>::makeHydroProp(output, rank); }
+    if (choice == "std-2d") { return PropLib<DomainType, ParticleDataType>::makeHydroProp2D(output, rank); }
 #ifdef SPH_EXA_HAVE_GRACKLE
     if (choice == "std-cooling")
     {
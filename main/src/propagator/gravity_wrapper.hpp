@@ -63,7 +63,7 @@ public:
         reallocate(multipoles_, focusTree.octreeViewAcc().numNodes, 1.05);
         ryoanji::computeGlobalMultipoles(d.x.data(), d.y.data(), d.z.data(), d.m.data(), d.x.size(),
                                          domain.globalTree(), domain.focusTree(), domain.layout().data(),
-                                         multipoles_.data());
+                                         multipoles_.data(), d.compactMultipoles);
     }
 
     void traverse(cstone::GroupView /*grp*/, DataType& d, const DomainType& domain)
@@ -78,10 +78,21 @@ public:
         int         numShells = usePbc ? ewaldSettings_.numReplicaShells : 0;
 
         d.egrav = 0;
-        ryoanji::computeGravity(octree.childOffsets, octree.internalToLeaf, focusTree.expansionCentersAcc().data(),
-                                multipoles_.data(), domain.layout().data(), domain.startCell(), domain.endCell(),
-                                d.x.data(), d.y.data(), d.z.data(), d.h.data(), d.m.data(), domain.box(), d.g,
-                                d.ugrav.data(), d.ax.data(), d.ay.data(), d.az.data(), &d.egrav, numShells);
+        if (d.mutualP2P)
+        {
+            ryoanji::computeGravityMutual(octree.childOffsets, octree.internalToLeaf,
+                                          focusTree.expansionCentersAcc().data(), multipoles_.data(),
+                                          domain.layout().data(), domain.startCell(), domain.endCell(), d.x.data(),
+                                          d.y.data(), d.z.data(), d.h.data(), d.m.data(), domain.box(), d.g,
+                                          d.ugrav.data(), d.ax.data(), d.ay.data(), d.az.data(), &d.egrav, numShells);
+        }
+        else
+        {
+            ryoanji::computeGravity(octree.childOffsets, octree.internalToLeaf, focusTree.expansionCentersAcc().data(),
+                                    multipoles_.data(), domain.layout().data(), domain.startCell(), domain.endCell(),
+                                    d.x.data(), d.y.data(), d.z.data(), d.h.data(), d.m.data(), domain.box(), d.g,
+                                    d.ugrav.data(), d.ax.data(), d.ay.data(), d.az.data(), &d.egrav, numShells);
+        }
 
         if (usePbc)
         {
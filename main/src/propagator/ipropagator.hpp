@@ -36,6 +36,7 @@
 
 #include "cstone/sfc/box.hpp"
 #include "cstone/primitives/accel_switch.hpp"
+#include "cstone/util/scratch_arena.hpp"
 #include "io/ifile_io.hpp"
 #include "sph/particles_data.hpp"
 #include "util/pm_reader.hpp"
@@ -88,6 +89,9 @@ public:
     //! @brief add pm counters if they exist
     void addCounters(const std::string& pmRoot, int numRanksPerNode) { pmReader.addCounters(pmRoot, numRanksPerNode); }
 
+    //! @brief keep the traffic of all iterations until the next writeMetrics, otherwise only of the current one
+    void keepCommHistory(bool keep) { timer.keepCommHistory(keep); }
+
     //! @brief print timing info
     void writeMetrics(IFileWriter* writer, const std::string& outFile)
     {
@@ -97,6 +101,16 @@ public:
 
     virtual ~Propagator() = default;
 
+    //! @brief print the time per iteration of each phase across ranks and the traffic of the last iteration
+    void printTimingSummary()
+    {
+        timer.printPhaseSummary(MPI_COMM_WORLD);
+        timer.printCommSummary(MPI_COMM_WORLD);
+    }
+
+    //! @brief discard the timings of all iterations so far, e.g. of warm-up iterations
+    void resetTimings() { timer.reset(); }
+
     //! @brief Returns time elapsed since the start of last call to computeForces()
     float stepElapsed() const { return timer.sumOfSteps(); }
 
@@ -111,6 +125,8 @@ public:
         auto totalNeighbors     = d.totalNeighbors;
         auto totalParticleCount = d.numParticlesGlobal;
 
+        timer.printCommSummary(MPI_COMM_WORLD);
+
         out << "### Check ### Global Tree Nodes: " << nodeCount << ", Particles: " << particleCount
             << ", Halos: " << haloCount << std::endl;
         out << "### Check ### Computational domain: " << box.xmin() << " " << box.xmax() << " " << box.ymin() << " "
@@ -123,6 +139,7 @@ public:
         out << ")" << std::endl;
         out << "### Check ### Focus Tree Nodes: " << domain.focusTree().octreeViewAcc().numLeafNodes << ", maxDepth "
             << domain.focusTree().depth();
+        out << ", maxScratch " << double(cstone::scratchHighWaterMark()) / (1 << 20) << " MiB";
         if constexpr (cstone::HaveGpu<typename ParticleDataType::AcceleratorType>{})
         {
             out << ", maxStackNc " << d.devData.stackUsedNc << ", maxStackGravity " << d.devData.stackUsedGravity;
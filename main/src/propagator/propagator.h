@@ -49,6 +49,7 @@ struct PropLib
 
     static PropPtr makeHydroVeProp(std::ostream& output, size_t rank, bool avClean);
     static PropPtr makeHydroProp(std::ostream& output, size_t rank);
+    static PropPtr makeHydroProp2D(std::ostream& output, size_t rank);
     static PropPtr makeHydroVeBdtProp(std::ostream& output, size_t rank, const InitSettings& settings, bool avClean);
 #ifdef SPH_EXA_HAVE_GRACKLE
     static PropPtr makeHydroGrackleProp(std::ostream& output, size_t rank, const InitSettings& settings);
@@ -58,4 +59,12 @@ struct PropLib
     static PropPtr makeTurbVeProp(std::ostream& output, size_t rank, const InitSettings& settings, bool avClean);
 };
 
+//! @brief explicit instantiation of PropLib for the domain and simulation data of a given type configuration
+#define PROP_LIB(AccType, Types)                                                                                       \
+    template struct PropLib<cstone::Domain<Types::KeyType, Types::CoordinateType, AccType>,                            \
+                            SimulationData<AccType, Types>>
+
+#define PROP_LIB_CPU(Types) PROP_LIB(cstone::CpuTag, Types)
+#define PROP_LIB_GPU(Types) PROP_LIB(cstone::GpuTag, Types)
+
 } // namespace sphexa
@@ -44,12 +44,21 @@ PropLib<DomainType, ParticleDataType>::makeHydroProp(std::ostream& output, size_
     return std::make_unique<HydroProp<DomainType, ParticleDataType>>(output, rank);
 }
 
+template<class DomainType, class ParticleDataType>
+std::unique_ptr<Propagator<DomainType, ParticleDataType>>
+PropLib<DomainType, ParticleDataType>::makeHydroProp2D(std::ostream& output, size_t rank)
+{
+    if constexpr (cstone::HaveGpu<typename ParticleDataType::AcceleratorType>{})
+    {
+        throw std::runtime_error("The 2D SPH propagator is not available on GPUs\n");
+    }
+    else { return std::make_unique<HydroProp<DomainType, ParticleDataType, 2>>(output, rank); }
+}
+
 #ifdef USE_CUDA
-template struct PropLib<cstone::Domain<SphTypes::KeyType, SphTypes::CoordinateType, cstone::GpuTag>,
-                        SimulationData<cstone::GpuTag>>;
+SPH_EXA_FOR_EACH_TYPE_CONFIG(PROP_LIB_GPU);
 #else
-template struct PropLib<cstone::Domain<SphTypes::KeyType, SphTypes::CoordinateType, cstone::CpuTag>,
-                        SimulationData<cstone::CpuTag>>;
+SPH_EXA_FOR_EACH_TYPE_CONFIG(PROP_LIB_CPU);
 #endif
 
 } // namespace sphexa
@@ -47,7 +47,12 @@ namespace sphexa
 using namespace sph;
 using util::FieldList;
 
-template<class DomainType, class DataType>
+/*! @brief standard SPH propagator
+ *
+ * @tparam numDim  number of spatial dimensions of the SPH kernels. 2D simulations place all particles in a plane of
+ *                 constant z inside a 3D box, whose octree then only refines along x and y.
+ */
+template<class DomainType, class DataType, int numDim = 3>
 class HydroProp : public Propagator<DomainType, DataType>
 {
 protected:
@@ -123,6 +128,11 @@ public:
 
     void computeForces(DomainType& domain, DataType& simData) override
     {
+        if (simData.hydro.numDim != numDim)
+        {
+            throw std::runtime_error("Particle data has numDim = " + std::to_string(simData.hydro.numDim) +
+                                     ", but the propagator is " + std::to_string(numDim) + "-dimensional\n");
+        }
         timer.start();
 
         sync(domain, simData);
@@ -139,11 +149,11 @@ public:
         fill(get<"m">(d), last, domain.nParticlesWithHalos(), d.m[first]);
 
         resizeNeighbors(d, domain.nParticles() * d.ngmax);
-        findNeighborsSfc(first, last, d, domain.box());
+        findNeighborsSfc<numDim>(first, last, d, domain.box());
         computeGroups(first, last, d, domain.box(), groups_);
         timer.step("FindNeighbors");
 
-        computeDensity(groups_.view(), d, domain.box());
+        computeDensity<numDim>(groups_.view(), d, domain.box());
         timer.step("Density");
         computeEOS_HydroStd(first, last, d);
         timer.step("EquationOfState");
@@ -151,21 +161,30 @@ public:
         domain.exchangeHalos(get<"vx", "vy", "vz", "rho", "p", "c">(d), get<"ax">(d), get<"ay">(d));
         timer.step("mpi::synchronizeHalos");
 
-        computeIAD(groups_.view(), d, domain.box());
+        computeIAD<numDim>(groups_.view(), d, domain.box());
         timer.step("IAD");
 
-        domain.exchangeHalos(get<"c11", "c12", "c13", "c22", "c23", "c33">(d), get<"ax">(d), get<"ay">(d));
+        auto iadHalos =
+            domain.startHaloExchange(get<"c11", "c12", "c13", "c22", "c23", "c33">(d), get<"ax">(d), get<"ay">(d));
+
+        // the multipole upsweep only depends on positions and masses and can overlap with the IAD halo exchange
+        cstone::GroupView gravGroups{};
+        if (d.g != 0.0)
+        {
+            gravGroups = mHolder_.computeSpatialGroups(d, domain);
+            mHolder_.upsweep(d, domain);
+            timer.step("Upsweep");
+        }
+
+        iadHalos.wait();
         timer.step("mpi::synchronizeHalos");
 
-        computeMomentumEnergySTD(groups_.view(), d, domain.box());
+        computeMomentumEnergySTD<numDim>(groups_.view(), d, domain.box());
         timer.step("MomentumEnergyIAD");
 
         if (d.g != 0.0)
         {
-            auto groups = mHolder_.computeSpatialGroups(d, domain);
-            mHolder_.upsweep(d, domain);
-            timer.step("Upsweep");
-            mHolder_.traverse(groups, d, domain);
+            mHolder_.traverse(gravGroups, d, domain);
             timer.step("Gravity");
         }
     }
@@ -179,7 +198,7 @@ public:
         computeTimestep(first, last, d);
         timer.step("Timestep");
         computePositions(groups_.view(), d, domain.box(), d.minDt, {float(d.minDt_m1)});
-        updateSmoothingLength(groups_.view(), d);
+        updateSmoothingLength<numDim>(groups_.view(), d);
         timer.step("UpdateQuantities");
     }
 
@@ -40,6 +40,7 @@
 
 #include "cooling/cooler.hpp"
 #include "cooling/eos_cooling.hpp"
+#include "cooling/lazy_cooling.hpp"
 
 #include "std_hydro.hpp"
 #include "gravity_wrapper.hpp"
@@ -76,6 +77,12 @@ class HydroGrackleProp final : public HydroProp<DomainType, DataType>
     //! @brief All fields listed in Chemistry data are used. This could be overridden with a sublist if desired
     using CoolingFields = typename cooling::Cooler<T>::CoolingFields;
 
+    /*! @brief state of the lazy chemistry updates, preserved across domain syncs but not restored on restarts
+     *
+     * Zero-initialized state after a restart triggers an integration of all particles in the first step.
+     */
+    using LazyCoolingFields = typename cooling::Cooler<T>::LazyFields;
+
 public:
     HydroGrackleProp(std::ostream& output, size_t rank, const InitSettings& settings)
         : Base(output, rank)
@@ -91,7 +98,7 @@ public:
         if (std::filesystem::exists(path))
         {
             int snapshotIndex = numberAfterSign(initCond, ":");
-            reader->setStep(path, snapshotIndex, FileMode::independent);
+            reader->setStep(path, snapshotIndex, FileMode::broadcast);
             cooling_data.loadOrStoreAttributes(reader);
             reader->closeStep();
         }
@@ -122,6 +129,7 @@ public:
         std::apply([&d](auto... f) { d.setConserved(f.value...); }, make_tuple(ConservedFields{}));
         std::apply([&d](auto... f) { d.setDependent(f.value...); }, make_tuple(DependentFields{}));
         std::apply([&simData](auto... f) { simData.chem.setConserved(f.value...); }, make_tuple(CoolingFields{}));
+        std::apply([&simData](auto... f) { simData.chem.setDependent(f.value...); }, make_tuple(LazyCoolingFields{}));
 
         d.devData.setConserved("x", "y", "z", "h", "m");
         d.devData.setDependent("keys");
@@ -131,8 +139,6 @@ public:
 
     void sync(DomainType& domain, DataType& simData) override
     {
-        using ChemRealType = typename DataType::ChemData::RealType;
-
         auto& d = simData.hydro;
         if (d.g != 0.0)
         {
@@ -145,8 +151,8 @@ public:
                         std::tuple_cat(std::tie(get<"m">(d)), get<ConservedFields>(d)), get<DependentFields>(d));
         }
 
-        std::vector<ChemRealType> scratch1, scratch2;
-        domain.reapplySync(get<CoolingFields>(simData.chem), scratch1, scratch2, get<"nc">(d));
+        domain.reapplySync(std::tuple_cat(get<CoolingFields>(simData.chem), get<LazyCoolingFields>(simData.chem)),
+                           get<"nc">(d));
         d.treeView = domain.octreeProperties();
     }
 
@@ -211,8 +217,7 @@ public:
 
         transferToHost(d, first, last, {"du"});
 
-        cooling_data.cool_particles(T(d.minDt), d.rho.data(), d.u.data(),
-                                    cstone::getPointers(get<CoolingFields>(simData.chem), 0), d.du.data(), first, last);
+        cooling::coolParticlesLazy(d.minDt, first, last, d, simData.chem, cooling_data);
 
         transferToDevice(d, first, last, {"du"});
         timer.step("GRACKLE chemistry and cooling");
@@ -222,6 +227,17 @@ public:
         updateSmoothingLength(groups_.view(), d);
         timer.step("UpdateSmoothingLength");
     }
+
+    void saveFields(IFileWriter* writer, size_t first, size_t last, DataType& simData,
+                    const cstone::Box<T>& box) override
+    {
+        // output the chemistry and internal energy at the current time, including particles with lazy updates
+        auto& d = simData.hydro;
+        transferToHost(d, first, last, {"u"});
+        cooling::flushLazyCooling(first, last, d, simData.chem, cooling_data);
+        transferToDevice(d, first, last, {"u"});
+        Base::saveFields(writer, first, last, simData, box);
+    }
 };
 
 } // namespace sphexa
@@ -81,7 +81,7 @@ public:
         // The file does not exist, we're starting from scratch. Nothing to do.
         if (!std::filesystem::exists(path)) { return; }
 
-        reader->setStep(path, step, FileMode::independent);
+        reader->setStep(path, step, FileMode::broadcast);
         turbulenceData.loadOrStore(reader);
 
         if (rank_ == 0) { std::cout << "Restored turbulence state from " << path << ":" << step << std::endl; }
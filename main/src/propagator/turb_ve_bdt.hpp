@@ -167,7 +167,7 @@ public:
         // The file does not exist, we're starting from scratch. Nothing to do.
         if (!std::filesystem::exists(path)) { return; }
 
-        reader->setStep(path, step, FileMode::independent);
+        reader->setStep(path, step, FileMode::broadcast);
         turbulenceData.loadOrStore(reader);
         timestep_.loadOrStore(reader, "ts::");
 
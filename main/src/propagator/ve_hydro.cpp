@@ -56,10 +56,8 @@ PropLib<DomainType, ParticleDataType>::makeTurbVeProp(std::ostream& output, size
 }
 
 #ifdef USE_CUDA
-template struct PropLib<cstone::Domain<SphTypes::KeyType, SphTypes::CoordinateType, cstone::GpuTag>,
-                        SimulationData<cstone::GpuTag>>;
+SPH_EXA_FOR_EACH_TYPE_CONFIG(PROP_LIB_GPU);
 #else
-template struct PropLib<cstone::Domain<SphTypes::KeyType, SphTypes::CoordinateType, cstone::CpuTag>,
-                        SimulationData<cstone::CpuTag>>;
+SPH_EXA_FOR_EACH_TYPE_CONFIG(PROP_LIB_CPU);
 #endif
 } // namespace sphexa
@@ -159,7 +159,7 @@ public:
         // The file does not exist, we're starting from scratch. Nothing to do.
         if (!std::filesystem::exists(path)) { return; }
 
-        reader->setStep(path, step, FileMode::independent);
+        reader->setStep(path, step, FileMode::broadcast);
         timestep_.loadOrStore(reader, "ts::");
         reader->closeStep();
 
@@ -0,0 +1,170 @@
+/*
+ * MIT License
+ *
+ * SPH-EXA
+ * Copyright (c) 2024 CSCS, ETH Zurich, University of Basel, University of Zurich
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*! @file
+ * @brief Replay the workload of a step captured with sphexa --trace
+ *
+ * Each rank loads its trace file and warm-starts the domain with the captured global and focus trees. The forces of
+ * the captured step are then evaluated repeatedly without integrating the particles in time, such that every
+ * repetition processes the same particle distribution. The propagator times the domain sync, the neighbor search,
+ * each hydro kernel, the halo exchanges and gravity as separate phases. After the warm-up repetitions, the mean time
+ * per repetition of each phase is summarized across ranks.
+ */
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "cstone/domain/domain.hpp"
+
+#include "init/factory.hpp"
+#include "io/arg_parser.hpp"
+#include "io/factory.hpp"
+#include "io/workload_trace.hpp"
+#include "propagator/factory.hpp"
+#include "sph/types.hpp"
+#include "util/timer.hpp"
+#include "util/utils.hpp"
+
+#include "simulation_data.hpp"
+
+using namespace sphexa;
+
+void printHelp(char* binName);
+
+template<class Types>
+int replay(const ArgParser& parser, int rank, int numRanks);
+
+template<template<class> class Precision>
+int dispatchKeyType(const ArgParser& parser, int rank, int numRanks);
+
+int main(int argc, char** argv)
+{
+    auto [rank, numRanks] = initMpi();
+    const ArgParser parser(argc, (const char**)argv);
+
+    if (parser.exists("-h") || parser.exists("--help") || !parser.exists("--trace"))
+    {
+        if (rank == 0) { printHelp(argv[0]); }
+        return exitSuccess();
+    }
+
+    const std::string precision = parser.get("--precision", std::string("mixed"));
+    if (precision == "mixed") { return dispatchKeyType<sph::MixedPrecision>(parser, rank, numRanks); }
+    if (precision == "double") { return dispatchKeyType<sph::DoublePrecision>(parser, rank, numRanks); }
+
+    throw std::runtime_error("Unknown precision choice " + precision + ", choose mixed or double\n");
+}
+
+//! @brief select the SFC key type of the captured run
+template<template<class> class Precision>
+int dispatchKeyType(const ArgParser& parser, int rank, int numRanks)
+{
+    const int keyBits = parser.get("--keys", 64);
+    if (keyBits == 32) { return replay<Precision<uint32_t>>(parser, rank, numRanks); }
+    if (keyBits == 64) { return replay<Precision<uint64_t>>(parser, rank, numRanks); }
+
+    throw std::runtime_error("Unsupported SFC key width " + std::to_string(keyBits) + ", choose 32 or 64\n");
+}
+
+template<class Types>
+int replay(const ArgParser& parser, int rank, int numRanks)
+{
+    using KeyType = typename Types::KeyType;
+    using Dataset = SimulationData<cstone::CpuTag, Types>;
+    using Domain  = cstone::Domain<KeyType, typename Types::CoordinateType, cstone::CpuTag>;
+
+    const std::string traceBase  = parser.get("--trace");
+    const std::string propChoice = parser.get("--prop", std::string("ve"));
+    const bool        avClean    = parser.exists("--avclean");
+    const int         numReps    = parser.get("-r", 5);
+    const int         numWarmup  = parser.get("--warmup", 1);
+
+    std::ofstream nullOutput("/dev/null");
+    std::ostream& output = rank ? nullOutput : std::cout;
+
+    const std::string tracePath = workloadTracePath(traceBase, rank);
+    auto              reader    = fileReaderFactory(false, MPI_COMM_SELF);
+    auto              info      = readWorkloadTraceInfo(tracePath, reader.get());
+    if (info.numRanks != uint64_t(numRanks))
+    {
+        throw std::runtime_error("Trace " + traceBase + " was captured with " + std::to_string(info.numRanks) +
+                                 " ranks, replay it with the same number of ranks\n");
+    }
+
+    auto simInit    = initializerFactory<Dataset>(tracePath + ":0", "", reader.get());
+    auto propagator = propagatorFactory<Domain, Dataset>(propChoice, avClean, output, rank, simInit->constants());
+
+    Dataset simData;
+    simData.comm = MPI_COMM_WORLD;
+    propagator->activateFields(simData);
+    propagator->load(tracePath + ":0", reader.get());
+    auto box = simInit->init(rank, numRanks, 0, simData, reader.get());
+
+    auto& d             = simData.hydro;
+    d.compactMultipoles = parser.exists("--compact-multipoles");
+    d.mutualP2P         = parser.exists("--mutual-p2p");
+
+    Domain domain(rank, numRanks, info.bucketSize, info.bucketSizeFocus, info.theta, box);
+    domain.setGrowthAllocRate(d.getAllocGrowthRate());
+    readWorkloadTrace(domain, tracePath, reader.get());
+
+    cstone::commAccounting().setEnabled(parser.exists("--comm-stats"));
+
+    output << "Replaying iteration " << info.iteration << " with " << d.numParticlesGlobal << " particles on "
+           << numRanks << " ranks" << std::endl;
+
+    Timer syncTimer(output);
+    syncTimer.start();
+    propagator->sync(domain, simData);
+    syncTimer.step("Warm-started domain sync");
+
+    for (int i = 0; i < numWarmup + numReps; ++i)
+    {
+        if (i == numWarmup) { propagator->resetTimings(); }
+        propagator->computeForces(domain, simData);
+    }
+    propagator->printTimingSummary();
+
+    return exitSuccess();
+}
+
+void printHelp(char* name)
+{
+    printf("\nUsage:\n\n");
+    printf("%s [OPTIONS]\n", name);
+    printf("\nWhere possible options are:\n\n");
+
+    printf("\t--trace BASE \t Traces written by sphexa --trace, BASE_<rank>.h5 is loaded on each rank.\n"
+           "\t\t\t Needs the same number of ranks as the captured run\n\n");
+    printf("\t--prop STRING \t Propagator of the captured run [ve]\n\n");
+    printf("\t--precision STRING \t Precision of the captured run, mixed or double [mixed]\n\n");
+    printf("\t--keys NUM \t SFC key width of the captured run, 32 or 64 [64]\n\n");
+    printf("\t-r NUM \t\t Number of timed force evaluations [5]\n\n");
+    printf("\t--warmup NUM \t Number of force evaluations before timing [1]\n\n");
+    printf("\t--avclean \t Use artificial viscosity cleaning as in the captured run\n\n");
+    printf("\t--compact-multipoles, --mutual-p2p \t Gravity options as in the captured run\n\n");
+    printf("\t--comm-stats \t Print the traffic of each phase of the last force evaluation\n\n");
+}
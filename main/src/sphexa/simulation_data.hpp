@@ -38,16 +38,20 @@
 namespace sphexa
 {
 
-//! @brief the place to store hydro, chemistry, nuclear and other simulation data
-template<class AccType>
+/*! @brief the place to store hydro, chemistry, nuclear and other simulation data
+ *
+ * @tparam AccType  CpuTag or GpuTag
+ * @tparam Types    key and floating point types of the particle data, see sph::SphTypeConfig
+ */
+template<class AccType, class Types = sph::SphTypes>
 class SimulationData
 {
 public:
     using AcceleratorType = AccType;
-    using KeyType         = sph::SphTypes::KeyType;
-    using RealType        = sph::SphTypes::CoordinateType;
+    using KeyType         = typename Types::KeyType;
+    using RealType        = typename Types::CoordinateType;
 
-    using HydroData = ParticlesData<AccType>;
+    using HydroData = ParticlesData<AccType, Types>;
     using ChemData  = cooling::ChemistryData<RealType>;
 
     //! @brief spacially distributed data for hydrodynamics and gravity
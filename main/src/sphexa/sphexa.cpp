@@ -35,16 +35,23 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <optional>
 #include <string>
 
 #include "cstone/domain/domain.hpp"
+#include "cstone/domain/rank_topology.hpp"
+#include "cstone/primitives/mpi_progress.hpp"
 
 #include "init/factory.hpp"
 #include "io/arg_parser.hpp"
+#include "io/domain_checkpoint.hpp"
 #include "io/factory.hpp"
+#include "io/workload_trace.hpp"
 #include "observables/factory.hpp"
 #include "propagator/factory.hpp"
 #include "sph/types.hpp"
+#include "util/auto_tuner.hpp"
+#include "util/cpu_dispatch.hpp"
 #include "util/timer.hpp"
 #include "util/utils.hpp"
 
@@ -65,10 +72,22 @@ bool syncedWallClockElapsed(float totalTimeElapsed, float wallClockLimit, float
 void printHelp(char* binName, int rank);
 int  getNumLocalRanks(int);
 
+template<class Types>
+int runSimulation(int argc, char** argv, const ArgParser& parser, int rank, int numRanks);
+
+template<template<class> class Precision>
+int dispatchKeyType(int argc, char** argv, const ArgParser& parser, int rank, int numRanks);
+
+template<class KeyType, class T, class Acc>
+size_t checkKeyResolution(const cstone::Domain<KeyType, T, Acc>& domain);
+
 int main(int argc, char** argv)
 {
-    auto [rank, numRanks] = initMpi();
+#ifdef SPH_EXA_CPU_DISPATCH
+    execBestCpuVariant(argv, SPH_EXA_CPU_DISPATCH);
+#endif
     const ArgParser parser(argc, (const char**)argv);
+    auto [rank, numRanks] = initMpi(parser.exists("--mpi-progress"));
 
     if (parser.exists("-h") || parser.exists("--h") || parser.exists("-help") || parser.exists("--help"))
     {
@@ -76,8 +95,44 @@ int main(int argc, char** argv)
         return exitSuccess();
     }
 
-    using Dataset = SimulationData<AccType>;
-    using Domain  = cstone::Domain<sph::SphTypes::KeyType, sph::SphTypes::CoordinateType, AccType>;
+    if (parser.exists("--node-order") || parser.exists("--topology"))
+    {
+        std::string topology;
+        if (rank == 0 && parser.exists("--topology"))
+        {
+            std::ifstream topologyFile(parser.get("--topology"));
+            if (!topologyFile) { throw std::runtime_error("Cannot open topology file " + parser.get("--topology")); }
+            topology.assign(std::istreambuf_iterator<char>(topologyFile), std::istreambuf_iterator<char>());
+        }
+        // consecutive SFC segments are assigned to consecutive ranks of the domain communicator
+        domainComm() = cstone::topologyOrderedComm(MPI_COMM_WORLD, topology);
+    }
+
+    const std::string precision = parser.get("--precision", std::string("mixed"));
+    if (precision == "mixed") { return dispatchKeyType<sph::MixedPrecision>(argc, argv, parser, rank, numRanks); }
+    if (precision == "double") { return dispatchKeyType<sph::DoublePrecision>(argc, argv, parser, rank, numRanks); }
+
+    throw std::runtime_error("Unknown precision choice " + precision + ", choose mixed or double\n");
+}
+
+//! @brief select the SFC key type for the chosen precision configuration
+template<template<class> class Precision>
+int dispatchKeyType(int argc, char** argv, const ArgParser& parser, int rank, int numRanks)
+{
+    const int keyBits = parser.get("--keys", 64);
+    if (keyBits == 32) { return runSimulation<Precision<uint32_t>>(argc, argv, parser, rank, numRanks); }
+    if (keyBits == 64) { return runSimulation<Precision<uint64_t>>(argc, argv, parser, rank, numRanks); }
+
+    throw std::runtime_error("Unsupported SFC key width " + std::to_string(keyBits) + ", choose 32 or 64\n");
+}
+
+//! @brief set up and run the simulation with the key and floating point types of @p Types
+template<class Types>
+int runSimulation(int argc, char** argv, const ArgParser& parser, int rank, int numRanks)
+{
+    using KeyType = typename Types::KeyType;
+    using Dataset = SimulationData<AccType, Types>;
+    using Domain  = cstone::Domain<KeyType, typename Types::CoordinateType, AccType>;
 
     const std::string        initCond     = parser.get("--init");
     const size_t             problemSize  = parser.get("-n", 50);
@@ -95,6 +150,7 @@ int main(int argc, char** argv)
     const std::string        profFreqStr  = parser.get("--profile", maxStepStr);
     const bool               profEnabled  = parser.exists("--profile");
     const std::string        pmroot       = parser.get("--pmroot", std::string("/sys/cray/pm_counters"));
+    const int                traceStep    = parser.get("--trace", -1);
     std::string              outFile      = parser.get("-o", "dump_" + removeModifiers(initCond));
 
     std::ofstream nullOutput("/dev/null");
@@ -106,7 +162,7 @@ int main(int argc, char** argv)
     auto fileReader  = fileReaderFactory(ascii, MPI_COMM_WORLD);
     auto simInit     = initializerFactory<Dataset>(initCond, glassBlock, fileReader.get());
     auto propagator  = propagatorFactory<Domain, Dataset>(propChoice, avClean, output, rank, simInit->constants());
-    auto observables = observablesFactory<Dataset>(simInit->constants(), constantsFile);
+    auto observables = observablesFactory<Dataset>(initCond, simInit->constants(), constantsFile);
 
     Dataset simData;
     simData.comm = MPI_COMM_WORLD;
@@ -119,12 +175,15 @@ int main(int argc, char** argv)
     propagator->activateFields(simData);
     propagator->load(initCond, fileReader.get());
     auto box = simInit->init(rank, numRanks, problemSize, simData, fileReader.get());
+    if (parser.exists("--tiled-sfc")) { box = box.withTiling(true); }
 
     auto& d = simData.hydro;
     transferAllocatedToDevice(d, 0, d.x.size(), propagator->conservedFields());
     simData.setOutputFields(outputFields.empty() ? propagator->conservedFields() : outputFields);
 
     if (parser.exists("--G")) { d.g = parser.get<double>("--G"); }
+    d.compactMultipoles = parser.exists("--compact-multipoles");
+    d.mutualP2P         = parser.exists("--mutual-p2p");
     bool  haveGrav = (d.g != 0.0);
     float theta    = parser.get("--theta", haveGrav ? 0.5f : 1.0f);
 
@@ -135,8 +194,40 @@ int main(int argc, char** argv)
     uint64_t bucketSizeFocus = 64;
     // ~100 global nodes per rank to decompose the domain with +-1% accuracy
     uint64_t bucketSize = std::max(bucketSizeFocus, d.numParticlesGlobal / (100 * numRanks));
-    Domain   domain(rank, numRanks, bucketSize, bucketSizeFocus, theta, box);
+    int      domainRank;
+    MPI_Comm_rank(domainComm(), &domainRank);
+    Domain domain(domainRank, numRanks, bucketSize, bucketSizeFocus, theta, box);
     domain.setGrowthAllocRate(simData.hydro.getAllocGrowthRate());
+    float leafCostRatio = parser.get("--leaf-cost-ratio", 1.0f);
+    domain.setMaxLeafCostRatio(leafCostRatio);
+
+    AutoTuner tuner(output);
+    if (parser.exists("--autotune"))
+    {
+        // larger theta is less accurate, only explore values up to the user-provided maximum
+        float thetaMax = parser.get("--theta-max", theta);
+        tuner.add({"theta", theta, 1.1, 0.5 * theta, thetaMax});
+        tuner.add({"bucketSizeFocus", double(bucketSizeFocus), 1.5, 16, double(bucketSize), true});
+    }
+
+    std::optional<cstone::MpiProgressThread> progressThread;
+    if (parser.exists("--mpi-progress"))
+    {
+        progressThread.emplace(std::chrono::microseconds(parser.get("--mpi-progress-interval", 50)));
+    }
+
+    // bytes, messages and peers of each timer phase, summarized across ranks after each iteration and kept per step
+    // for the --profile output
+    cstone::commAccounting().setEnabled(parser.exists("--comm-stats"));
+    propagator->keepCommHistory(profEnabled);
+
+    // restarts from checkpoints skip the initial convergence of the domain decomposition
+    if (fs::exists(strBeforeSign(initCond, ":")) &&
+        readDomainCheckpoint(domain, d.iteration, domainCheckpointPath(removeModifiers(initCond)),
+                             numberAfterSign(initCond, ":"), fileReader.get()))
+    {
+        output << "Domain decomposition restored from checkpoint" << std::endl;
+    }
 
     propagator->sync(domain, simData);
     if (rank == 0) std::cout << "Domain synchronized, nLocalParticles " << d.x.size() << std::endl;
@@ -146,11 +237,36 @@ int main(int argc, char** argv)
 
     size_t startIteration    = d.iteration;
     bool   isOutputTriggered = false;
+    size_t nextKeyCheck      = d.iteration;
 
     for (bool keepRunning = true; keepRunning; d.iteration++)
     {
+        if (traceStep >= 0 && d.iteration == size_t(traceStep))
+        {
+            fs::path    outPath(outFile);
+            std::string traceBase = (outPath.parent_path() / (outPath.stem().string() + "_trace" +
+                                                              std::to_string(traceStep))).string();
+            auto        traceWriter = fileWriterFactory(false, MPI_COMM_SELF);
+            writeWorkloadTrace(workloadTracePath(traceBase, domainRank), simInit->constants(), domain, simData,
+                               *propagator, traceWriter.get());
+            output << "Workload trace written to " << traceBase << "_<rank>.h5" << std::endl;
+        }
+
         propagator->computeForces(domain, simData);
         box = domain.box();
+        // neighbor counts of fully synced steps serve as leaf cost estimates for the next focus tree update
+        if (leafCostRatio > 1.0f && propagator->isSynced() && d.nc.size() == d.x.size())
+        {
+            domain.setParticleCosts(d.nc.data());
+        }
+
+        if constexpr (sizeof(KeyType) < sizeof(uint64_t))
+        {
+            if (propagator->isSynced() && d.iteration >= nextKeyCheck)
+            {
+                nextKeyCheck = d.iteration + checkKeyResolution(domain);
+            }
+        }
 
         if (propagator->isSynced())
         {
@@ -172,6 +288,10 @@ int main(int argc, char** argv)
             propagator->saveFields(fileWriter.get(), domain.startIndex(), domain.endIndex(), simData, box);
             propagator->save(fileWriter.get());
             fileWriter->closeStep();
+            if (fileWriter->suffix() == ".h5")
+            {
+                writeDomainCheckpoint(domain, d.iteration, domainCheckpointPath(outFile), fileWriter.get());
+            }
             isOutputTriggered = false;
         }
         if (isOutputStep(d.iteration, profFreqStr) || isOutputTime(d.ttot - d.minDt, d.ttot, profFreqStr) ||
@@ -186,12 +306,25 @@ int main(int argc, char** argv)
 
         propagator->integrate(domain, simData);
         propagator->printIterationTimings(domain, simData);
+
+        if (!tuner.parameters().empty())
+        {
+            double stepTime = propagator->stepElapsed();
+            mpiAllreduce(MPI_IN_PLACE, &stepTime, 1, MPI_MAX);
+            if (tuner.update(d.iteration, stepTime))
+            {
+                tuner.broadcast(0, MPI_COMM_WORLD);
+                domain.setTheta(tuner.value(0));
+                domain.setBucketSizeFocus(tuner.value(1));
+            }
+        }
     }
     totalTimer.step("Total execution time of " + std::to_string(d.iteration - startIteration) + " iterations of " +
                     initCond + " up to t = " + std::to_string(d.ttot));
 
     constantsFile.close();
     viz::finalize();
+    if (progressThread) { progressThread->stop(); }
     return exitSuccess();
 }
 
@@ -221,6 +354,29 @@ bool syncedWallClockElapsed(float totalTimeElapsed, float wallClockLimit, float
     return false;
 }
 
+/*! @brief throw if the focus tree on any rank has used up all levels available with the given SFC key type
+ *
+ * With 32-bit keys, the octree is limited to 10 levels, corresponding to a minimum cell edge length of 1/1024 of the
+ * box. Leaves at this level can no longer be split to respect the bucket size, which silently degrades neighbor search
+ * and gravity performance, so we rather stop the simulation.
+ *
+ * @return the number of levels left until the limit is reached. A focus tree update splits nodes by at most one level,
+ *         so the caller can skip the check (and its collective) for this many domain syncs.
+ */
+template<class KeyType, class T, class Acc>
+size_t checkKeyResolution(const cstone::Domain<KeyType, T, Acc>& domain)
+{
+    int depth = domain.focusTree().depth();
+    mpiAllreduce(MPI_IN_PLACE, &depth, 1, MPI_MAX);
+
+    if (depth >= int(cstone::maxTreeLevel<KeyType>{}))
+    {
+        throw std::runtime_error("Focus tree reached the maximum depth of " + std::to_string(depth) + " levels for " +
+                                 std::to_string(8 * sizeof(KeyType)) + "-bit SFC keys, rerun with --keys 64\n");
+    }
+    return cstone::maxTreeLevel<KeyType>{} - depth;
+}
+
 int getNumLocalRanks(int defValue)
 {
     return getenv("SLURM_NTASKS_PER_NODE") == nullptr ? defValue : std::stoi(getenv("SLURM_NTASKS_PER_NODE"));
@@ -243,7 +399,45 @@ void printHelp(char* name, int rank)
 
         printf("\t--G NUM \t Gravitational constant [default dependent on test-case selection]\n\n");
 
-        printf("\t--prop STRING \t Choice of SPH propagator [default: modern SPH]. For standard SPH, use \"std\" \n\n");
+        printf("\t--compact-multipoles \t Exchange multipoles between ranks in single precision and skip empty "
+               "nodes\n\n");
+
+        printf("\t--mutual-p2p \t Evaluate gravity between pairs of nearby leaf cells once for both cells\n\n");
+
+        printf("\t--tiled-sfc \t Tile elongated boxes with cubic SFC domains to keep octree cells cubic\n\n");
+
+        printf("\t--prop STRING \t Choice of SPH propagator [default: modern SPH]. For standard SPH, use \"std\" \n");
+        printf("\t\t\t For planar simulations with 2D kernels, use \"std-2d\" with --init kelvin-helmholtz-2d\n\n");
+
+        printf("\t--node-order \t Assign consecutive SFC segments to ranks on the same node\n\n");
+
+        printf("\t--topology FILE \t Like --node-order, but also group nodes into network groups listed in FILE\n"
+               "\t\t\t with one \"<hostname> <group id>\" line per node\n\n");
+
+        printf("\t--mpi-progress \t Drive MPI communication from a background thread while computing.\n"
+               "\t\t\t Requires MPI_THREAD_MULTIPLE support, best used with one core per rank left to the thread\n\n");
+
+        printf("\t--mpi-progress-interval NUM \t Pause between two progress polls in microseconds [50],\n"
+               "\t\t\t increases up to 16x while outstanding halo receives do not complete\n\n");
+
+        printf("\t--comm-stats \t Print min/mean/max across ranks of the bytes, messages and peers sent in each\n"
+               "\t\t\t timed phase after every iteration. Included in --profile output as well\n\n");
+
+        printf("\t--trace NUM \t Write the particles and domain decomposition of each rank at the start of iteration\n"
+               "\t\t\t NUM to <output>_trace<NUM>_<rank>.h5 for replay with sphexa-replay\n\n");
+
+        printf("\t--autotune \t Tune theta and the focus tree bucket size online for minimum time per step\n\n");
+
+        printf("\t--theta-max NUM \t Largest theta the tuner may select [default: --theta]\n\n");
+
+        printf("\t--leaf-cost-ratio NUM \t Maximum factor by which focus tree leaf sizes may deviate from the bucket\n"
+               "\t\t\t size to equalize the neighbor work per leaf [default: 1, disabled]\n\n");
+
+        printf("\t--keys NUM \t Number of bits of the space-filling-curve keys, 32 or 64 [64].\n"
+               "\t\t\t 32-bit keys halve key memory and sort bandwidth, but limit the octree to 10 levels\n\n");
+
+        printf("\t--precision STRING \t Floating point precision of the particle data [default: mixed].\n"
+               "\t\t\t mixed: double coordinates and float hydro fields, double: all fields in double\n\n");
 
         printf("\t-s NUM \t\t int(NUM):  Number of iterations (time-steps) [200],\n\
                 \t real(NUM): Time   of simulation (time-model)\n\n");
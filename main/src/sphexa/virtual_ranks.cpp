@@ -0,0 +1,168 @@
+/*
+ * MIT License
+ *
+ * SPH-EXA
+ * Copyright (c) 2024 CSCS, ETH Zurich, University of Basel, University of Zurich
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*! @file
+ * @brief Predict load balance and halo traffic of a large number of ranks on a single process
+ *
+ * The particle distribution of a test case or snapshot is generated or read on a single rank. The decomposition
+ * into the requested number of virtual ranks is then computed with cstone::simulateVirtualRanks, which reports the
+ * particle and halo counts and the number of peers that each rank would have after the first domain sync.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+
+#include "cstone/domain/domain.hpp"
+#include "cstone/domain/virtual_ranks.hpp"
+#include "cstone/primitives/gather.hpp"
+
+#include "init/factory.hpp"
+#include "io/arg_parser.hpp"
+#include "io/factory.hpp"
+#include "propagator/factory.hpp"
+#include "sph/types.hpp"
+#include "util/utils.hpp"
+
+#include "simulation_data.hpp"
+
+using namespace sphexa;
+
+using Types   = sph::MixedPrecision<uint64_t>;
+using KeyType = typename Types::KeyType;
+using Dataset = SimulationData<cstone::CpuTag, Types>;
+using Domain  = cstone::Domain<KeyType, typename Types::CoordinateType, cstone::CpuTag>;
+
+void printHelp(char* binName);
+
+//! @brief print min, mean and max of @p metric across virtual ranks and the ratio of max to mean
+template<class F>
+void printMetric(const std::string& name, const std::vector<cstone::VirtualRankStats>& stats, F&& metric)
+{
+    std::vector<double> values(stats.size());
+    std::transform(stats.begin(), stats.end(), values.begin(), metric);
+
+    double minVal  = *std::min_element(values.begin(), values.end());
+    double maxVal  = *std::max_element(values.begin(), values.end());
+    double meanVal = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+
+    std::cout << std::left << std::setw(20) << name << std::right << std::setw(14) << minVal << std::setw(14) << meanVal
+              << std::setw(14) << maxVal << std::setw(10) << (meanVal > 0 ? maxVal / meanVal : 0.0) << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    auto [rank, numRanks] = initMpi();
+    const ArgParser parser(argc, (const char**)argv);
+
+    if (parser.exists("-h") || parser.exists("--help") || !parser.exists("--init"))
+    {
+        if (rank == 0) { printHelp(argv[0]); }
+        return exitSuccess();
+    }
+    if (numRanks != 1) { throw std::runtime_error("Virtual ranks are simulated on a single MPI rank\n"); }
+
+    const std::string initCond        = parser.get("--init");
+    const size_t      problemSize     = parser.get("-n", 50);
+    const std::string glassBlock      = parser.get("--glass");
+    const std::string propChoice      = parser.get("--prop", std::string("ve"));
+    const int         numVirtualRanks = parser.get("--ranks", 1024);
+    const float       theta           = parser.get("--theta", 0.5f);
+    const double      haloBytes       = parser.get("--halo-bytes", 5.0 * sizeof(typename Types::CoordinateType));
+    const std::string outFile         = parser.get("-o", std::string(""));
+
+    std::ofstream nullOutput("/dev/null");
+    auto          fileReader = fileReaderFactory(false, MPI_COMM_WORLD);
+    auto          simInit    = initializerFactory<Dataset>(initCond, glassBlock, fileReader.get());
+    auto propagator = propagatorFactory<Domain, Dataset>(propChoice, false, nullOutput, rank, simInit->constants());
+
+    Dataset simData;
+    simData.comm = MPI_COMM_WORLD;
+    propagator->activateFields(simData);
+    auto  box = simInit->init(rank, numRanks, problemSize, simData, fileReader.get());
+    auto& d   = simData.hydro;
+
+    size_t numParticles = d.x.size();
+    std::cout << "Data generated for " << numParticles << " particles, simulating " << numVirtualRanks << " ranks\n";
+
+    // same tree parameters as in the main application
+    unsigned bucketSizeFocus = 64;
+    unsigned bucketSize      = std::max<uint64_t>(bucketSizeFocus, numParticles / (100 * numVirtualRanks));
+
+    std::vector<KeyType> keys(numParticles);
+    computeSfcKeys(d.x.data(), d.y.data(), d.z.data(), cstone::sfcKindPointer(keys.data()), numParticles, box);
+    std::vector<cstone::LocalIndex> order(numParticles);
+    std::iota(order.begin(), order.end(), 0);
+    cstone::sort_by_key(keys.begin(), keys.end(), order.begin());
+    std::vector<typename Types::HydroType> h(numParticles);
+    cstone::gather<cstone::LocalIndex>(order, d.h.data(), h.data());
+
+    auto stats = cstone::simulateVirtualRanks<KeyType>(numVirtualRanks, keys, h.data(), box, bucketSize,
+                                                       bucketSizeFocus, theta);
+
+    std::cout << std::left << std::setw(20) << "#" << std::right << std::setw(14) << "min" << std::setw(14) << "mean"
+              << std::setw(14) << "max" << std::setw(10) << "max/mean" << std::endl;
+    printMetric("particles", stats, [](const auto& s) { return s.numParticles; });
+    printMetric("halos received", stats, [](const auto& s) { return s.numHalosRecv; });
+    printMetric("halos sent", stats, [](const auto& s) { return s.numHalosSent; });
+    printMetric("halo bytes sent", stats, [haloBytes](const auto& s) { return s.numHalosSent * haloBytes; });
+    printMetric("halo peers", stats, [](const auto& s) { return s.numHaloPeers; });
+    printMetric("focus peers", stats, [](const auto& s) { return s.numFocusPeers; });
+    printMetric("focus tree leaves", stats, [](const auto& s) { return s.numFocusLeaves; });
+
+    if (!outFile.empty())
+    {
+        std::ofstream out(outFile);
+        out << "# rank particles halosRecv halosSent haloBytesRecv haloBytesSent haloPeers focusPeers focusLeaves\n";
+        for (int i = 0; i < numVirtualRanks; ++i)
+        {
+            const auto& s = stats[i];
+            out << i << " " << s.numParticles << " " << s.numHalosRecv << " " << s.numHalosSent << " "
+                << s.numHalosRecv * haloBytes << " " << s.numHalosSent * haloBytes << " " << s.numHaloPeers << " "
+                << s.numFocusPeers << " " << s.numFocusLeaves << "\n";
+        }
+    }
+
+    return exitSuccess();
+}
+
+void printHelp(char* name)
+{
+    printf("\nUsage:\n\n");
+    printf("%s [OPTIONS]\n", name);
+    printf("\nWhere possible options are:\n\n");
+
+    printf("\t--init \t\t Test case selection as in sphexa, or an HDF5 file with a snapshot\n\n");
+    printf("\t-n NUM \t\t Initialize data with NUM^3 particles [50]\n");
+    printf("\t--glass FILE\t Use glass block as template to generate initial x,y,z configuration\n\n");
+    printf("\t--prop STRING \t Propagator whose fields are allocated for the initialization [ve]\n\n");
+    printf("\t--ranks NUM \t Number of virtual ranks to decompose the particles into [1024]\n\n");
+    printf("\t--theta NUM \t Opening angle of the MAC that determines peers and focus tree resolution [0.5]\n\n");
+    printf("\t--halo-bytes NUM \t Bytes per halo particle and step to estimate the halo traffic [5 coordinates]\n\n");
+    printf("\t-o FILE \t Write the metrics of each virtual rank to FILE\n\n");
+}
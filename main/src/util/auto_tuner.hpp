@@ -0,0 +1,222 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 CSCS, ETH Zurich, University of Basel, University of Zurich
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*! @file
+ * @brief Online tuning of performance parameters based on measured time-step durations
+ *
+ * The tuner cycles through the registered parameters. For each parameter, the current value and its two neighbors
+ * (value * factor and value / factor, within bounds) are each timed over a few steps, and the fastest is kept. After
+ * all parameters were tried, the tuner pauses for a number of steps and then starts over, since optimal values drift
+ * as the simulation evolves.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <mpi.h>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace sphexa
+{
+
+struct TunableParameter
+{
+    std::string name;
+    double      value;
+    //! @brief neighboring values to explore are value * factor and value / factor
+    double factor;
+    double minValue;
+    double maxValue;
+    //! @brief round candidate values to integers
+    bool integral{false};
+};
+
+class AutoTuner
+{
+public:
+    /*! @brief constructor
+     *
+     * @param log             stream for logging of tuning decisions
+     * @param warmupSteps     number of steps to discard after changing a parameter value
+     * @param samplesPerTrial number of time-steps to average per candidate value
+     * @param pauseSteps      number of steps between tuning cycles
+     * @param minGain         minimum relative speedup over the current value required to switch to a new value
+     */
+    explicit AutoTuner(std::ostream& log, int warmupSteps = 1, int samplesPerTrial = 3, int pauseSteps = 50,
+                       double minGain = 0.02)
+        : log_(log)
+        , warmupSteps_(warmupSteps)
+        , samplesPerTrial_(samplesPerTrial)
+        , pauseSteps_(pauseSteps)
+        , minGain_(minGain)
+    {
+    }
+
+    //! @brief register a parameter to tune, returns its index
+    size_t add(TunableParameter p)
+    {
+        p.value = std::clamp(p.value, p.minValue, p.maxValue);
+        params_.push_back(std::move(p));
+        return params_.size() - 1;
+    }
+
+    //! @brief current value of parameter @p i
+    double value(size_t i) const { return params_[i].value; }
+
+    const std::vector<TunableParameter>& parameters() const { return params_; }
+
+    /*! @brief feed the duration of the last time-step
+     *
+     * @param iteration  current iteration, used for logging only
+     * @param stepTime   duration of the last time-step, must be identical on all ranks
+     * @return           true if a parameter value changed and needs to be applied
+     */
+    bool update(size_t iteration, double stepTime)
+    {
+        if (params_.empty()) { return false; }
+
+        if (pauseCounter_ > 0)
+        {
+            --pauseCounter_;
+            if (pauseCounter_ == 0) { return startTrial(); }
+            return false;
+        }
+
+        if (candidates_.empty()) { return startTrial(); }
+
+        if (skipCounter_ > 0)
+        {
+            --skipCounter_;
+            return false;
+        }
+
+        timings_[currentCandidate_] += stepTime;
+        if (++sampleCounter_ < samplesPerTrial_) { return false; }
+
+        // all samples for the current candidate collected
+        sampleCounter_ = 0;
+        if (++currentCandidate_ < candidates_.size()) { return setValue(candidates_[currentCandidate_]); }
+
+        return finishParameter(iteration);
+    }
+
+    /*! @brief make sure that all ranks use the parameter values of @p root
+     *
+     * Since update() is deterministic given identical step times, values should already agree, but the broadcast
+     * excludes any divergence due to floating point differences in the step times.
+     */
+    void broadcast(int root, MPI_Comm comm)
+    {
+        std::vector<double> values(params_.size());
+        for (size_t i = 0; i < params_.size(); ++i)
+        {
+            values[i] = params_[i].value;
+        }
+        MPI_Bcast(values.data(), int(values.size()), MPI_DOUBLE, root, comm);
+        for (size_t i = 0; i < params_.size(); ++i)
+        {
+            params_[i].value = values[i];
+        }
+    }
+
+private:
+    double round(const TunableParameter& p, double v) const
+    {
+        v = std::clamp(v, p.minValue, p.maxValue);
+        return p.integral ? std::round(v) : v;
+    }
+
+    //! @brief set up the candidate values for the current parameter and apply the first one
+    bool startTrial()
+    {
+        const auto& p = params_[currentParam_];
+
+        candidates_ = {p.value};
+        for (double v : {round(p, p.value * p.factor), round(p, p.value / p.factor)})
+        {
+            if (std::find(candidates_.begin(), candidates_.end(), v) == candidates_.end()) { candidates_.push_back(v); }
+        }
+        timings_.assign(candidates_.size(), 0.0);
+        currentCandidate_ = 0;
+        sampleCounter_    = 0;
+        skipCounter_      = 0;
+        return setValue(candidates_[0]);
+    }
+
+    bool setValue(double v)
+    {
+        auto& p      = params_[currentParam_];
+        bool changed = p.value != v;
+        p.value      = v;
+        skipCounter_ = changed ? warmupSteps_ : 0;
+        return changed;
+    }
+
+    bool finishParameter(size_t iteration)
+    {
+        auto&  p        = params_[currentParam_];
+        size_t best     = std::min_element(timings_.begin(), timings_.end()) - timings_.begin();
+        bool   improves = timings_[best] < (1.0 - minGain_) * timings_[0];
+        double newValue = improves ? candidates_[best] : candidates_[0];
+
+        log_ << "# AutoTuner iteration " << iteration << ": " << p.name;
+        for (size_t i = 0; i < candidates_.size(); ++i)
+        {
+            log_ << " " << candidates_[i] << " (" << timings_[i] / samplesPerTrial_ << "s)";
+        }
+        log_ << " -> " << newValue << std::endl;
+
+        candidates_.clear();
+        currentParam_ = (currentParam_ + 1) % params_.size();
+        if (currentParam_ == 0) { pauseCounter_ = pauseSteps_; }
+
+        bool changed = p.value != newValue;
+        p.value      = newValue;
+        return changed;
+    }
+
+    std::ostream& log_;
+    int           warmupSteps_;
+    int           samplesPerTrial_;
+    int           pauseSteps_;
+    double        minGain_;
+
+    std::vector<TunableParameter> params_;
+
+    //! @brief index of the parameter currently being tuned
+    size_t currentParam_{0};
+    //! @brief candidate values of the current parameter, the first one is the value before tuning
+    std::vector<double> candidates_;
+    //! @brief accumulated step times per candidate
+    std::vector<double> timings_;
+    size_t              currentCandidate_{0};
+    int                 sampleCounter_{0};
+    int                 skipCounter_{0};
+    int                 pauseCounter_{0};
+};
+
+} // namespace sphexa
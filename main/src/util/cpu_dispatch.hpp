@@ -0,0 +1,123 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 CSCS, ETH Zurich, University of Basel, University of Zurich
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*! @file
+ * @brief Startup selection of the executable variant compiled for the best instruction set of the host CPU
+ *
+ * Portable builds configured with SPH_EXA_CPU_TARGETS compile the application for a baseline ISA and install
+ * additional variants compiled with -march=<isa> as <executable>-<isa> next to it. Since all hot CPU kernels are
+ * header-only templates, each variant contains fully vectorized versions of all of them. The baseline executable
+ * replaces itself with the best supported variant before MPI is initialized.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+
+#if defined(__aarch64__) && defined(__linux__)
+#include <sys/auxv.h>
+#endif
+
+namespace sphexa
+{
+
+struct IsaVariant
+{
+    //! @brief the -march value the variant was compiled with, used as suffix of the executable name
+    const char* name;
+    //! @brief returns true if the host CPU can execute the variant
+    bool (*isSupported)();
+};
+
+#if defined(__x86_64__)
+
+inline bool haveX86_64_v2()
+{
+    return __builtin_cpu_supports("popcnt") && __builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("ssse3");
+}
+
+inline bool haveX86_64_v3()
+{
+    return haveX86_64_v2() && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2") &&
+           __builtin_cpu_supports("fma");
+}
+
+inline bool haveX86_64_v4()
+{
+    return haveX86_64_v3() && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+           __builtin_cpu_supports("avx512cd") && __builtin_cpu_supports("avx512dq") &&
+           __builtin_cpu_supports("avx512vl");
+}
+
+//! @brief candidate variants in decreasing order of preference, also parsed by CMake to validate SPH_EXA_CPU_TARGETS
+inline constexpr std::array isaVariants{IsaVariant{"x86-64-v4", haveX86_64_v4}, IsaVariant{"x86-64-v3", haveX86_64_v3},
+                                        IsaVariant{"x86-64-v2", haveX86_64_v2}};
+
+#elif defined(__aarch64__) && defined(__linux__)
+
+inline bool haveSve() { return getauxval(AT_HWCAP) & HWCAP_SVE; }
+
+//! @brief candidate variants in decreasing order of preference, also parsed by CMake to validate SPH_EXA_CPU_TARGETS
+inline constexpr std::array isaVariants{IsaVariant{"armv8.2-a+sve", haveSve}};
+
+#else
+
+inline constexpr std::array<IsaVariant, 0> isaVariants{};
+
+#endif
+
+/*! @brief replace the running process with the best variant of the executable supported by the host CPU
+ *
+ * @param argv      command line arguments, passed on unchanged
+ * @param baseline  the -march value of the running executable, only variants preferred over it are considered
+ *
+ * Returns without effect if no supported variant is installed or if SPH_EXA_NO_CPU_DISPATCH is set in the
+ * environment. Must be called before MPI_Init.
+ */
+inline void execBestCpuVariant(char** argv, std::string_view baseline)
+{
+    if (std::getenv("SPH_EXA_NO_CPU_DISPATCH")) { return; }
+
+    std::error_code ec;
+    auto            self = std::filesystem::read_symlink("/proc/self/exe", ec);
+    if (ec) { return; }
+
+    for (const auto& variant : isaVariants)
+    {
+        // all remaining variants are weaker than or equal to the running executable
+        if (variant.name == baseline) { return; }
+        if (!variant.isSupported()) { continue; }
+
+        auto candidate = self.parent_path() / (self.filename().string() + "-" + variant.name);
+        // execv only returns on failure, in which case we try the next variant
+        if (access(candidate.c_str(), X_OK) == 0) { execv(candidate.c_str(), argv); }
+    }
+}
+
+} // namespace sphexa
@@ -1,7 +1,13 @@
 #pragma once
 
+#include <mpi.h>
+#include <algorithm>
 #include <chrono>
 #include <iostream>
+#include <string>
+#include <vector>
+
+#include "cstone/primitives/mpi_accounting.hpp"
 
 #if defined(USE_PROFILING_NVTX) || defined(USE_PROFILING_SCOREP)
 
@@ -42,16 +48,67 @@ public:
     {
         numStartCalled++;
         tstart = tlast = Clock::now();
+        iterationBegin = stepTimes.size();
+        if (!keepAllVolumes) { stepVolumes.clear(); }
+        // traffic before the first phase is not attributed to it
+        cstone::commAccounting().collect();
     }
 
+    //! @brief keep the traffic of all iterations for writeTimings, by default only the current iteration is kept
+    void keepCommHistory(bool keep) { keepAllVolumes = keep; }
+
     void step(const std::string& name)
     {
         auto now = Clock::now();
         stepTimes.push_back(stepDuration(now));
+        stepPhases.push_back(phaseIndex(name));
+        if (cstone::commAccounting().enabled()) { stepVolumes.push_back(cstone::commAccounting().collect()); }
         if (!name.empty()) { out << "# " << name << ": " << stepTimes.back() << "s" << std::endl; }
         tlast = now;
     }
 
+    /*! @brief print min/mean/max across ranks of the traffic in each phase since the last call of start()
+     *
+     * Collective on @p comm. Phases without messages on any rank are skipped.
+     */
+    void printCommSummary(MPI_Comm comm)
+    {
+        size_t numPhases = stepTimes.size() - iterationBegin;
+        if (!cstone::commAccounting().enabled() || stepVolumes.size() < numPhases) { return; }
+
+        constexpr int numMetrics   = 3;
+        size_t        volumesBegin = stepVolumes.size() - numPhases;
+
+        std::vector<double> local(numMetrics * numPhases);
+        for (size_t i = 0; i < numPhases; ++i)
+        {
+            const auto& v             = stepVolumes[volumesBegin + i];
+            local[numMetrics * i]     = v.bytesSent;
+            local[numMetrics * i + 1] = v.messagesSent;
+            local[numMetrics * i + 2] = v.numPeers;
+        }
+
+        int numRanks;
+        MPI_Comm_size(comm, &numRanks);
+        std::vector<double> minVal(local.size()), maxVal(local.size()), sumVal(local.size());
+        MPI_Reduce(local.data(), minVal.data(), local.size(), MPI_DOUBLE, MPI_MIN, 0, comm);
+        MPI_Reduce(local.data(), maxVal.data(), local.size(), MPI_DOUBLE, MPI_MAX, 0, comm);
+        MPI_Reduce(local.data(), sumVal.data(), local.size(), MPI_DOUBLE, MPI_SUM, 0, comm);
+
+        const char* metricNames[numMetrics] = {"bytes", "messages", "peers"};
+        for (size_t i = 0; i < numPhases; ++i)
+        {
+            if (maxVal[numMetrics * i + 1] == 0) { continue; }
+            out << "# comm " << phaseNames[stepPhases[iterationBegin + i]] << ":";
+            for (int m = 0; m < numMetrics; ++m)
+            {
+                size_t j = numMetrics * i + m;
+                out << " " << metricNames[m] << " " << minVal[j] << "/" << sumVal[j] / numRanks << "/" << maxVal[j];
+            }
+            out << " (min/mean/max)" << std::endl;
+        }
+    }
+
     //! @brief time elapsed between tstart and last call of step()
     [[nodiscard]] float sumOfSteps() const { return std::chrono::duration_cast<Time>(tlast - tstart).count(); }
 
@@ -66,19 +123,87 @@ public:
         ar->stepAttribute("numRanks", &numRanks, 1);
         ar->stepAttribute("numIterations", &numStartCalled, 1);
         ar->writeField("timings", stepTimes.data(), stepTimes.size());
+        if (keepAllVolumes && !stepVolumes.empty() && stepVolumes.size() == stepTimes.size())
+        {
+            std::vector<uint64_t> bytes(stepVolumes.size()), messages(stepVolumes.size()), peers(stepVolumes.size());
+            for (size_t i = 0; i < stepVolumes.size(); ++i)
+            {
+                bytes[i]    = stepVolumes[i].bytesSent;
+                messages[i] = stepVolumes[i].messagesSent;
+                peers[i]    = stepVolumes[i].numPeers;
+            }
+            ar->writeField("commBytes", bytes.data(), stepTimes.size() + 1);
+            ar->writeField("commMessages", messages.data(), stepTimes.size() + 2);
+            ar->writeField("commPeers", peers.data(), stepTimes.size() + 3);
+        }
         ar->closeStep();
+        reset();
+    }
 
+    /*! @brief print min/mean/max across ranks of the time per iteration spent in each phase since the last reset
+     *
+     * Collective on @p comm. Phases that occur several times per iteration are summed up.
+     */
+    void printPhaseSummary(MPI_Comm comm)
+    {
+        if (numStartCalled == 0) { return; }
+
+        std::vector<double> local(phaseNames.size(), 0);
+        for (size_t i = 0; i < stepPhases.size(); ++i)
+        {
+            local[stepPhases[i]] += stepTimes[i] / numStartCalled;
+        }
+
+        int numRanks;
+        MPI_Comm_size(comm, &numRanks);
+        std::vector<double> minVal(local.size()), maxVal(local.size()), sumVal(local.size());
+        MPI_Reduce(local.data(), minVal.data(), local.size(), MPI_DOUBLE, MPI_MIN, 0, comm);
+        MPI_Reduce(local.data(), maxVal.data(), local.size(), MPI_DOUBLE, MPI_MAX, 0, comm);
+        MPI_Reduce(local.data(), sumVal.data(), local.size(), MPI_DOUBLE, MPI_SUM, 0, comm);
+
+        out << "# mean time per iteration over " << numStartCalled << " iterations (min/mean/max across ranks)"
+            << std::endl;
+        for (size_t j = 0; j < phaseNames.size(); ++j)
+        {
+            if (phaseNames[j].empty()) { continue; }
+            out << "# " << phaseNames[j] << ": " << minVal[j] << "/" << sumVal[j] / numRanks << "/" << maxVal[j] << "s"
+                << std::endl;
+        }
+    }
+
+    //! @brief discard the timings and traffic of all iterations so far
+    void reset()
+    {
         numStartCalled = 0;
+        iterationBegin = 0;
         stepTimes.clear();
+        stepPhases.clear();
+        stepVolumes.clear();
     }
 
 private:
     float stepDuration(auto now) { return std::chrono::duration_cast<Time>(now - tlast).count(); }
 
-    std::ostream&                  out;
-    std::chrono::time_point<Clock> tstart, tlast;
-    std::vector<float>             stepTimes;
-    int                            numStartCalled{0};
+    //! @brief index of @p name in phaseNames, appended if not yet present
+    int phaseIndex(const std::string& name)
+    {
+        auto it = std::find(phaseNames.begin(), phaseNames.end(), name);
+        if (it == phaseNames.end()) { it = phaseNames.insert(it, name); }
+        return it - phaseNames.begin();
+    }
+
+    std::ostream&                   out;
+    std::chrono::time_point<Clock>  tstart, tlast;
+    std::vector<float>              stepTimes;
+    //! @brief distinct names of all phases passed to step()
+    std::vector<std::string>        phaseNames;
+    //! @brief index into phaseNames of each step
+    std::vector<int>                stepPhases;
+    //! @brief traffic of each step if communication accounting is enabled, see keepCommHistory
+    std::vector<cstone::CommVolume> stepVolumes;
+    bool                            keepAllVolumes{false};
+    size_t                          iterationBegin{0};
+    int                             numStartCalled{0};
 };
 
 } // namespace sphexa
@@ -7,11 +7,20 @@
 namespace sphexa
 {
 
-auto initMpi()
+/*! @brief initialize MPI and print the configuration
+ *
+ * @param threadMultiple  request MPI_THREAD_MULTIPLE, needed for an MPI progress thread
+ */
+auto initMpi(bool threadMultiple = false)
 {
     int rank     = 0;
     int numRanks = 0;
-    MPI_Init(NULL, NULL);
+    if (threadMultiple)
+    {
+        int provided;
+        MPI_Init_thread(NULL, NULL, MPI_THREAD_MULTIPLE, &provided);
+    }
+    else { MPI_Init(NULL, NULL); }
     MPI_Comm_rank(MPI_COMM_WORLD, &rank);
     MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
     if (rank == 0)
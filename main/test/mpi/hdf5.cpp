@@ -28,6 +28,7 @@
  * @author Sebastian Keller <sebastian.f.keller@gmail.com>
  */
 
+#include <algorithm>
 #include <iostream>
 #include <numeric>
 
@@ -285,3 +286,57 @@ TEST(HDF5IO, turbulenceData)
         reader->closeStep();
     }
 }
+
+//! @brief only the first rank opens the file, all ranks receive the data
+TEST(HDF5IO, broadcast)
+{
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    std::string testfile = "broadcast.h5";
+
+    std::vector<double> x(12);
+    std::iota(x.begin(), x.end(), 0.5);
+
+    if (rank == 0)
+    {
+        if (std::filesystem::exists(testfile)) { std::filesystem::remove(testfile); }
+
+        auto writer = makeH5PartWriter(MPI_COMM_SELF);
+        writer->addStep(0, x.size(), testfile);
+        double float64Attr = 0.25;
+        writer->fileAttribute("float64Attr", &float64Attr, 1);
+        writer->writeField("x", x.data(), 0);
+        writer->closeStep();
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    {
+        auto reader = makeH5PartReader(MPI_COMM_WORLD);
+        reader->setStep(testfile, -1, FileMode::broadcast);
+
+        EXPECT_EQ(reader->numParticles(), x.size());
+        EXPECT_EQ(reader->localNumParticles(), x.size());
+
+        auto attributes = reader->fileAttributes();
+        EXPECT_NE(std::find(attributes.begin(), attributes.end(), "float64Attr"), attributes.end());
+        EXPECT_EQ(reader->fileAttributeSize("float64Attr"), 1);
+
+        double float64Attr = 0;
+        reader->fileAttribute("float64Attr", &float64Attr, 1);
+        EXPECT_EQ(float64Attr, 0.25);
+
+        // errors on the reading rank are propagated to all ranks
+        int wrongType;
+        EXPECT_THROW(reader->fileAttribute("float64Attr", &wrongType, 1), std::runtime_error);
+        EXPECT_THROW(reader->fileAttributeSize("missing"), std::runtime_error);
+
+        std::vector<double> xread(reader->localNumParticles());
+        reader->readField("x", xread.data());
+        EXPECT_EQ(xread, x);
+
+        reader->closeStep();
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+}
@@ -0,0 +1,123 @@
+/*
+ * MIT License
+ *
+ * SPH-EXA
+ * Copyright (c) 2024 CSCS, ETH Zurich, University of Basel, University of Zurich
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!@brief tests for the in-situ error norms against analytical solutions
+ */
+
+#include "gtest/gtest.h"
+
+#include "init/sedov_constants.hpp"
+#include "observables/analytical_profiles.hpp"
+
+using namespace sphexa;
+
+TEST(analytical_errors, interpolateProfile)
+{
+    std::vector<double> table{0.0, 1.0, 4.0, 9.0};
+    double              rMax = 3.0;
+
+    EXPECT_NEAR(interpolateProfile(table.data(), table.size(), rMax, 0.0), 0.0, 1e-12);
+    EXPECT_NEAR(interpolateProfile(table.data(), table.size(), rMax, 1.0), 1.0, 1e-12);
+    EXPECT_NEAR(interpolateProfile(table.data(), table.size(), rMax, 1.5), 2.5, 1e-12);
+    EXPECT_NEAR(interpolateProfile(table.data(), table.size(), rMax, 3.0), 9.0, 1e-12);
+    EXPECT_NEAR(interpolateProfile(table.data(), table.size(), rMax, 5.0), 9.0, 1e-12);
+}
+
+TEST(analytical_errors, nohProfile)
+{
+    InitSettings settings{{"r1", 0.5}, {"dim", 3}, {"gamma", 5.0 / 3.0}, {"rho0", 1.0}, {"p0", 0.0}, {"vr0", -1.0}};
+    double       time    = 0.6;
+    auto         profile = nohProfile(settings, time, 1001);
+
+    double gamma      = settings.at("gamma");
+    double shockFront = 0.5 * (gamma - 1) * time;
+    double rhoShocked = std::pow((gamma + 1) / (gamma - 1), 3);
+
+    EXPECT_NEAR(interpolateProfile(profile.rho.data(), profile.numSamples(), profile.rMax, 0.5 * shockFront),
+                rhoShocked, 1e-10);
+    EXPECT_NEAR(interpolateProfile(profile.vel.data(), profile.numSamples(), profile.rMax, 0.5 * shockFront), 0.0,
+                1e-10);
+
+    double r = 0.5;
+    EXPECT_NEAR(interpolateProfile(profile.rho.data(), profile.numSamples(), profile.rMax, r),
+                std::pow(1 + time / r, 2), 1e-4);
+    EXPECT_NEAR(interpolateProfile(profile.vel.data(), profile.numSamples(), profile.rMax, r), 1.0, 1e-10);
+}
+
+TEST(analytical_errors, sedovShockFront)
+{
+    auto settings = sedovConstants();
+    auto profile  = sedovProfile(settings, 0.05, 2001);
+
+    // post-shock density of a strong shock is (gamma + 1) / (gamma - 1) times the ambient density
+    double gamma  = settings.at("gamma");
+    double rhoMax = *std::max_element(profile.rho.begin(), profile.rho.end());
+    EXPECT_NEAR(rhoMax / settings.at("rho0"), (gamma + 1) / (gamma - 1), 0.1);
+
+    EXPECT_NEAR(profile.rho.back(), settings.at("rho0"), 1e-10);
+    EXPECT_NEAR(profile.vel.back(), 0.0, 1e-10);
+}
+
+TEST(analytical_errors, exactParticlesHaveZeroError)
+{
+    using T = double;
+
+    InitSettings settings{{"R1", 0.2}, {"v0", 1.0}, {"P0", 5.0}, {"rho", 1.0}};
+    auto         profile = greshoChanProfile(settings, 1001);
+
+    double gamma = 5.0 / 3.0;
+    double cv    = 1.5;
+
+    std::vector<T> x{0.05, 0.1, 0.3, 0.45}, y{0.0, 0.1, -0.1, 0.0}, z{0.01, -0.02, 0.03, 0.0};
+    std::vector<T> vx(x.size()), vy(x.size()), vz(x.size(), 0.5), rho(x.size(), 1.0), m(x.size(), 1.0);
+    std::vector<T> temp(x.size());
+
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+        double r = std::sqrt(x[i] * x[i] + y[i] * y[i]);
+        double v = interpolateProfile(profile.vel.data(), profile.numSamples(), profile.rMax, r);
+        double p = interpolateProfile(profile.p.data(), profile.numSamples(), profile.rMax, r);
+        vx[i]    = -v * y[i] / r;
+        vy[i]    = v * x[i] / r;
+        temp[i]  = p / ((gamma - 1) * rho[i] * cv);
+    }
+
+    auto errors = localProfileErrors(0, x.size(), x.data(), y.data(), z.data(), vx.data(), vy.data(), vz.data(),
+                                     temp.data(), (T*)nullptr, (T*)nullptr, (T*)nullptr, rho.data(), m.data(), profile,
+                                     cv, gamma, true);
+
+    for (size_t i = 0; i < errors.size(); ++i)
+    {
+        EXPECT_NEAR(errors[i], 0.0, 1e-12);
+    }
+
+    // perturb density of one particle
+    rho[1] += 0.1;
+    errors = localProfileErrors(0, x.size(), x.data(), y.data(), z.data(), vx.data(), vy.data(), vz.data(),
+                                temp.data(), (T*)nullptr, (T*)nullptr, (T*)nullptr, rho.data(), m.data(), profile, cv,
+                                gamma, true);
+    EXPECT_NEAR(errors[0], 0.1, 1e-12);
+    EXPECT_NEAR(errors[1], 0.01, 1e-12);
+}
@@ -0,0 +1,90 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 CSCS, ETH Zurich, University of Basel, University of Zurich
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*! @file
+ * @brief Unit tests for the online parameter tuner
+ */
+
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+#include "util/auto_tuner.hpp"
+
+using namespace sphexa;
+
+//! @brief step time as a function of the parameter value, with a minimum at @p optimum
+static double syntheticStepTime(double value, double optimum) { return 1.0 + std::abs(value - optimum); }
+
+TEST(AutoTuner, convergesToOptimum)
+{
+    std::ostringstream log;
+    AutoTuner          tuner(log, 1, 2, 0);
+    tuner.add({"bucketSize", 64, 2.0, 16, 512, true});
+
+    for (size_t iteration = 0; iteration < 200; ++iteration)
+    {
+        tuner.update(iteration, syntheticStepTime(tuner.value(0), 256));
+    }
+    EXPECT_EQ(tuner.value(0), 256);
+    EXPECT_NE(log.str().find("bucketSize 256"), std::string::npos);
+}
+
+TEST(AutoTuner, respectsBounds)
+{
+    std::ostringstream log;
+    AutoTuner          tuner(log, 0, 1, 0);
+    tuner.add({"theta", 0.5, 1.1, 0.25, 0.6});
+
+    for (size_t iteration = 0; iteration < 200; ++iteration)
+    {
+        // larger values are always faster, but capped at 0.6
+        tuner.update(iteration, 1.0 - tuner.value(0));
+        EXPECT_LE(tuner.value(0), 0.6);
+    }
+    EXPECT_DOUBLE_EQ(tuner.value(0), 0.6);
+}
+
+TEST(AutoTuner, keepsValueWithoutGain)
+{
+    std::ostringstream log;
+    AutoTuner          tuner(log, 0, 1, 0, 0.05);
+    tuner.add({"theta", 0.5, 1.1, 0.25, 1.0});
+
+    for (size_t iteration = 0; iteration < 50; ++iteration)
+    {
+        // differences below the minimum gain
+        tuner.update(iteration, 1.0 - 0.01 * tuner.value(0));
+    }
+
+    // the value may be set to a candidate in the ongoing trial, but all decisions keep the original value
+    std::string decisions = log.str();
+    size_t      numKept = 0, numDecisions = 0;
+    for (size_t pos = 0; (pos = decisions.find("->", pos)) != std::string::npos; ++pos, ++numDecisions)
+    {
+        numKept += decisions.compare(pos, 7, "-> 0.5\n") == 0;
+    }
+    EXPECT_GT(numDecisions, 0u);
+    EXPECT_EQ(numKept, numDecisions);
+}
@@ -54,9 +54,10 @@ public:
     using FieldVariant =
         std::variant<FieldVector<float>*, FieldVector<double>*, FieldVector<unsigned>*, FieldVector<uint64_t>*>;
 
-    //! Grackle field names
-    inline static constexpr auto   fieldNames = make_array(typename Cooler<RealType>::CoolingFields{});
-    inline static constexpr size_t numFields  = fieldNames.size();
+    //! Grackle field names, followed by the state of lazy chemistry updates
+    inline static constexpr auto fieldNames = make_array(
+        util::FuseValueList<typename Cooler<RealType>::CoolingFields, typename Cooler<RealType>::LazyFields>{});
+    inline static constexpr size_t numFields = fieldNames.size();
 
     std::array<FieldVector<T>, numFields> fields;
 
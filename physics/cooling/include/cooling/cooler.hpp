@@ -62,6 +62,13 @@ public:
 
     using CoolingFields = util::FuseValueList<Fractions, Rates>;
 
+    /*! @brief State of the lazy chemistry updates per particle, not passed to Grackle
+     *
+     * Cooling time, cooling rate du/dt and density and internal energy at the last integration with Grackle, as well as
+     * the time elapsed since then. A zero cooling time marks particles that have not been integrated yet.
+     */
+    using LazyFields = util::FieldList<"cooling_time", "cooling_rate", "cooling_elapsed", "cooling_rho", "cooling_u">;
+
     inline static constexpr size_t numFields = util::FieldListSize<CoolingFields>{};
 
     using GrackleFieldPtrs = util::Reduce<std::tuple, util::Repeat<util::TypeList<std::add_pointer_t<T>>, numFields>>;
@@ -102,6 +109,13 @@ public:
     //! @brief Parameter for cooling time criterion
     T ct_crit{0.1};
 
+    //! @brief Fraction of its cooling time after which a particle is integrated again, 0 integrates all particles in
+    //! every step
+    T lazy_ct_fraction{0};
+
+    //! @brief Relative change of density or internal energy since the last integration that triggers a new one
+    T lazy_tolerance{0.05};
+
     template<class Archive>
     void loadOrStoreAttributes(Archive* ar)
     {
@@ -128,6 +142,8 @@ public:
             std::visit([&](auto* location) { optionalIO(std::string(parameterNames[i]), location, 1); }, parameters[i]);
         }
         optionalIO("cooling::ct_crit", &ct_crit, 1);
+        optionalIO("lazy_ct_fraction", &lazy_ct_fraction, 1);
+        optionalIO("lazy_tolerance", &lazy_tolerance, 1);
     }
 
     struct Impl;
@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <limits>
+
 namespace cooling
 {
 
@@ -17,6 +20,22 @@ auto coolingTimestep(size_t first, size_t last, Dataset& d, Cooler& cooler, Chem
     const auto* u         = d.u.data();
     const auto  chemistry = cstone::getPointers(get<CoolingFields>(chem), 0);
 
+    if (cooler.lazy_ct_fraction > 0)
+    {
+        // with lazy updates, use the cooling times of the last integration unless a particle was never integrated
+        const auto* coolingTime = get<"cooling_time">(chem).data();
+
+        T    minStoredCt = std::numeric_limits<T>::max();
+        bool complete    = true;
+#pragma omp parallel for reduction(min : minStoredCt) reduction(&& : complete)
+        for (size_t i = first; i < last; ++i)
+        {
+            minStoredCt = std::min(minStoredCt, T(coolingTime[i]));
+            complete    = complete && coolingTime[i] > 0;
+        }
+        if (complete) { return T(cooler.ct_crit * minStoredCt); }
+    }
+
     T minCt = cooler.cooling_timestep(rho, u, chemistry, first, last);
 
     return minCt;
@@ -0,0 +1,236 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 CSCS, ETH Zurich
+ *               2024 University of Basel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*! @file
+ * @brief Chemistry and cooling integration that skips particles whose cooling time exceeds the time-step
+ *
+ * Particles are integrated with Grackle only once the time elapsed since their last integration reaches a fraction
+ * of their cooling time, or if their density or internal energy changed beyond a tolerance. In between, the cooling
+ * rate of the last integration is applied to the internal energy. On the next integration, the chemistry is evolved
+ * over the whole elapsed interval and the difference to the extrapolated cooling is added to du.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "cstone/fields/field_get.hpp"
+
+#include "cooler_util.hpp"
+
+namespace cooling
+{
+
+namespace detail
+{
+
+template<class Ptrs, class T, size_t... Is>
+Ptrs stridedPointers(T* base, size_t stride, std::index_sequence<Is...>)
+{
+    return Ptrs{(base + Is * stride)...};
+}
+
+/*! @brief integrate the particles in @p indices with Grackle over their elapsed time plus @p dt
+ *
+ * @param[in]    indices     particles to integrate, sorted by their elapsed time
+ * @param[in]    dt          time-step of the current step, 0 to only catch up with the elapsed time
+ * @param[inout] d           hydro data, du is updated if dt > 0, otherwise u is updated directly
+ * @param[inout] chem        Grackle fields and lazy update state
+ *
+ * Particles with equal elapsed times were last integrated in the same step and are passed to Grackle together.
+ */
+template<class HydroData, class ChemData, class Cooler>
+void integrateElapsed(const std::vector<size_t>& indices, double dt, HydroData& d, ChemData& chem, Cooler& cooler)
+{
+    using T                    = typename ChemData::RealType;
+    using Trho                 = typename std::decay_t<decltype(d.rho)>::value_type;
+    using Tu                   = typename std::decay_t<decltype(d.u)>::value_type;
+    using CoolingFields        = typename Cooler::CoolingFields;
+    using GrackleFieldPtrs     = typename Cooler::GrackleFieldPtrs;
+    constexpr size_t numFields = Cooler::numFields;
+
+    auto* coolingTime = cstone::get<"cooling_time">(chem).data();
+    auto* rate        = cstone::get<"cooling_rate">(chem).data();
+    auto* elapsed     = cstone::get<"cooling_elapsed">(chem).data();
+    auto* rhoRef      = cstone::get<"cooling_rho">(chem).data();
+    auto* uRef        = cstone::get<"cooling_u">(chem).data();
+    auto  chemistry   = cstone::getPointers(cstone::get<CoolingFields>(chem), 0);
+
+    for (size_t groupStart = 0; groupStart < indices.size();)
+    {
+        T      groupElapsed = elapsed[indices[groupStart]];
+        size_t groupEnd     = groupStart + 1;
+        while (groupEnd < indices.size() && elapsed[indices[groupEnd]] == groupElapsed)
+        {
+            ++groupEnd;
+        }
+        const size_t* group    = indices.data() + groupStart;
+        size_t        n        = groupEnd - groupStart;
+        T             interval = groupElapsed + dt;
+
+        std::vector<Trho> rhoBuf(n);
+        std::vector<Tu>   uBuf(n), rateBuf(n, 0);
+        std::vector<T>    chemBuf(numFields * n);
+        auto chemBufPtrs = stridedPointers<GrackleFieldPtrs>(chemBuf.data(), n, std::make_index_sequence<numFields>{});
+
+#pragma omp parallel for schedule(static)
+        for (size_t j = 0; j < n; ++j)
+        {
+            size_t i = group[j];
+            rhoBuf[j] = d.rho[i];
+            // remove the cooling that was extrapolated since the last integration
+            uBuf[j] = d.u[i] - rate[i] * elapsed[i];
+        }
+        for_each_tuples(
+            [group, n](const T* src, T* dest)
+            {
+                for (size_t j = 0; j < n; ++j)
+                {
+                    dest[j] = src[group[j]];
+                }
+            },
+            chemistry, chemBufPtrs);
+
+        // with a zero-initialized du, rateBuf is the mean cooling rate over the interval
+        cooler.cool_particles(interval, rhoBuf.data(), uBuf.data(), chemBufPtrs, rateBuf.data(), 0, n);
+
+        for_each_tuples(
+            [group, n](const T* src, T* dest)
+            {
+                for (size_t j = 0; j < n; ++j)
+                {
+                    dest[group[j]] = src[j];
+                }
+            },
+            chemBufPtrs, chemistry);
+
+#pragma omp parallel for schedule(static)
+        for (size_t j = 0; j < n; ++j)
+        {
+            size_t i = group[j];
+            // cooling over the interval that has not been applied by extrapolation
+            Tu correction = rateBuf[j] * interval - rate[i] * elapsed[i];
+            Tu uEnd       = uBuf[j] + rateBuf[j] * interval;
+
+            if (dt > 0) { d.du[i] += correction / dt; }
+            else { d.u[i] += correction; }
+
+            coolingTime[i] = rateBuf[j] != 0 ? std::abs(uEnd / rateBuf[j]) : std::numeric_limits<T>::max();
+            rate[i]        = rateBuf[j];
+            elapsed[i]     = 0;
+            rhoRef[i]      = d.rho[i];
+            uRef[i]        = uEnd;
+        }
+
+        groupStart = groupEnd;
+    }
+}
+
+} // namespace detail
+
+/*! @brief add the cooling rate of the current step to du, integrating only particles that are due with Grackle
+ *
+ * @param[in]    dt          time-step
+ * @param[in]    first       first particle index to cool
+ * @param[in]    last        last particle index to cool
+ * @param[inout] d           hydro data with rho, u and du
+ * @param[inout] chem        Grackle fields and lazy update state, see Cooler::LazyFields
+ * @param[in]    cooler      Grackle interface, integrates all particles in every step if lazy_ct_fraction is 0
+ */
+template<class HydroData, class ChemData, class Cooler>
+void coolParticlesLazy(double dt, size_t first, size_t last, HydroData& d, ChemData& chem, Cooler& cooler)
+{
+    using T             = typename ChemData::RealType;
+    using CoolingFields = typename Cooler::CoolingFields;
+
+    if (!(cooler.lazy_ct_fraction > 0))
+    {
+        auto chemistry = cstone::getPointers(cstone::get<CoolingFields>(chem), 0);
+        cooler.cool_particles(T(dt), d.rho.data(), d.u.data(), chemistry, d.du.data(), first, last);
+        return;
+    }
+
+    const auto* coolingTime = cstone::get<"cooling_time">(chem).data();
+    const auto* rate        = cstone::get<"cooling_rate">(chem).data();
+    auto*       elapsed     = cstone::get<"cooling_elapsed">(chem).data();
+    const auto* rhoRef      = cstone::get<"cooling_rho">(chem).data();
+    const auto* uRef        = cstone::get<"cooling_u">(chem).data();
+
+    T fraction  = cooler.lazy_ct_fraction;
+    T tolerance = cooler.lazy_tolerance;
+
+    std::vector<char> isDue(last - first);
+#pragma omp parallel for schedule(static)
+    for (size_t i = first; i < last; ++i)
+    {
+        bool due = coolingTime[i] <= 0 || elapsed[i] + dt >= fraction * coolingTime[i] ||
+                   std::abs(d.rho[i] - rhoRef[i]) > tolerance * rhoRef[i] ||
+                   std::abs(d.u[i] - uRef[i]) > tolerance * uRef[i];
+        if (!due)
+        {
+            d.du[i] += rate[i];
+            elapsed[i] += dt;
+        }
+        isDue[i - first] = due;
+    }
+
+    std::vector<size_t> dueIndices;
+    for (size_t i = first; i < last; ++i)
+    {
+        if (isDue[i - first]) { dueIndices.push_back(i); }
+    }
+    std::stable_sort(dueIndices.begin(), dueIndices.end(),
+                     [elapsed](size_t a, size_t b) { return elapsed[a] < elapsed[b]; });
+
+    detail::integrateElapsed(dueIndices, dt, d, chem, cooler);
+}
+
+/*! @brief integrate the chemistry of all particles up to the current time, e.g. before writing output
+ *
+ * The internal energy is corrected directly with the difference between the integrated and the extrapolated cooling.
+ */
+template<class HydroData, class ChemData, class Cooler>
+void flushLazyCooling(size_t first, size_t last, HydroData& d, ChemData& chem, Cooler& cooler)
+{
+    if (!(cooler.lazy_ct_fraction > 0)) { return; }
+
+    const auto* elapsed = cstone::get<"cooling_elapsed">(chem).data();
+
+    std::vector<size_t> pendingIndices;
+    for (size_t i = first; i < last; ++i)
+    {
+        if (elapsed[i] > 0) { pendingIndices.push_back(i); }
+    }
+    std::stable_sort(pendingIndices.begin(), pendingIndices.end(),
+                     [elapsed](size_t a, size_t b) { return elapsed[a] < elapsed[b]; });
+
+    detail::integrateElapsed(pendingIndices, 0.0, d, chem, cooler);
+}
+
+} // namespace cooling
@@ -0,0 +1,180 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 CSCS, ETH Zurich
+ *               2024 University of Basel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*! @file
+ * @brief Tests for lazy chemistry updates with an analytic cooling function in place of Grackle
+ */
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cooling/chemistry_data.hpp"
+#include "cooling/eos_cooling.hpp"
+#include "cooling/lazy_cooling.hpp"
+
+using namespace cooling;
+
+namespace
+{
+
+//! @brief exponential decay of u and the HI fraction with a cooling time inversely proportional to the density
+struct ExponentialCooler
+{
+    using CoolingFields    = Cooler<double>::CoolingFields;
+    using LazyFields       = Cooler<double>::LazyFields;
+    using GrackleFieldPtrs = Cooler<double>::GrackleFieldPtrs;
+
+    inline static constexpr size_t numFields = Cooler<double>::numFields;
+
+    double ct_crit{0.1};
+    double lazy_ct_fraction{0};
+    double lazy_tolerance{0.05};
+
+    //! @brief number of particle integrations so far
+    size_t numIntegrated{0};
+
+    template<class Trho, class Tu>
+    void cool_particles(double dt, const Trho* rho, const Tu* u, const GrackleFieldPtrs& chemistry, Tu* du,
+                        size_t first, size_t last)
+    {
+        auto* HI = util::get<"HI_fraction", CoolingFields>(chemistry);
+        for (size_t i = first; i < last; ++i)
+        {
+            double decay = std::exp(-dt * rho[i] / 10.0);
+            du[i] += (u[i] * decay - u[i]) / dt;
+            HI[i] *= decay;
+        }
+        numIntegrated += last - first;
+    }
+
+    template<class Trho, class Tu>
+    double cooling_timestep(const Trho* rho, const Tu*, const GrackleFieldPtrs&, size_t first, size_t last)
+    {
+        return ct_crit * 10.0 / *std::max_element(rho + first, rho + last);
+    }
+};
+
+struct HydroData
+{
+    using RealType = double;
+    std::vector<float>  rho;
+    std::vector<double> u, du;
+};
+
+void setup(size_t n, HydroData& d, ChemistryData<double>& chem)
+{
+    std::apply([&chem](auto... f) { chem.setConserved(f.value...); }, make_tuple(Cooler<double>::CoolingFields{}));
+    std::apply([&chem](auto... f) { chem.setDependent(f.value...); }, make_tuple(Cooler<double>::LazyFields{}));
+    chem.resize(n);
+
+    d.rho.resize(n);
+    d.u.assign(n, 1.0);
+    d.du.assign(n, 0.0);
+    for (size_t i = 0; i < n; ++i)
+    {
+        d.rho[i] = 1.0f + 99.0f * i / (n - 1);
+    }
+    std::fill(cstone::get<"HI_fraction">(chem).begin(), cstone::get<"HI_fraction">(chem).end(), 0.76);
+}
+
+//! @brief integrate u with explicit Euler steps and cooling as the only source of du
+void evolve(int numSteps, double dt, HydroData& d, ChemistryData<double>& chem, ExponentialCooler& cooler)
+{
+    size_t n = d.u.size();
+    for (int step = 0; step < numSteps; ++step)
+    {
+        std::fill(d.du.begin(), d.du.end(), 0.0);
+        coolParticlesLazy(dt, 0, n, d, chem, cooler);
+        for (size_t i = 0; i < n; ++i)
+        {
+            d.u[i] += dt * d.du[i];
+        }
+    }
+    flushLazyCooling(0, n, d, chem, cooler);
+}
+
+} // namespace
+
+//! @brief after a flush, lazy updates reproduce the integration of every particle in every step
+TEST(LazyCooling, matchesEagerIntegration)
+{
+    size_t n        = 100;
+    int    numSteps = 1000;
+    double dt       = 1e-3;
+
+    HydroData             eager, lazy;
+    ChemistryData<double> eagerChem, lazyChem;
+    setup(n, eager, eagerChem);
+    setup(n, lazy, lazyChem);
+
+    ExponentialCooler eagerCooler, lazyCooler;
+    lazyCooler.lazy_ct_fraction = 0.1;
+
+    evolve(numSteps, dt, eager, eagerChem, eagerCooler);
+    evolve(numSteps, dt, lazy, lazyChem, lazyCooler);
+
+    EXPECT_EQ(eagerCooler.numIntegrated, n * numSteps);
+    EXPECT_LT(lazyCooler.numIntegrated, eagerCooler.numIntegrated / 10);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        EXPECT_NEAR(lazy.u[i], eager.u[i], 1e-10 * eager.u[i]);
+        EXPECT_NEAR(get<"HI_fraction">(lazyChem)[i], get<"HI_fraction">(eagerChem)[i], 1e-12);
+        EXPECT_EQ(get<"cooling_elapsed">(lazyChem)[i], 0.0);
+    }
+}
+
+//! @brief changes of the density beyond the tolerance trigger an integration in the next step
+TEST(LazyCooling, densityChange)
+{
+    size_t n  = 10;
+    double dt = 1e-3;
+
+    HydroData             d;
+    ChemistryData<double> chem;
+    setup(n, d, chem);
+
+    ExponentialCooler cooler;
+    cooler.lazy_ct_fraction = 0.1;
+
+    // the first step integrates all particles, the second one none
+    coolParticlesLazy(dt, 0, n, d, chem, cooler);
+    EXPECT_EQ(cooler.numIntegrated, n);
+    coolParticlesLazy(dt, 0, n, d, chem, cooler);
+    EXPECT_EQ(cooler.numIntegrated, n);
+    EXPECT_EQ(get<"cooling_elapsed">(chem)[0], dt);
+
+    // the stored cooling times, derived from the mean rate of the last step, determine the time-step
+    double ctMin = cooler.ct_crit * 10.0 / d.rho.back();
+    EXPECT_NEAR(coolingTimestep(0, n, d, cooler, chem), ctMin, 1e-2 * ctMin);
+
+    d.rho[3] *= 1.1;
+    coolParticlesLazy(dt, 0, n, d, chem, cooler);
+    EXPECT_EQ(cooler.numIntegrated, n + 1);
+    EXPECT_EQ(get<"cooling_elapsed">(chem)[3], 0.0);
+    EXPECT_EQ(get<"cooling_elapsed">(chem)[0], 2 * dt);
+}
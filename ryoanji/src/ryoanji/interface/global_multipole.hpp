@@ -41,11 +41,44 @@
 namespace ryoanji
 {
 
+/*! @brief wire format for multipole exchanges between ranks
+ *
+ * Multipoles are stored relative to their expansion centers, such that single precision retains the relative accuracy
+ * of the force evaluation. Nodes without mass have all moments equal to zero and are skipped by peer exchanges.
+ */
+template<class MType>
+struct CompactMultipoleCodec
+{
+    using WireType = util::array<float, std::tuple_size_v<MType>>;
+
+    bool skip(const MType& m) const { return m[Cqi::mass] == 0; }
+
+    WireType encode(const MType& m) const
+    {
+        WireType w;
+        for (size_t i = 0; i < w.size(); ++i)
+        {
+            w[i] = float(m[i]);
+        }
+        return w;
+    }
+
+    MType decode(const WireType& w) const
+    {
+        MType m;
+        for (size_t i = 0; i < m.size(); ++i)
+        {
+            m[i] = w[i];
+        }
+        return m;
+    }
+};
+
 template<class Tc, class Tm, class Tf, class KeyType, class MType>
 void computeGlobalMultipoles(const Tc* x, const Tc* y, const Tc* z, const Tm* m, cstone::LocalIndex numParticles,
                              const cstone::Octree<KeyType>&                            globalOctree,
                              const cstone::FocusedOctree<KeyType, Tf, cstone::CpuTag>& focusTree,
-                             const cstone::LocalIndex* layout, MType* multipoles)
+                             const cstone::LocalIndex* layout, MType* multipoles, bool compactExchange = false)
 {
     auto octree        = focusTree.octreeViewAcc();
     auto centers       = focusTree.expansionCentersAcc();
@@ -62,10 +95,21 @@ void computeGlobalMultipoles(const Tc* x, const Tc* y, const Tc* z, const Tm* m,
 
     auto ryUpsweep = [](auto levelRange, auto childOffsets, auto M, auto centers)
     { ryoanji::upsweepMultipoles(levelRange, childOffsets.data(), centers, M); };
-    cstone::globalFocusExchange(globalOctree, focusTree, multipoleSpan, ryUpsweep, globalCenters.data());
+    int peerTag = static_cast<int>(cstone::P2pTags::focusPeerCenters) + 1;
+    if (compactExchange)
+    {
+        CompactMultipoleCodec<MType> codec;
+        cstone::globalFocusExchangeCompact(globalOctree, focusTree, multipoleSpan, codec, ryUpsweep,
+                                           globalCenters.data());
+        focusTree.peerExchangeCompact(multipoleSpan, peerTag, codec);
+    }
+    else
+    {
+        cstone::globalFocusExchange(globalOctree, focusTree, multipoleSpan, ryUpsweep, globalCenters.data());
 
-    std::vector<int, util::DefaultInitAdaptor<int>> scratch;
-    focusTree.peerExchange(multipoleSpan, static_cast<int>(cstone::P2pTags::focusPeerCenters) + 1, scratch);
+        std::vector<int, util::DefaultInitAdaptor<int>> scratch;
+        focusTree.peerExchange(multipoleSpan, peerTag, scratch);
+    }
 
     //! second upsweep with leaf data from peer and global ranks in place
     ryoanji::upsweepMultipoles({octree.levelRange, cstone::maxTreeLevel<KeyType>{} + 2}, octree.childOffsets,
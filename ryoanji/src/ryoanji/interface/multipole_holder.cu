@@ -230,10 +230,14 @@ const MType* MultipoleHolder<Tc, Th, Tm, Ta, Tf, KeyType, MType>::deviceMultipol
 #define MHOLDER_MTYPE(Tc, Th, Tm, Ta, Tf, KeyType, MType)                                                              \
     template class MultipoleHolder<Tc, Th, Tm, Ta, Tf, KeyType, MType>
 
+#define MHOLDER_KEY(KeyType, MType)                                                                                    \
+    MHOLDER_MTYPE(double, double, double, double, double, KeyType, MType<double>);                                     \
+    MHOLDER_MTYPE(double, float, float, float, double, KeyType, MType<float>);                                         \
+    MHOLDER_MTYPE(float, float, float, float, float, KeyType, MType<float>);
+
 #define MHOLDER(MType)                                                                                                 \
-    MHOLDER_MTYPE(double, double, double, double, double, uint64_t, MType<double>);                                    \
-    MHOLDER_MTYPE(double, float, float, float, double, uint64_t, MType<float>);                                        \
-    MHOLDER_MTYPE(float, float, float, float, float, uint64_t, MType<float>);
+    MHOLDER_KEY(uint32_t, MType)                                                                                       \
+    MHOLDER_KEY(uint64_t, MType)
 
 MHOLDER(CartesianQuadrupole)
 MHOLDER(CartesianMDQpole)
@@ -87,4 +87,39 @@ HOST_DEVICE_FUN DEVICE_INLINE Vec4<Ta> P2P(Vec4<Ta> acc, const Vec3<Tc>& pos_i,
     return acc;
 }
 
+/*! @brief symmetric interaction between two particles, adds the contributions of j to i and of i to j
+ *
+ * @param[inout] acc_i  acceleration and potential of particle i to add to
+ * @param[inout] acc_j  acceleration and potential of particle j to add to
+ *
+ * Equivalent to acc_i = P2P(acc_i, pos_i, pos_j, m_j, h_i, h_j) and acc_j = P2P(acc_j, pos_j, pos_i, m_i, h_j, h_i),
+ * but evaluates the distance and the inverse square root only once.
+ */
+template<class Ta, class Tc, class Th, class Tm>
+HOST_DEVICE_FUN HOST_DEVICE_INLINE void P2PMutual(Vec4<Ta>& acc_i, Vec4<Ta>& acc_j, const Vec3<Tc>& pos_i,
+                                                  const Vec3<Tc>& pos_j, Tm m_i, Tm m_j, Th h_i, Th h_j)
+{
+    Vec3<Tc> dX = pos_j - pos_i;
+    Tc       R2 = norm2(dX);
+
+    Th h_ij  = h_i + h_j;
+    Th h_ij2 = h_ij * h_ij;
+    Tc R2eff = (R2 < h_ij2) ? h_ij2 : R2;
+
+    Tc invR   = inverseSquareRoot(R2eff);
+    Tc invR3  = invR * invR * invR;
+    Tc invR3i = m_i * invR3;
+    Tc invR3j = m_j * invR3;
+
+    acc_i[0] -= invR3j * R2;
+    acc_i[1] += dX[0] * invR3j;
+    acc_i[2] += dX[1] * invR3j;
+    acc_i[3] += dX[2] * invR3j;
+
+    acc_j[0] -= invR3i * R2;
+    acc_j[1] -= dX[0] * invR3i;
+    acc_j[2] -= dX[1] * invR3i;
+    acc_j[3] -= dX[2] * invR3i;
+}
+
 } // namespace ryoanji
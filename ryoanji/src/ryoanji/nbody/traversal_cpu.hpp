@@ -31,6 +31,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <vector>
+
 #include "cstone/traversal/traversal.hpp"
 #include "cstone/traversal/macs.hpp"
 #include "cstone/focus/source_center.hpp"
@@ -231,6 +234,257 @@ void computeGravity(const TreeNodeIndex* childOffsets, const TreeNodeIndex* inte
     *ugravTot += 0.5 * ugravLoc;
 }
 
+/*! @brief group target leaves into phases whose near-field evaluations write to disjoint particles
+ *
+ * @param[in] nearLeaves      near-field source leaves of each target leaf in [firstLeafIndex:]
+ * @param[in] firstLeafIndex  index of the first target leaf
+ * @param[in] isMutual        isMutual(a, b) is true if the pair of leaves a, b is evaluated once with P2PMutual
+ * @return                    indices of target leaves relative to @p firstLeafIndex, one list per phase
+ *
+ * Leaf a writes to its own particles and to those of its mutual partners b > a. The phases are the colors of a greedy
+ * coloring in which two leaves with overlapping write sets never get the same color, such that the leaves of one
+ * phase can be evaluated concurrently. Leaves without near-field sources are omitted.
+ */
+template<class F>
+std::vector<std::vector<TreeNodeIndex>> colorMutualLeaves(const std::vector<std::vector<TreeNodeIndex>>& nearLeaves,
+                                                          TreeNodeIndex firstLeafIndex, F&& isMutual)
+{
+    TreeNodeIndex numTargetLeaves = nearLeaves.size();
+
+    std::vector<std::vector<TreeNodeIndex>> phases;
+    //! @brief colors of the leaves that write to each target leaf
+    std::vector<std::vector<int>> writerColors(numTargetLeaves);
+    std::vector<char>             taken;
+
+    for (TreeNodeIndex ti = 0; ti < numTargetLeaves; ++ti)
+    {
+        if (nearLeaves[ti].empty()) { continue; }
+
+        TreeNodeIndex a            = firstLeafIndex + ti;
+        auto          forEachWrite = [&](auto&& f)
+        {
+            f(ti);
+            for (TreeNodeIndex b : nearLeaves[ti])
+            {
+                if (b > a && isMutual(a, b)) { f(b - firstLeafIndex); }
+            }
+        };
+
+        std::fill(taken.begin(), taken.end(), 0);
+        forEachWrite(
+            [&](TreeNodeIndex w)
+            {
+                for (int c : writerColors[w])
+                {
+                    taken[c] = 1;
+                }
+            });
+
+        int color = std::find(taken.begin(), taken.end(), 0) - taken.begin();
+        if (color == int(phases.size()))
+        {
+            phases.emplace_back();
+            taken.push_back(0);
+        }
+        phases[color].push_back(ti);
+        forEachWrite([&](TreeNodeIndex w) { writerColors[w].push_back(color); });
+    }
+
+    return phases;
+}
+
+/*! @brief computeGravity with near-field interactions between local leaf cells evaluated once per pair of leaves
+ *
+ * Target groups are the leaf cells in [firstLeafIndex:lastLeafIndex]. A first pass traverses the tree for each
+ * target leaf, applies all multipoles that pass the MAC and collects the source leaves that fail it. If leaves A and
+ * B appear in each other's near-field list, their particle pairs are evaluated once with P2PMutual by the lower of the
+ * two leaves, which directly adds the reaction to the particles of the other one. Asymmetric pairs, where B uses a
+ * multipole of an ancestor of A instead, and source leaves outside the target range are evaluated one-sided. Periodic
+ * images other than the central one are computed as in computeGravity.
+ *
+ * The near field is evaluated in phases of leaves that write to disjoint sets of particles, see colorMutualLeaves,
+ * such that no per-thread reaction buffers are needed. Needs temporary storage for one Vec4<T1> per target particle.
+ * Arguments and outputs are the same as for computeGravity.
+ */
+template<class MType, class T1, class T2, class Tm>
+void computeGravityMutual(const TreeNodeIndex* childOffsets, const TreeNodeIndex* internalToLeaf,
+                          const cstone::SourceCenterType<T1>* macSpheres, const MType* multipoles,
+                          const LocalIndex* layout, TreeNodeIndex firstLeafIndex, TreeNodeIndex lastLeafIndex,
+                          const T1* x, const T1* y, const T1* z, const T2* h, const Tm* m, const cstone::Box<T1>& box,
+                          float G, T2* ugrav, T2* ax, T2* ay, T2* az, T1* ugravTot, int numShells = 0)
+{
+    constexpr LocalIndex groupSize       = 16;
+    LocalIndex           firstTarget     = layout[firstLeafIndex];
+    LocalIndex           lastTarget      = layout[lastLeafIndex];
+    LocalIndex           numTargets      = lastTarget - firstTarget;
+    TreeNodeIndex        numTargetLeaves = lastLeafIndex - firstLeafIndex;
+
+    std::vector<Vec4<T1>>                   potAndAcc(numTargets, Vec4<T1>{0, 0, 0, 0});
+    std::vector<std::vector<TreeNodeIndex>> nearLeaves(numTargetLeaves);
+
+    // far field of the central image and near-field lists
+#pragma omp parallel for schedule(dynamic)
+    for (TreeNodeIndex ti = 0; ti < numTargetLeaves; ++ti)
+    {
+        LocalIndex first = layout[firstLeafIndex + ti];
+        LocalIndex last  = layout[firstLeafIndex + ti + 1];
+        if (first == last) { continue; }
+
+        Vec3<T1> tMin{x[first], y[first], z[first]};
+        Vec3<T1> tMax = tMin;
+        for (LocalIndex i = first + 1; i < last; ++i)
+        {
+            tMin = min(Vec3<T1>{x[i], y[i], z[i]}, tMin);
+            tMax = max(Vec3<T1>{x[i], y[i], z[i]}, tMax);
+        }
+        Vec3<T1>  targetCenter = (tMax + tMin) * T1(0.5);
+        Vec3<T1>  targetSize   = (tMax - tMin) * T1(0.5);
+        Vec4<T1>* acc          = potAndAcc.data() + first - firstTarget;
+
+        auto descendOrM2P = [&](TreeNodeIndex idx)
+        {
+            const auto& com = macSpheres[idx];
+            bool violatesMac = cstone::evaluateMac(makeVec3(com), com[3], targetCenter, targetSize);
+            if (!violatesMac)
+            {
+                for (LocalIndex i = first; i < last; ++i)
+                {
+                    acc[i - first] = M2P(acc[i - first], Vec3<T1>{x[i], y[i], z[i]}, makeVec3(com), multipoles[idx]);
+                }
+            }
+            return violatesMac;
+        };
+
+        auto& nearList = nearLeaves[ti];
+        auto  addNear  = [&nearList, internalToLeaf](TreeNodeIndex idx) { nearList.push_back(internalToLeaf[idx]); };
+
+        cstone::singleTraversal(childOffsets, descendOrM2P, addNear);
+        std::sort(nearList.begin(), nearList.end());
+    }
+
+    auto isMutual = [&nearLeaves, firstLeafIndex, lastLeafIndex](TreeNodeIndex a, TreeNodeIndex b)
+    {
+        if (b < firstLeafIndex || b >= lastLeafIndex) { return false; }
+        const auto& nearB = nearLeaves[b - firstLeafIndex];
+        return std::binary_search(nearB.begin(), nearB.end(), a);
+    };
+
+    auto phases = colorMutualLeaves(nearLeaves, firstLeafIndex, isMutual);
+
+    // near field of the central image
+#pragma omp parallel
+    for (const auto& phaseLeaves : phases)
+    {
+        Vec4<T1>* acc = potAndAcc.data() - firstTarget;
+
+#pragma omp for schedule(dynamic)
+        for (size_t k = 0; k < phaseLeaves.size(); ++k)
+        {
+            TreeNodeIndex ti    = phaseLeaves[k];
+            TreeNodeIndex a     = firstLeafIndex + ti;
+            LocalIndex    first = layout[a];
+            LocalIndex    last  = layout[a + 1];
+
+            for (TreeNodeIndex b : nearLeaves[ti])
+            {
+                LocalIndex firstSource = layout[b];
+                LocalIndex lastSource  = layout[b + 1];
+
+                // mutual pairs are evaluated by the leaf with the lower index
+                bool mutual = a != b && isMutual(a, b);
+                if (mutual && b < a) { continue; }
+
+                for (LocalIndex i = first; i < last; ++i)
+                {
+                    Vec3<T1> pos_i{x[i], y[i], z[i]};
+                    Vec4<T1> acc_i{0, 0, 0, 0};
+
+                    if (a == b)
+                    {
+                        // the self-interaction of a particle is zero
+                        for (LocalIndex j = i + 1; j < last; ++j)
+                        {
+                            P2PMutual(acc_i, acc[j], pos_i, Vec3<T1>{x[j], y[j], z[j]}, m[i], m[j], h[i], h[j]);
+                        }
+                    }
+                    else if (mutual)
+                    {
+                        for (LocalIndex j = firstSource; j < lastSource; ++j)
+                        {
+                            P2PMutual(acc_i, acc[j], pos_i, Vec3<T1>{x[j], y[j], z[j]}, m[i], m[j], h[i], h[j]);
+                        }
+                    }
+                    else
+                    {
+                        for (LocalIndex j = firstSource; j < lastSource; ++j)
+                        {
+                            acc_i = P2P(acc_i, pos_i, Vec3<T1>{x[j], y[j], z[j]}, m[j], h[i], h[j]);
+                        }
+                    }
+
+                    acc[i] += acc_i;
+                }
+            }
+        }
+    }
+
+    T1 ugravLoc = 0.0;
+
+#pragma omp parallel for reduction(+ : ugravLoc)
+    for (LocalIndex i = firstTarget; i < lastTarget; i += groupSize)
+    {
+        util::array<Vec4<T1>, groupSize> targets{};
+
+        LocalIndex groupSizeValid = std::min(groupSize, lastTarget - i);
+        for (LocalIndex k = 0; k < groupSizeValid; ++k)
+        {
+            targets[k] = {x[i + k], y[i + k], z[i + k], T1(h[i + k])};
+        }
+        // padding targets only contribute to acc entries that are discarded
+        for (LocalIndex k = groupSizeValid; k < groupSize; ++k)
+        {
+            targets[k] = targets[0];
+        }
+
+        util::array<Vec4<T1>, groupSize> shellAcc;
+        std::fill(shellAcc.begin(), shellAcc.end(), Vec4<T1>{0, 0, 0, 0});
+
+        for (int iz = -numShells; iz <= numShells; ++iz)
+        {
+            for (int iy = -numShells; iy <= numShells; ++iy)
+            {
+                for (int ix = -numShells; ix <= numShells; ++ix)
+                {
+                    if (ix == 0 && iy == 0 && iz == 0) { continue; }
+                    Vec4<T1> pbcShift{ix * box.lx(), iy * box.ly(), iz * box.lz(), 0};
+
+                    auto targetsShifted = targets;
+                    for (auto& t_ : targetsShifted)
+                    {
+                        t_ -= pbcShift;
+                    }
+
+                    computeGravityGroup(targetsShifted, childOffsets, internalToLeaf, macSpheres, multipoles, layout, x,
+                                        y, z, h, m, shellAcc.data());
+                }
+            }
+        }
+
+        for (LocalIndex k = 0; k < groupSizeValid; ++k)
+        {
+            Vec4<T1> total = potAndAcc[i + k - firstTarget] + shellAcc[k];
+            auto     u     = G * m[i + k] * total[0];
+            ugravLoc += u;
+            if (ugrav) { ugrav[i + k] += u; }
+            ax[i + k] += G * total[1];
+            ay[i + k] += G * total[2];
+            az[i + k] += G * total[3];
+        }
+    }
+
+    *ugravTot += 0.5 * ugravLoc;
+}
+
 //! @brief compute direct gravity sum for all particles [0:numParticles]
 template<class Tc, class Th, class Tm>
 void directSum(const Tc* x, const Tc* y, const Tc* z, const Th* h, const Tm* m, LocalIndex numParticles, float G,
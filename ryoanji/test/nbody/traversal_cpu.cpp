@@ -158,4 +158,66 @@ TEST(Gravity, TreeWalk)
     // 99% of particles have an error smaller than this
     std::cout << "1st percentile: " << delta[numParticles * 0.99] << std::endl;
     std::cout << "max Error: " << delta[numParticles - 1] << std::endl;
+
+    // near-field interactions between leaf pairs evaluated once
+    std::vector<T> mx(numParticles, 0);
+    std::vector<T> my(numParticles, 0);
+    std::vector<T> mz(numParticles, 0);
+    std::vector<T> mPot(numParticles, 0);
+
+    t0            = std::chrono::high_resolution_clock::now();
+    T egravMutual = 0;
+    computeGravityMutual(octree.childOffsets.data(), octree.internalToLeaf.data(), centers.data(), multipoles.data(),
+                         layout.data(), 0, octree.numLeafNodes, x, y, z, h.data(), masses.data(), box, G, mPot.data(),
+                         mx.data(), my.data(), mz.data(), &egravMutual, numShells);
+    t1      = std::chrono::high_resolution_clock::now();
+    elapsed = std::chrono::duration<double>(t1 - t0).count();
+
+    std::cout << "Time elapsed for mutual near-field: " << elapsed << " s, " << double(numParticles) / 1e6 / elapsed
+              << " million particles/second" << std::endl;
+
+    EXPECT_NEAR(std::abs(refPotSum - egravMutual) / refPotSum, 0, 1e-2);
+    EXPECT_NEAR(std::accumulate(mPot.begin(), mPot.end(), T(0)) / 2, egravMutual, 1e-10 * std::abs(egravMutual));
+
+    for (LocalIndex i = 0; i < numParticles; ++i)
+    {
+        ryoanji::Vec3<T> axi{mx[i], my[i], mz[i]}, Axi{Ax[i], Ay[i], Az[i]};
+        delta[i] = std::sqrt(norm2(axi - Axi) / norm2(Axi));
+    }
+    std::sort(begin(delta), end(delta));
+
+    EXPECT_TRUE(delta[numParticles * 0.99] < 3e-3);
+    EXPECT_TRUE(delta[numParticles - 1] < 3e-2);
+    std::cout << "mutual 1st percentile: " << delta[numParticles * 0.99] << std::endl;
+    std::cout << "mutual max Error: " << delta[numParticles - 1] << std::endl;
+}
+
+TEST(Gravity, MutualLeafPhases)
+{
+    // near-field lists of leaves 2 to 6, all pairs are mutual except those involving leaf 6 or outside targets
+    TreeNodeIndex                           firstLeaf = 2;
+    std::vector<std::vector<TreeNodeIndex>> nearLeaves{{1, 2, 3, 4}, {2, 3, 4}, {2, 3, 4, 5}, {4, 5, 6}, {5, 6}};
+    auto isMutual = [](TreeNodeIndex a, TreeNodeIndex b) { return a >= 2 && b >= 2 && a < 6 && b < 6; };
+
+    auto phases = colorMutualLeaves(nearLeaves, firstLeaf, isMutual);
+
+    std::vector<int> numVisits(nearLeaves.size(), 0);
+    for (const auto& phase : phases)
+    {
+        std::vector<int> numWriters(nearLeaves.size(), 0);
+        for (TreeNodeIndex ti : phase)
+        {
+            numVisits[ti]++;
+            TreeNodeIndex a = firstLeaf + ti;
+            numWriters[ti]++;
+            for (TreeNodeIndex b : nearLeaves[ti])
+            {
+                if (b > a && isMutual(a, b)) { numWriters[b - firstLeaf]++; }
+            }
+        }
+        EXPECT_LE(*std::max_element(numWriters.begin(), numWriters.end()), 1);
+    }
+    EXPECT_EQ(numVisits, std::vector<int>(nearLeaves.size(), 1));
+    // leaves 2, 3 and 4 all write to leaf 4
+    EXPECT_GE(phases.size(), 3);
 }
@@ -38,11 +38,11 @@
 namespace sph
 {
 
-template<typename Tc, class Dataset>
+template<int numDim = 3, typename Tc, class Dataset>
 void computeDensityImpl(const GroupView& groups, Dataset& d, const cstone::Box<Tc>& box)
 {
     swap(d.xm, d.rho);
-    computeXMass(groups, d, box);
+    computeXMass<numDim>(groups, d, box);
     swap(d.xm, d.rho);
     // Convert XMass to density
 #pragma omp parallel for schedule(static)
@@ -52,11 +52,15 @@ void computeDensityImpl(const GroupView& groups, Dataset& d, const cstone::Box<T
     }
 }
 
-template<class T, class Dataset>
+template<int numDim = 3, class T, class Dataset>
 void computeDensity(const GroupView& groups, Dataset& d, const cstone::Box<T>& box)
 {
-    if constexpr (cstone::HaveGpu<typename Dataset::AcceleratorType>{}) { cuda::computeDensity(groups, d, box); }
-    else { computeDensityImpl(groups, d, box); }
+    if constexpr (cstone::HaveGpu<typename Dataset::AcceleratorType>{})
+    {
+        static_assert(numDim == 3, "the GPU implementation is 3D only");
+        cuda::computeDensity(groups, d, box);
+    }
+    else { computeDensityImpl<numDim>(groups, d, box); }
 }
 
 } // namespace sph
@@ -38,7 +38,7 @@
 namespace sph
 {
 
-template<class T, class Dataset>
+template<int numDim = 3, class T, class Dataset>
 void computeIADImpl(size_t startIndex, size_t endIndex, Dataset& d, const cstone::Box<T>& box)
 {
     const cstone::LocalIndex* neighbors      = d.neighbors.data();
@@ -66,16 +66,25 @@ void computeIADImpl(size_t startIndex, size_t endIndex, Dataset& d, const cstone
     {
         size_t   ni       = i - startIndex;
         unsigned ncCapped = std::min(neighborsCount[i] - 1, d.ngmax);
-        IADJLoopSTD(i, d.K, box, neighbors + d.ngmax * ni, ncCapped, x, y, z, h, m, rho, wh, whd, c11, c12, c13, c22,
-                    c23, c33);
+        auto jLoop = [&](auto usePbc)
+        {
+            IADJLoopSTD<1, usePbc(), numDim>(i, d.K, box, neighbors + d.ngmax * ni, ncCapped, x, y, z, h, m, rho, wh,
+                                             whd, c11, c12, c13, c22, c23, c33);
+        };
+        if (cstone::needsPBC(box, 2 * h[i], x[i], y[i], z[i])) { jLoop(std::true_type{}); }
+        else { jLoop(std::false_type{}); }
     }
 }
 
-template<class T, class Dataset>
+template<int numDim = 3, class T, class Dataset>
 void computeIAD(const GroupView& groups, Dataset& d, const cstone::Box<T>& box)
 {
-    if constexpr (cstone::HaveGpu<typename Dataset::AcceleratorType>{}) { computeIADGpu(groups, d, box); }
-    else { computeIADImpl(groups.firstBody, groups.lastBody, d, box); }
+    if constexpr (cstone::HaveGpu<typename Dataset::AcceleratorType>{})
+    {
+        static_assert(numDim == 3, "the GPU implementation is 3D only");
+        computeIADGpu(groups, d, box);
+    }
+    else { computeIADImpl<numDim>(groups.firstBody, groups.lastBody, d, box); }
 }
 
 } // namespace sph
@@ -122,7 +122,10 @@ void computeIADGpu(const GroupView& grp, Dataset& d, const cstone::Box<typename
     checkGpuErrors(cudaDeviceSynchronize());
 }
 
-template void computeIADGpu(const GroupView&, sphexa::ParticlesData<cstone::GpuTag>& d,
-                            const cstone::Box<SphTypes::CoordinateType>&);
+#define IAD_STD(Types)                                                                                                 \
+    template void computeIADGpu(const GroupView&, sphexa::ParticlesData<cstone::GpuTag, Types>& d,                     \
+                                const cstone::Box<Types::CoordinateType>&)
+
+SPH_EXA_FOR_EACH_TYPE_CONFIG(IAD_STD);
 
 } // namespace sph
@@ -9,7 +9,12 @@
 namespace sph
 {
 
-template<size_t stride = 1, class Tc, class Tm, class T>
+/*! @brief compute the IAD matrix c = tau^-1 of particle i
+ *
+ * In 2D, all particles share the same z-coordinate. The zz-block of tau then vanishes, only the xy-block is inverted
+ * and the c-components involving z are set to zero.
+ */
+template<size_t stride = 1, bool usePbc = true, int numDim = 3, class Tc, class Tm, class T>
 HOST_DEVICE_FUN inline void IADJLoopSTD(cstone::LocalIndex i, Tc K, const cstone::Box<Tc>& box,
                                         const cstone::LocalIndex* neighbors, unsigned neighborsCount, const Tc* x,
                                         const Tc* y, const Tc* z, const T* h, const Tm* m, const T* rho, const T* wh,
@@ -32,7 +37,7 @@ HOST_DEVICE_FUN inline void IADJLoopSTD(cstone::LocalIndex i, Tc K, const cstone
         T ry = (yi - y[j]);
         T rz = (zi - z[j]);
 
-        applyPBC(box, T(2) * hi, rx, ry, rz);
+        if constexpr (usePbc) { applyPBC(box, T(2) * hi, rx, ry, rz); }
 
         T dist = std::sqrt(rx * rx + ry * ry + rz * rz);
 
@@ -49,8 +54,29 @@ HOST_DEVICE_FUN inline void IADJLoopSTD(cstone::LocalIndex i, Tc K, const cstone
         tau33 += rz * rz * mj_roj_w;
     }
 
-    auto getExp    = [](T val) { return (val == T(0) ? 0 : std::ilogb(val)); };
-    int  tauExpSum = getExp(tau11) + getExp(tau12) + getExp(tau13) + getExp(tau22) + getExp(tau23) + getExp(tau33);
+    auto getExp = [](T val) { return (val == T(0) ? 0 : std::ilogb(val)); };
+
+    if constexpr (numDim == 2)
+    {
+        T normalization = std::ldexp(T(1), -(getExp(tau11) + getExp(tau12) + getExp(tau22)) / 3);
+
+        tau11 *= normalization;
+        tau12 *= normalization;
+        tau22 *= normalization;
+
+        T det    = tau11 * tau22 - tau12 * tau12;
+        T factor = normalization * (hi * hi) / (det * K);
+
+        c11[i] = tau22 * factor;
+        c12[i] = -tau12 * factor;
+        c13[i] = T(0);
+        c22[i] = tau11 * factor;
+        c23[i] = T(0);
+        c33[i] = T(0);
+        return;
+    }
+
+    int tauExpSum = getExp(tau11) + getExp(tau12) + getExp(tau13) + getExp(tau22) + getExp(tau23) + getExp(tau33);
     // normalize with 2^-averageTauExponent, ldexp(a, b) == a * 2^b
     T normalization = std::ldexp(T(1), -tauExpSum / 6);
 
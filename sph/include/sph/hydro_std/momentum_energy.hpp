@@ -38,7 +38,7 @@
 namespace sph
 {
 
-template<class Tc, class Dataset>
+template<int numDim = 3, class Tc, class Dataset>
 void computeMomentumEnergyStdImpl(size_t startIndex, size_t endIndex, Dataset& d, const cstone::Box<Tc>& box)
 {
     using T = typename Dataset::HydroType;
@@ -83,8 +83,14 @@ void computeMomentumEnergyStdImpl(size_t startIndex, size_t endIndex, Dataset& d
         T maxvsignal = 0;
 
         unsigned ncCapped = std::min(neighborsCount[i] - 1, d.ngmax);
-        momentumAndEnergyJLoop(i, d.K, box, neighbors + d.ngmax * ni, ncCapped, x, y, z, vx, vy, vz, h, m, rho, p, c,
-                               c11, c12, c13, c22, c23, c33, wh, whd, grad_P_x, grad_P_y, grad_P_z, du, &maxvsignal);
+        auto jLoop = [&](auto usePbc)
+        {
+            momentumAndEnergyJLoop<1, usePbc(), numDim>(i, d.K, box, neighbors + d.ngmax * ni, ncCapped, x, y, z, vx,
+                                                        vy, vz, h, m, rho, p, c, c11, c12, c13, c22, c23, c33, wh, whd,
+                                                        grad_P_x, grad_P_y, grad_P_z, du, &maxvsignal);
+        };
+        if (cstone::needsPBC(box, 2 * h[i], x[i], y[i], z[i])) { jLoop(std::true_type{}); }
+        else { jLoop(std::false_type{}); }
 
         T dt_i = tsKCourant(maxvsignal, h[i], c[i], d.Kcour);
         minDt  = std::min(minDt, dt_i);
@@ -93,11 +99,15 @@ void computeMomentumEnergyStdImpl(size_t startIndex, size_t endIndex, Dataset& d
     d.minDtCourant = minDt;
 }
 
-template<class T, class Dataset>
+template<int numDim = 3, class T, class Dataset>
 void computeMomentumEnergySTD(const GroupView& groups, Dataset& d, const cstone::Box<T>& box)
 {
-    if constexpr (cstone::HaveGpu<typename Dataset::AcceleratorType>{}) { computeMomentumEnergyStdGpu(groups, d, box); }
-    else { computeMomentumEnergyStdImpl(groups.firstBody, groups.lastBody, d, box); }
+    if constexpr (cstone::HaveGpu<typename Dataset::AcceleratorType>{})
+    {
+        static_assert(numDim == 3, "the GPU implementation is 3D only");
+        computeMomentumEnergyStdGpu(groups, d, box);
+    }
+    else { computeMomentumEnergyStdImpl<numDim>(groups.firstBody, groups.lastBody, d, box); }
 }
 
 } // namespace sph
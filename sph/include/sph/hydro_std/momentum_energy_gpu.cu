@@ -125,6 +125,9 @@ void computeMomentumEnergyStdGpu(const GroupView& grp, Dataset& d, const cstone:
     d.minDtCourant = minDt;
 }
 
-template void computeMomentumEnergyStdGpu(const GroupView& grp, sphexa::ParticlesData<cstone::GpuTag>& d,
-                                          const cstone::Box<SphTypes::CoordinateType>&);
+#define MOM_ENERGY_STD(Types)                                                                                          \
+    template void computeMomentumEnergyStdGpu(const GroupView& grp, sphexa::ParticlesData<cstone::GpuTag, Types>& d,   \
+                                              const cstone::Box<Types::CoordinateType>&)
+
+SPH_EXA_FOR_EACH_TYPE_CONFIG(MOM_ENERGY_STD);
 } // namespace sph
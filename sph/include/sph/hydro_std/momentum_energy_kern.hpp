@@ -9,7 +9,7 @@
 namespace sph
 {
 
-template<size_t stride = 1, class Tc, class Tm, class T, class Tm1>
+template<size_t stride = 1, bool usePbc = true, int numDim = 3, class Tc, class Tm, class T, class Tm1>
 HOST_DEVICE_FUN inline void
 momentumAndEnergyJLoop(cstone::LocalIndex i, Tc K, const cstone::Box<Tc>& box, const cstone::LocalIndex* neighbors,
                        unsigned neighborsCount, const Tc* x, const Tc* y, const Tc* z, const T* vx, const T* vy,
@@ -35,7 +35,7 @@ momentumAndEnergyJLoop(cstone::LocalIndex i, Tc K, const cstone::Box<Tc>& box, c
     auto mi_roi = m[i] / rho[i];
 
     T hiInv  = T(1) / hi;
-    T hiInv3 = hiInv * hiInv * hiInv;
+    T hiInvD = hInvPow<numDim>(hiInv);
 
     T maxvsignali = 0.0;
     T momentum_x = 0.0, momentum_y = 0.0, momentum_z = 0.0, energy = 0.0;
@@ -55,7 +55,7 @@ momentumAndEnergyJLoop(cstone::LocalIndex i, Tc K, const cstone::Box<Tc>& box, c
         T ry = yi - y[j];
         T rz = zi - z[j];
 
-        applyPBC(box, T(2) * hi, rx, ry, rz);
+        if constexpr (usePbc) { applyPBC(box, T(2) * hi, rx, ry, rz); }
 
         T r2   = rx * rx + ry * ry + rz * rz;
         T dist = std::sqrt(r2);
@@ -72,9 +72,9 @@ momentumAndEnergyJLoop(cstone::LocalIndex i, Tc K, const cstone::Box<Tc>& box, c
 
         T rv = rx * vx_ij + ry * vy_ij + rz * vz_ij;
 
-        T hjInv3 = hjInv * hjInv * hjInv;
-        T Wi     = hiInv3 * lt::lookup(wh, v1);
-        T Wj     = hjInv3 * lt::lookup(wh, v2);
+        T hjInvD = hInvPow<numDim>(hjInv);
+        T Wi     = hiInvD * lt::lookup(wh, v1);
+        T Wj     = hjInvD * lt::lookup(wh, v2);
 
         T termA1_i = c11i * rx + c12i * ry + c13i * rz;
         T termA2_i = c12i * rx + c22i * ry + c23i * rz;
@@ -0,0 +1,98 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 CSCS, ETH Zurich
+ *               2024 University of Basel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*! @file
+ * @brief Gaussian random velocity fields with the spectrum of the stirring modes
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "sph/hydro_turb/phases.hpp"
+#include "sph/hydro_turb/stirring.hpp"
+#include "sph/hydro_turb/turbulence_data.hpp"
+
+namespace sph
+{
+
+/*! @brief random engine for the phases of the initial velocity field
+ *
+ * The driver seeds its engine with @p rngSeed alone. Mixing in a stream tag with std::seed_seq gives an engine state
+ * that is unrelated to the driver, whereas neighboring integer seeds such as rngSeed + 1 are not guaranteed to yield
+ * independent streams.
+ */
+inline std::mt19937 initialVelocityEngine(uint32_t rngSeed)
+{
+    constexpr uint32_t initialVelocityStream = 1;
+    std::seed_seq      seq{rngSeed, initialVelocityStream};
+    return std::mt19937(seq);
+}
+
+/*! @brief draw a Gaussian random velocity field from the stirring modes and evaluate it at the particle positions
+ *
+ * @param[in]    startIndex  first particle index to set
+ * @param[in]    endIndex    last particle index to set
+ * @param[in]    x           x components of particle positions
+ * @param[in]    y           y components of particle positions
+ * @param[in]    z           z components of particle positions
+ * @param[out]   vx          x components of particle velocities
+ * @param[out]   vy          y components of particle velocities
+ * @param[out]   vz          z components of particle velocities
+ * @param[in]    turb        modes, amplitudes and solenoidal weight
+ * @param[inout] gen         random engine for the phases, must not share its state with the engine of the driver
+ *
+ * The phases are drawn from a normal distribution with unit variance and projected with turb.solWeight, such that a
+ * weight of 1 gives a divergence-free and a weight of 0 a curl-free field. The mode amplitudes determine the shape of
+ * the spectrum, the normalization is left to the caller. Ranks with identically seeded @p gen obtain the same global
+ * field, which is evaluated as a direct sum over the modes for each particle.
+ */
+template<class Tc, class Tv, class T, class Accelerator>
+void turbulentVelocityField(size_t startIndex, size_t endIndex, const Tc* x, const Tc* y, const Tc* z, Tv* vx, Tv* vy,
+                            Tv* vz, const TurbulenceData<T, Accelerator>& turb, std::mt19937& gen)
+{
+    std::vector<T>              phases(2 * turb.numDim * turb.numModes);
+    std::normal_distribution<T> dist(0, 1);
+    std::generate(phases.begin(), phases.end(), [&gen, &dist]() { return dist(gen); });
+
+    std::vector<T> phasesReal(turb.numDim * turb.numModes);
+    std::vector<T> phasesImag(turb.numDim * turb.numModes);
+    computePhases(turb.numModes, turb.numDim, phases, turb.solWeight, turb.modes, phasesReal, phasesImag);
+
+#pragma omp parallel for schedule(static)
+    for (size_t i = startIndex; i < endIndex; ++i)
+    {
+        auto [vxi, vyi, vzi] = stirParticle<Tc, Tv, T>(turb.numDim, x[i], y[i], z[i], turb.numModes, turb.modes.data(),
+                                                       phasesReal.data(), phasesImag.data(), turb.amplitudes.data());
+        vx[i] = vxi;
+        vy[i] = vyi;
+        vz[i] = vzi;
+    }
+}
+
+} // namespace sph
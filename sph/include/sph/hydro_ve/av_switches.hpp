@@ -72,9 +72,14 @@ void computeAVswitchesImpl(size_t startIndex, size_t endIndex, Dataset& d, const
     {
         size_t   ni       = i - startIndex;
         unsigned ncCapped = std::min(neighborsCount[i] - 1, d.ngmax);
-        alpha[i] = AVswitchesJLoop(i, d.K, box, neighbors + d.ngmax * ni, ncCapped, x, y, z, vx, vy, vz, h, c, c11, c12,
-                                   c13, c22, c23, c33, wh, whd, kx, xm, divv, d.minDt, d.alphamin, d.alphamax,
-                                   d.decay_constant, alpha[i]);
+        auto jLoop = [&](auto usePbc)
+        {
+            return AVswitchesJLoop<1, usePbc()>(i, d.K, box, neighbors + d.ngmax * ni, ncCapped, x, y, z, vx, vy, vz, h,
+                                                c, c11, c12, c13, c22, c23, c33, wh, whd, kx, xm, divv, d.minDt,
+                                                d.alphamin, d.alphamax, d.decay_constant, alpha[i]);
+        };
+        if (cstone::needsPBC(box, 2 * h[i], x[i], y[i], z[i])) { alpha[i] = jLoop(std::true_type{}); }
+        else { alpha[i] = jLoop(std::false_type{}); }
     }
 }
 
@@ -98,7 +98,10 @@ void computeAVswitches(const GroupView& grp, Dataset& d, const cstone::Box<typen
     checkGpuErrors(cudaDeviceSynchronize());
 }
 
-template void computeAVswitches(const GroupView& grp, sphexa::ParticlesData<cstone::GpuTag>& d,
-                                const cstone::Box<SphTypes::CoordinateType>&);
+#define AV_SWITCHES(Types)                                                                                             \
+    template void computeAVswitches(const GroupView& grp, sphexa::ParticlesData<cstone::GpuTag, Types>& d,             \
+                                    const cstone::Box<Types::CoordinateType>&)
+
+SPH_EXA_FOR_EACH_TYPE_CONFIG(AV_SWITCHES);
 
 } // namespace sph::cuda
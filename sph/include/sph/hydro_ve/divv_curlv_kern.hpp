@@ -40,7 +40,7 @@
 namespace sph
 {
 
-template<size_t stride = 1, typename Tc, class T>
+template<size_t stride = 1, bool usePbc = true, typename Tc, class T>
 HOST_DEVICE_FUN inline void
 divV_curlVJLoop(cstone::LocalIndex i, Tc K, const cstone::Box<Tc>& box, const cstone::LocalIndex* neighbors,
                 unsigned neighborsCount, const Tc* x, const Tc* y, const Tc* z, const T* vx, const T* vy, const T* vz,
@@ -78,7 +78,7 @@ divV_curlVJLoop(cstone::LocalIndex i, Tc K, const cstone::Box<Tc>& box, const cs
         T ry = yi - y[j];
         T rz = zi - z[j];
 
-        applyPBC(box, T(2) * hi, rx, ry, rz);
+        if constexpr (usePbc) { applyPBC(box, T(2) * hi, rx, ry, rz); }
 
         T r2   = rx * rx + ry * ry + rz * rz;
         T dist = std::sqrt(r2);
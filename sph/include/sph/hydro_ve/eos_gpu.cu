@@ -112,7 +112,10 @@ void computeIsothermalEOS(size_t first, size_t last, Dataset& d)
     checkGpuErrors(cudaDeviceSynchronize());
 }
 
-template void computeIsothermalEOS(size_t, size_t, sphexa::ParticlesData<cstone::GpuTag>& d);
+#define ISOTHERMAL_EOS(Types)                                                                                          \
+    template void computeIsothermalEOS(size_t, size_t, sphexa::ParticlesData<cstone::GpuTag, Types>& d)
+
+SPH_EXA_FOR_EACH_TYPE_CONFIG(ISOTHERMAL_EOS);
 
 } // namespace cuda
 } // namespace sph
@@ -82,11 +82,17 @@ void computeIadDivvCurlvImpl(size_t startIndex, size_t endIndex, Dataset& d, con
         size_t   ni       = i - startIndex;
         unsigned ncCapped = std::min(neighborsCount[i] - 1, d.ngmax);
 
-        IADJLoop(i, d.K, box, neighbors + d.ngmax * ni, ncCapped, x, y, z, h, wh, whd, xm, kx, c11, c12, c13, c22, c23,
-                 c33);
-
-        divV_curlVJLoop(i, d.K, box, neighbors + d.ngmax * ni, ncCapped, x, y, z, vx, vy, vz, h, c11, c12, c13, c22,
-                        c23, c33, wh, whd, kx, xm, divv, curlv, dV11, dV12, dV13, dV22, dV23, dV33, doGradV);
+        auto jLoops = [&](auto usePbc)
+        {
+            IADJLoop<1, usePbc()>(i, d.K, box, neighbors + d.ngmax * ni, ncCapped, x, y, z, h, wh, whd, xm, kx, c11,
+                                  c12, c13, c22, c23, c33);
+
+            divV_curlVJLoop<1, usePbc()>(i, d.K, box, neighbors + d.ngmax * ni, ncCapped, x, y, z, vx, vy, vz, h, c11,
+                                         c12, c13, c22, c23, c33, wh, whd, kx, xm, divv, curlv, dV11, dV12, dV13, dV22,
+                                         dV23, dV33, doGradV);
+        };
+        if (cstone::needsPBC(box, 2 * h[i], x[i], y[i], z[i])) { jLoops(std::true_type{}); }
+        else { jLoops(std::false_type{}); }
     }
 }
 
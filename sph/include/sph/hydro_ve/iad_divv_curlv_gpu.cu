@@ -106,8 +106,11 @@ void computeIadDivvCurlv(const GroupView& grp, Dataset& d, const cstone::Box<typ
     checkGpuErrors(cudaDeviceSynchronize());
 }
 
-template void computeIadDivvCurlv(const GroupView& grp, sphexa::ParticlesData<cstone::GpuTag>& d,
-                                  const cstone::Box<SphTypes::CoordinateType>&);
+#define IAD_DIVV_CURLV(Types)                                                                                          \
+    template void computeIadDivvCurlv(const GroupView& grp, sphexa::ParticlesData<cstone::GpuTag, Types>& d,           \
+                                      const cstone::Box<Types::CoordinateType>&)
+
+SPH_EXA_FOR_EACH_TYPE_CONFIG(IAD_DIVV_CURLV);
 
 } // namespace cuda
 } // namespace sph
@@ -40,7 +40,7 @@
 namespace sph
 {
 
-template<size_t stride = 1, class Tc, class T>
+template<size_t stride = 1, bool usePbc = true, class Tc, class T>
 HOST_DEVICE_FUN inline void IADJLoop(cstone::LocalIndex i, Tc K, const cstone::Box<Tc>& box,
                                      const cstone::LocalIndex* neighbors, unsigned neighborsCount, const Tc* x,
                                      const Tc* y, const Tc* z, const T* h, const T* wh, const T* /*whd*/, const T* xm,
@@ -63,7 +63,7 @@ HOST_DEVICE_FUN inline void IADJLoop(cstone::LocalIndex i, Tc K, const cstone::B
         T ry = (yi - y[j]);
         T rz = (zi - z[j]);
 
-        applyPBC(box, T(2) * hi, rx, ry, rz);
+        if constexpr (usePbc) { applyPBC(box, T(2) * hi, rx, ry, rz); }
 
         T dist = std::sqrt(rx * rx + ry * ry + rz * rz);
 
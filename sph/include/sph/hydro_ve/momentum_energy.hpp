@@ -92,10 +92,15 @@ void computeMomentumEnergyImpl(size_t startIndex, size_t endIndex, Dataset& d, c
 
         T maxvsignal = 0;
 
-        momentumAndEnergyJLoop<avClean>(i, d.K, box, neighbors + d.ngmax * ni, ncCapped, x, y, z, vx, vy, vz, h, m,
-                                        prho, tdpdTrho, c, c11, c12, c13, c22, c23, c33, d.Atmin, d.Atmax, d.ramp, wh,
-                                        kx, xm, alpha, dV11, dV12, dV13, dV22, dV23, dV33, grad_P_x, grad_P_y, grad_P_z,
-                                        du, &maxvsignal);
+        auto jLoop = [&](auto usePbc)
+        {
+            momentumAndEnergyJLoop<avClean, 1, usePbc()>(
+                i, d.K, box, neighbors + d.ngmax * ni, ncCapped, x, y, z, vx, vy, vz, h, m, prho, tdpdTrho, c, c11, c12,
+                c13, c22, c23, c33, d.Atmin, d.Atmax, d.ramp, wh, kx, xm, alpha, dV11, dV12, dV13, dV22, dV23, dV33,
+                grad_P_x, grad_P_y, grad_P_z, du, &maxvsignal);
+        };
+        if (cstone::needsPBC(box, 2 * h[i], x[i], y[i], z[i])) { jLoop(std::true_type{}); }
+        else { jLoop(std::false_type{}); }
 
         T dt_i = tsKCourant(maxvsignal, h[i], c[i], d.Kcour);
         minDt  = std::min(minDt, dt_i);
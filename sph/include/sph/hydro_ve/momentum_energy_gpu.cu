@@ -143,12 +143,16 @@ void computeMomentumEnergy(const GroupView& grp, float* groupDt, Dataset& d,
     d.minDtCourant = minDt;
 }
 
-#define MOM_ENERGY(avc)                                                                                                \
-    template void computeMomentumEnergy<avc>(const GroupView& grp, float*, sphexa::ParticlesData<cstone::GpuTag>& d,   \
-                                             const cstone::Box<SphTypes::CoordinateType>&)
+#define MOM_ENERGY(avc, Types)                                                                                         \
+    template void computeMomentumEnergy<avc>(const GroupView& grp, float*,                                             \
+                                             sphexa::ParticlesData<cstone::GpuTag, Types>& d,                          \
+                                             const cstone::Box<Types::CoordinateType>&)
 
-MOM_ENERGY(true);
-MOM_ENERGY(false);
+#define MOM_ENERGY_AVC(Types)                                                                                          \
+    MOM_ENERGY(true, Types);                                                                                           \
+    MOM_ENERGY(false, Types)
+
+SPH_EXA_FOR_EACH_TYPE_CONFIG(MOM_ENERGY_AVC);
 
 } // namespace cuda
 } // namespace sph
@@ -62,7 +62,7 @@ HOST_DEVICE_FUN T avRvCorrection(util::array<Tc, 3> R, Tc eta_ab, T eta_crit, co
     return rv_AV;
 }
 
-template<bool avClean, size_t stride = 1, class Tc, class Tm, class T, class Tm1>
+template<bool avClean, size_t stride = 1, bool usePbc = true, class Tc, class Tm, class T, class Tm1>
 HOST_DEVICE_FUN inline void
 momentumAndEnergyJLoop(cstone::LocalIndex i, Tc K, const cstone::Box<Tc>& box, const cstone::LocalIndex* neighbors,
                        unsigned neighborsCount, const Tc* x, const Tc* y, const Tc* z, const T* vx, const T* vy,
@@ -121,7 +121,7 @@ momentumAndEnergyJLoop(cstone::LocalIndex i, Tc K, const cstone::Box<Tc>& box, c
         auto vyj = vy[j];
         auto vzj = vz[j];
 
-        applyPBC(box, T(2) * hi, rx, ry, rz);
+        if constexpr (usePbc) { applyPBC(box, T(2) * hi, rx, ry, rz); }
 
         T r2   = rx * rx + ry * ry + rz * rz;
         T dist = std::sqrt(r2);
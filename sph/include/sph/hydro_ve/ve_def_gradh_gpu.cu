@@ -96,8 +96,11 @@ void computeVeDefGradh(const GroupView& grp, Dataset& d, const cstone::Box<typen
     checkGpuErrors(cudaDeviceSynchronize());
 }
 
-template void computeVeDefGradh(const GroupView&, sphexa::ParticlesData<cstone::GpuTag>& d,
-                                const cstone::Box<SphTypes::CoordinateType>&);
+#define VE_DEF_GRADH(Types)                                                                                            \
+    template void computeVeDefGradh(const GroupView&, sphexa::ParticlesData<cstone::GpuTag, Types>& d,                 \
+                                    const cstone::Box<Types::CoordinateType>&)
+
+SPH_EXA_FOR_EACH_TYPE_CONFIG(VE_DEF_GRADH);
 
 } // namespace cuda
 } // namespace sph
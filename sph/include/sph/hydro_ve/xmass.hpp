@@ -36,7 +36,7 @@
 
 namespace sph
 {
-template<typename Tc, class Dataset>
+template<int numDim = 3, typename Tc, class Dataset>
 void computeXMassImpl(size_t startIndex, size_t endIndex, Dataset& d, const cstone::Box<Tc>& box)
 {
     const cstone::LocalIndex* neighbors      = d.neighbors.data();
@@ -58,7 +58,7 @@ void computeXMassImpl(size_t startIndex, size_t endIndex, Dataset& d, const csto
     {
         size_t   ni       = i - startIndex;
         unsigned ncCapped = std::min(neighborsCount[i] - 1, d.ngmax);
-        xm[i]             = xmassJLoop(i, d.K, box, neighbors + d.ngmax * ni, ncCapped, x, y, z, h, m, wh, whd);
+        xm[i] = xmassJLoop<1, numDim>(i, d.K, box, neighbors + d.ngmax * ni, ncCapped, x, y, z, h, m, wh, whd);
 #ifndef NDEBUG
         if (std::isnan(xm[i]))
             printf("ERROR::Rho0(%zu) rho0 %f, position: (%f %f %f), h: %f\n", i, xm[i], x[i], y[i], z[i], h[i]);
@@ -66,11 +66,15 @@ void computeXMassImpl(size_t startIndex, size_t endIndex, Dataset& d, const csto
     }
 }
 
-template<typename Tc, class Dataset>
+template<int numDim = 3, typename Tc, class Dataset>
 void computeXMass(const GroupView& grp, Dataset& d, const cstone::Box<Tc>& box)
 {
-    if constexpr (cstone::HaveGpu<typename Dataset::AcceleratorType>{}) { cuda::computeXMass(grp, d, box); }
-    else { computeXMassImpl(grp.firstBody, grp.lastBody, d, box); }
+    if constexpr (cstone::HaveGpu<typename Dataset::AcceleratorType>{})
+    {
+        static_assert(numDim == 3, "the GPU implementation is 3D only");
+        cuda::computeXMass(grp, d, box);
+    }
+    else { computeXMassImpl<numDim>(grp.firstBody, grp.lastBody, d, box); }
 }
 
 } // namespace sph
@@ -128,8 +128,11 @@ void computeXMass(const GroupView& grp, Dataset& d, const cstone::Box<typename D
     if (convergenceFailure) { throw std::runtime_error("coupled nc/h-updated failed to converge"); }
 }
 
-template void computeXMass(const GroupView& grp, sphexa::ParticlesData<cstone::GpuTag>& d,
-                           const cstone::Box<SphTypes::CoordinateType>&);
+#define COMPUTE_XMASS(Types)                                                                                           \
+    template void computeXMass(const GroupView& grp, sphexa::ParticlesData<cstone::GpuTag, Types>& d,                  \
+                               const cstone::Box<Types::CoordinateType>&)
+
+SPH_EXA_FOR_EACH_TYPE_CONFIG(COMPUTE_XMASS);
 
 template<class Tm, class Trho>
 __global__ void convertXmassToRho(const LocalIndex* grpStart, const LocalIndex* grpEnd, LocalIndex numGroups,
@@ -164,8 +167,11 @@ void computeDensity(const GroupView& grp, Dataset& d, const cstone::Box<typename
                                                  rawPtr(d.devData.rho));
 }
 
-template void computeDensity(const GroupView&, sphexa::ParticlesData<cstone::GpuTag>& d,
-                             const cstone::Box<SphTypes::CoordinateType>&);
+#define COMPUTE_DENSITY(Types)                                                                                         \
+    template void computeDensity(const GroupView&, sphexa::ParticlesData<cstone::GpuTag, Types>& d,                    \
+                                 const cstone::Box<Types::CoordinateType>&)
+
+SPH_EXA_FOR_EACH_TYPE_CONFIG(COMPUTE_DENSITY);
 
 } // namespace cuda
 } // namespace sph
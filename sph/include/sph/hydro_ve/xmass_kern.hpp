@@ -47,7 +47,7 @@ HOST_DEVICE_FUN inline T veDefinition(Tm mass, T rhoZero)
     return mass / rhoZero;
 }
 
-template<size_t stride = 1, class Tc, class Tm, class T>
+template<size_t stride = 1, int numDim = 3, class Tc, class Tm, class T>
 HOST_DEVICE_FUN inline T xmassJLoop(cstone::LocalIndex i, Tc K, const cstone::Box<Tc>& box,
                                     const cstone::LocalIndex* neighbors, unsigned neighborsCount, const Tc* x,
                                     const Tc* y, const Tc* z, const T* h, const Tm* m, const T* wh, const T* /*whd*/)
@@ -59,7 +59,7 @@ HOST_DEVICE_FUN inline T xmassJLoop(cstone::LocalIndex i, Tc K, const cstone::Bo
     auto mi = m[i];
 
     T hInv  = 1.0 / hi;
-    T h3Inv = hInv * hInv * hInv;
+    T hdInv = hInvPow<numDim>(hInv);
 
     // initialize with self-contribution
     T rho0i = mi;
@@ -74,7 +74,7 @@ HOST_DEVICE_FUN inline T xmassJLoop(cstone::LocalIndex i, Tc K, const cstone::Bo
         rho0i += w * m[j];
     }
 
-    T xmassi = veDefinition(mi, rho0i * K * h3Inv);
+    T xmassi = veDefinition(mi, rho0i * K * hdInv);
     return xmassi;
 }
 
@@ -17,18 +17,34 @@ HOST_DEVICE_FUN inline auto tsKCourant(T1 maxvsignal, T2 h, T3 c, float Kcour)
 
 /*! @brief estimate updated smoothing length to bring the neighbor count closer to ng0
  *
- * @tparam T    float or double
- * @param ng0   target neighbor count
- * @param nc    current neighbor count
- * @param h     current smoothing length
- * @return      updated smoothing length
+ * @tparam numDim  number of spatial dimensions, the neighbor count scales with h^numDim
+ * @tparam T       float or double
+ * @param ng0      target neighbor count
+ * @param nc       current neighbor count
+ * @param h        current smoothing length
+ * @return         updated smoothing length
  */
-template<class T>
+template<int numDim = 3, class T>
 HOST_DEVICE_FUN T updateH(unsigned ng0, unsigned nc, T h)
 {
     constexpr T c0  = 1023.0;
     constexpr T exp = 1.0 / 10.0;
-    return h * T(0.5) * std::pow(T(1) + c0 * ng0 / T(nc), exp);
+    T hRatio3D      = T(0.5) * std::pow(T(1) + c0 * ng0 / T(nc), exp);
+    if constexpr (numDim == 3) { return h * hRatio3D; }
+    else
+    {
+        // hRatio3D^3 is the damped estimate of ng0 / nc
+        return h * std::pow(hRatio3D * hRatio3D * hRatio3D, T(1.0 / numDim));
+    }
+}
+
+//! @brief return hInv^numDim, the normalization of an SPH kernel with smoothing length 1/hInv in numDim dimensions
+template<int numDim, class T>
+HOST_DEVICE_FUN HOST_DEVICE_INLINE T hInvPow(T hInv)
+{
+    static_assert(numDim == 2 || numDim == 3, "only 2D and 3D SPH kernels are supported");
+    if constexpr (numDim == 2) { return hInv * hInv; }
+    else { return hInv * hInv * hInv; }
 }
 
 //! @brief sinc(PI/2 * v)
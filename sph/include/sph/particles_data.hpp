@@ -58,17 +58,22 @@ namespace sphexa
 
 namespace lt = ::sph::lt;
 
-template<class AccType>
-class ParticlesData : public cstone::FieldStates<ParticlesData<AccType>>
+/*! @brief hydro and gravity particle data
+ *
+ * @tparam AccType  CpuTag or GpuTag
+ * @tparam Types    key and floating point types of the fields, see sph::SphTypeConfig
+ */
+template<class AccType, class Types = sph::SphTypes>
+class ParticlesData : public cstone::FieldStates<ParticlesData<AccType, Types>>
 {
 public:
     using AcceleratorType = AccType;
 
-    using KeyType   = sph::SphTypes::KeyType;
-    using RealType  = sph::SphTypes::CoordinateType;
-    using HydroType = sph::SphTypes::HydroType;
-    using XM1Type   = sph::SphTypes::XM1Type;
-    using Tmass     = sph::SphTypes::Tmass;
+    using KeyType   = typename Types::KeyType;
+    using RealType  = typename Types::CoordinateType;
+    using HydroType = typename Types::HydroType;
+    using XM1Type   = typename Types::XM1Type;
+    using Tmass     = typename Types::Tmass;
 
     template<class ValueType>
     using PinnedVec = std::vector<ValueType, PinnedAlloc_t<AcceleratorType, ValueType>>;
@@ -108,6 +113,10 @@ public:
     RealType g{0.0};
     //! @brief gravitational smoothing
     RealType eps{0.005};
+    //! @brief exchange multipoles between ranks in single precision and without empty nodes (CPU only)
+    bool compactMultipoles{false};
+    //! @brief evaluate near-field gravity between pairs of local leaf cells once for both sides (CPU only)
+    bool mutualP2P{false};
     //! @brief acceleration based time-step control
     RealType etaAcc{0.2};
 
@@ -135,6 +144,8 @@ public:
     RealType sincIndex{6.0};
     //! @brief choice of smoothing kernel type
     sph::SphKernelType kernelChoice{sph::SphKernelType::sinc_n};
+    //! @brief number of spatial dimensions of the SPH kernels, 2 for planar simulations with constant z
+    int numDim{3};
 
     //! @brief Unified interface to attribute initialization, reading and writing
     template<class Archive>
@@ -187,6 +198,7 @@ public:
 
         optionalIO("sincIndex", &sincIndex, 1);
         optionalIO("kernelChoice", &kernelChoice, 1);
+        optionalIO("numDim", &numDim, 1);
 
         createTables();
     }
@@ -236,7 +248,7 @@ public:
     std::vector<cstone::LocalIndex>         neighbors;
     cstone::OctreeNsView<RealType, KeyType> treeView;
 
-    DeviceData_t<AccType> devData;
+    DeviceData_t<AccType, Types> devData;
 
     //! @brief lookup tables for the SPH-kernel and its derivative
     std::array<HydroType, lt::kTableSize> wh{0}, whd{0};
@@ -253,7 +265,7 @@ public:
     //! @brief dataset prefix to be prepended to fieldNames for structured output
     static const inline std::string prefix{};
 
-    static_assert(!cstone::HaveGpu<AcceleratorType>{} || fieldNames.size() == DeviceData_t<AccType>::fieldNames.size(),
+    static_assert(!cstone::HaveGpu<AcceleratorType>{} || fieldNames.size() == DeviceData_t<AccType, Types>::fieldNames.size(),
                   "ParticlesData on CPU and GPU must have the same fields");
 
     /*! @brief return a tuple of field references
@@ -365,7 +377,8 @@ private:
     void createTables()
     {
         using H = HydroType;
-        K       = sph::kernel_3D_k(getSphKernel(kernelChoice, sincIndex), 2.0);
+        K       = (numDim == 2) ? sph::kernel_2D_k(getSphKernel(kernelChoice, sincIndex), 2.0)
+                                : sph::kernel_3D_k(getSphKernel(kernelChoice, sincIndex), 2.0);
         wh      = sph::tabulateFunction<H, lt::kTableSize>(sph::getSphKernel(kernelChoice, sincIndex), 0, 2);
         whd     = sph::tabulateFunction<H, lt::kTableSize>(sph::getSphKernelDerivative(kernelChoice, sincIndex), 0, 2);
         devData.uploadTables(wh, whd);
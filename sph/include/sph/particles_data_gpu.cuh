@@ -46,16 +46,17 @@
 namespace sphexa
 {
 
-class DeviceParticlesData : public cstone::FieldStates<DeviceParticlesData>
+template<class Types>
+class DeviceParticlesData : public cstone::FieldStates<DeviceParticlesData<Types>>
 {
     template<class FType>
     using DevVector = cstone::DeviceVector<FType>;
 
-    using KeyType   = sph::SphTypes::KeyType;
-    using RealType  = sph::SphTypes::CoordinateType;
-    using HydroType = sph::SphTypes::HydroType;
-    using XM1Type   = sph::SphTypes::XM1Type;
-    using Tmass     = sph::SphTypes::Tmass;
+    using KeyType   = typename Types::KeyType;
+    using RealType  = typename Types::CoordinateType;
+    using HydroType = typename Types::HydroType;
+    using XM1Type   = typename Types::XM1Type;
+    using Tmass     = typename Types::Tmass;
 
 public:
     // number of CUDA streams to use
@@ -77,10 +77,12 @@ struct DeviceDataFacade
     inline static constexpr std::array fieldNames{0};
 };
 
+template<class Types>
 class DeviceParticlesData;
 
 //! @brief Just a facade on the CPU, DeviceParticlesData on the GPU
-template<class Accelerator>
-using DeviceData_t = typename cstone::AccelSwitchTypeSimple<Accelerator, DeviceDataFacade, DeviceParticlesData>::type;
+template<class Accelerator, class Types>
+using DeviceData_t =
+    typename cstone::AccelSwitchTypeSimple<Accelerator, DeviceDataFacade, DeviceParticlesData<Types>>::type;
 
 } // namespace sphexa
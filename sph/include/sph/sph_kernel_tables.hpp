@@ -83,6 +83,16 @@ double kernel_3D_k(F&& sphKernel, double support)
     return 1.0 / util::simpson(0, support, numIntervals, kernelVol3D);
 }
 
+//! @brief compute the 2D normalization constant for an arbitrary kernel
+template<class F>
+double kernel_2D_k(F&& sphKernel, double support)
+{
+    auto kernelArea2D = [sphKernel](double x) { return 2.0 * M_PI * x * sphKernel(x); };
+
+    uint64_t numIntervals = 2000;
+    return 1.0 / util::simpson(0, support, numIntervals, kernelArea2D);
+}
+
 //! @brief tabulate and arbitrary function at N points between lower support and upperSupport
 template<typename T, std::size_t N, class F>
 std::array<T, N> tabulateFunction(F&& func, double lowerSupport, double upperSupport)
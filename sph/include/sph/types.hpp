@@ -36,13 +36,42 @@
 namespace sph
 {
 
-struct SphTypes
+/*! @brief precision configuration of the particle data
+ *
+ * @tparam KeyT  32- or 64-bit unsigned integer for the space-filling-curve keys
+ * @tparam Tc    coordinates and global quantities such as time and energies
+ * @tparam Th    hydrodynamic fields and previous-step differences
+ * @tparam Tm    particle masses
+ */
+template<class KeyT, class Tc, class Th, class Tm>
+struct SphTypeConfig
 {
-    using KeyType        = uint64_t;
-    using CoordinateType = double;
-    using HydroType      = float;
-    using XM1Type        = float;
-    using Tmass          = float;
+    using KeyType        = KeyT;
+    using CoordinateType = Tc;
+    using HydroType      = Th;
+    using XM1Type        = Th;
+    using Tmass          = Tm;
 };
 
-} // namespace sph
\ No newline at end of file
+//! @brief double precision coordinates, single precision hydro fields and masses
+template<class KeyType>
+using MixedPrecision = SphTypeConfig<KeyType, double, float, float>;
+
+//! @brief double precision for all fields, e.g. for verification runs
+template<class KeyType>
+using DoublePrecision = SphTypeConfig<KeyType, double, double, double>;
+
+//! @brief the default configuration
+using SphTypes = MixedPrecision<uint64_t>;
+
+} // namespace sph
+
+/*! @brief apply @p INSTANTIATE to each type configuration that the application can be launched with
+ *
+ * For use in explicit template instantiations of separately compiled translation units.
+ */
+#define SPH_EXA_FOR_EACH_TYPE_CONFIG(INSTANTIATE)                                                                      \
+    INSTANTIATE(sph::MixedPrecision<uint32_t>);                                                                        \
+    INSTANTIATE(sph::MixedPrecision<uint64_t>);                                                                        \
+    INSTANTIATE(sph::DoublePrecision<uint32_t>);                                                                       \
+    INSTANTIATE(sph::DoublePrecision<uint64_t>)
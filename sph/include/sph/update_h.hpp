@@ -9,13 +9,13 @@
 namespace sph
 {
 
-template<class T>
+template<int numDim = 3, class T>
 void updateSmoothingLengthCpu(size_t startIndex, size_t endIndex, unsigned ng0, const unsigned* nc, T* h)
 {
 #pragma omp parallel for schedule(static)
     for (size_t i = startIndex; i < endIndex; i++)
     {
-        h[i] = updateH(ng0, nc[i], h[i]);
+        h[i] = updateH<numDim>(ng0, nc[i], h[i]);
 
 #ifndef NDEBUG
         if (std::isinf(h[i]) || std::isnan(h[i])) printf("ERROR::h(%lu) ngi %d h %f\n", i, nc[i], h[i]);
@@ -23,15 +23,16 @@ void updateSmoothingLengthCpu(size_t startIndex, size_t endIndex, unsigned ng0,
     }
 }
 
-template<class Dataset>
+template<int numDim = 3, class Dataset>
 void updateSmoothingLength(const GroupView& grp, Dataset& d)
 {
     if constexpr (cstone::HaveGpu<typename Dataset::AcceleratorType>{})
     {
+        static_assert(numDim == 3, "the GPU implementation is 3D only");
         updateSmoothingLengthGpu(grp, d.ng0, rawPtr(d.devData.nc), rawPtr(d.devData.h));
         syncGpu();
     }
-    else { updateSmoothingLengthCpu(grp.firstBody, grp.lastBody, d.ng0, rawPtr(d.nc), rawPtr(d.h)); }
+    else { updateSmoothingLengthCpu<numDim>(grp.firstBody, grp.lastBody, d.ng0, rawPtr(d.nc), rawPtr(d.h)); }
 }
 
 } // namespace sph
@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sph/hydro_turb/initial_velocity.hpp"
+
+static std::map<std::string, double> velocityConstants(double solWeight)
+{
+    return {{"solWeight", solWeight},  {"stMaxModes", 100000}, {"Lbox", 1.0},       {"stEnergyPrefac", 5.0e-3},
+            {"stMachVelocity", 0.3e0}, {"epsilon", 1e-15},     {"rngSeed", 251299}, {"stSpectForm", 2},
+            {"powerLawExp", 5. / 3},   {"anglesExp", 2.0}};
+}
+
+//! @brief divergence and magnitude of the curl of the random velocity field at (x,y,z) from central differences
+template<class T>
+std::tuple<T, T> divCurl(T x, T y, T z, sph::TurbulenceData<T, cstone::CpuTag> turb)
+{
+    T dx = 1e-5;
+
+    std::vector<T> xs{x + dx, x - dx, x, x, x, x};
+    std::vector<T> ys{y, y, y + dx, y - dx, y, y};
+    std::vector<T> zs{z, z, z, z, z + dx, z - dx};
+    std::vector<T> vx(6), vy(6), vz(6);
+
+    // engine of the turbulence test case initial conditions with rngSeed = 251299
+    std::mt19937 gen = sph::initialVelocityEngine(251299);
+    sph::turbulentVelocityField(0, 6, xs.data(), ys.data(), zs.data(), vx.data(), vy.data(), vz.data(), turb, gen);
+
+    T div   = (vx[0] - vx[1] + vy[2] - vy[3] + vz[4] - vz[5]) / (2 * dx);
+    T curlX = (vz[2] - vz[3] - vy[4] + vy[5]) / (2 * dx);
+    T curlY = (vx[4] - vx[5] - vz[0] + vz[1]) / (2 * dx);
+    T curlZ = (vy[0] - vy[1] - vx[2] + vx[3]) / (2 * dx);
+
+    return {std::abs(div), std::sqrt(curlX * curlX + curlY * curlY + curlZ * curlZ)};
+}
+
+TEST(Turbulence, initialVelocitySolenoidal)
+{
+    using T = double;
+    sph::TurbulenceData<T, cstone::CpuTag> turb(velocityConstants(1.0), false);
+
+    for (T x : {-0.31, 0.07, 0.42})
+    {
+        auto [div, curl] = divCurl(x, 0.5 * x + 0.1, -0.2, turb);
+        EXPECT_GT(curl, 1.0);
+        EXPECT_LT(div, 1e-5 * curl);
+    }
+}
+
+TEST(Turbulence, initialVelocityCompressive)
+{
+    using T = double;
+    sph::TurbulenceData<T, cstone::CpuTag> turb(velocityConstants(0.0), false);
+
+    for (T x : {-0.31, 0.07, 0.42})
+    {
+        auto [div, curl] = divCurl(x, 0.5 * x + 0.1, -0.2, turb);
+        EXPECT_GT(div, 1.0);
+        EXPECT_LT(curl, 1e-5 * div);
+    }
+}
+
+//! @brief identically seeded engines must yield the same field, independent of the particle range
+TEST(Turbulence, initialVelocityReproducible)
+{
+    using T = double;
+
+    std::vector<T> x{0.1, -0.2, 0.3, 0.45}, y{0.0, 0.25, -0.4, 0.1}, z{-0.1, 0.2, 0.35, -0.45};
+    std::vector<T> vxA(4), vyA(4), vzA(4), vxB(4), vyB(4), vzB(4);
+
+    sph::TurbulenceData<T, cstone::CpuTag> turb(velocityConstants(0.5), false);
+    std::mt19937                           genA(7), genB(7);
+
+    sph::turbulentVelocityField(0, 4, x.data(), y.data(), z.data(), vxA.data(), vyA.data(), vzA.data(), turb, genA);
+    sph::turbulentVelocityField(2, 4, x.data(), y.data(), z.data(), vxB.data(), vyB.data(), vzB.data(), turb, genB);
+
+    for (int i = 2; i < 4; ++i)
+    {
+        EXPECT_EQ(vxA[i], vxB[i]);
+        EXPECT_EQ(vyA[i], vyB[i]);
+        EXPECT_EQ(vzA[i], vzB[i]);
+    }
+    EXPECT_NE(vxA[0], 0.0);
+}
+
+//! @brief the initial velocity engine does not reproduce the driver stream seeded with rngSeed
+TEST(Turbulence, initialVelocityEngine)
+{
+    std::mt19937 driver(251299);
+    std::mt19937 initial = sph::initialVelocityEngine(251299);
+
+    std::vector<uint32_t> driverDraws(8), initialDraws(8);
+    std::generate(driverDraws.begin(), driverDraws.end(), driver);
+    std::generate(initialDraws.begin(), initialDraws.end(), initial);
+    EXPECT_NE(driverDraws, initialDraws);
+
+    std::mt19937 again = sph::initialVelocityEngine(251299);
+    EXPECT_EQ(again(), initialDraws[0]);
+}
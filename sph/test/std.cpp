@@ -35,6 +35,7 @@
 
 #include "sph/hydro_std/iad_kern.hpp"
 #include "sph/hydro_std/momentum_energy_kern.hpp"
+#include "sph/kernels.hpp"
 #include "sph/sph_kernel_tables.hpp"
 #include "sph/table_lookup.hpp"
 
@@ -124,4 +125,56 @@ TEST_F(SphKernelTestsStd, MomentumEnergy)
     EXPECT_NEAR(grad_Pz, 15.596554152643426, 2.15e-7);
     EXPECT_NEAR(du, -0.40541191600274296, 1e-8);
     EXPECT_NEAR(maxvsignal, 1.4112466828564341, 1e-10);
-}
\ No newline at end of file
+}
+
+//! @brief in 2D, the IAD gradient of a linear function in the plane is exact
+TEST_F(SphKernelTestsStd, IAD2D)
+{
+    std::vector<T> zPlane(x.size(), 1.0);
+    std::vector<T> iad(6, -1);
+    T              K2D = kernel_2D_k(getSphKernel(kernelType, sincIndex), 2.0);
+
+    IADJLoopSTD<1, true, 2>(0, K2D, box(), neighbors.data(), neighborsCount, x.data(), y.data(), zPlane.data(),
+                            h.data(), m.data(), rho.data(), wh.data(), whd.data(), &iad[0], &iad[1], &iad[2], &iad[3],
+                            &iad[4], &iad[5]);
+
+    EXPECT_EQ(iad[2], 0.0);
+    EXPECT_EQ(iad[4], 0.0);
+    EXPECT_EQ(iad[5], 0.0);
+
+    // f(x, y) = a * x + b * y
+    T a = 0.7, b = -1.3;
+    T gradX = 0, gradY = 0;
+    T hInv  = T(1) / h[0];
+    for (unsigned pj = 0; pj < neighborsCount; ++pj)
+    {
+        auto j  = neighbors[pj];
+        T    rx = x[j] - x[0];
+        T    ry = y[j] - y[0];
+        T    w  = K2D * hInv * hInv * lt::lookup(wh.data(), std::sqrt(rx * rx + ry * ry) * hInv);
+        T    df = a * rx + b * ry;
+
+        gradX += m[j] / rho[j] * df * w * (iad[0] * rx + iad[1] * ry);
+        gradY += m[j] / rho[j] * df * w * (iad[1] * rx + iad[3] * ry);
+    }
+
+    EXPECT_NEAR(gradX, a, 1e-10);
+    EXPECT_NEAR(gradY, b, 1e-10);
+}
+
+//! @brief the smoothing length update scales h with the 1/numDim power of the estimated neighbor ratio
+TEST(SmoothingLength, updateH2D)
+{
+    using T      = double;
+    unsigned ng0 = 30;
+    T        h   = 0.1;
+
+    EXPECT_NEAR(updateH<2>(ng0, ng0, h), h, 1e-12);
+
+    for (unsigned nc : {10u, 45u, 120u})
+    {
+        T ratio3D = updateH<3>(ng0, nc, h) / h;
+        T ratio2D = updateH<2>(ng0, nc, h) / h;
+        EXPECT_NEAR(ratio2D * ratio2D, ratio3D * ratio3D * ratio3D, 1e-12);
+    }
+}
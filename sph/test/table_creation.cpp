@@ -38,3 +38,28 @@ TEST(KernelTable, simpson3DK)
     printf("3D-K: interpolated %.16f, integrated %.16f, diff %.16f\n", sphynx_3D_k(n), Bn, sphynx_3D_k(n) - Bn);
     EXPECT_NEAR(sphynx_3D_k(n), Bn, 1e-4);
 }
+
+TEST(KernelTable, simpson2DK)
+{
+    // a constant kernel with support 2 covers a disk of area 4 * PI
+    double K = kernel_2D_k([](double) { return 1.0; }, 2.0);
+    EXPECT_NEAR(K, 1.0 / (4.0 * M_PI), 1e-12);
+
+    // the normalized sinc-6 kernel integrates to one on a cartesian grid in the plane
+    auto   Sn  = [](double x) { return std::pow(wharmonic_std(x), 6.0); };
+    double Kn  = kernel_2D_k(Sn, 2.0);
+    int    n   = 400;
+    double dx  = 4.0 / n;
+    double sum = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        for (int j = 0; j < n; ++j)
+        {
+            double u = -2.0 + (i + 0.5) * dx;
+            double v = -2.0 + (j + 0.5) * dx;
+            double r = std::sqrt(u * u + v * v);
+            if (r < 2.0) { sum += Kn * Sn(r) * dx * dx; }
+        }
+    }
+    EXPECT_NEAR(sum, 1.0, 1e-6);
+}